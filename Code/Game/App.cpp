@@ -4,13 +4,26 @@
 
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Engine/Renderer/PerfHUD.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Math/MathBenchmark.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/FrameStats.hpp"
+#include "Engine/Core/AllocTracker.hpp"
+#include "Engine/Core/SampleCounters.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Window/Window.hpp"
 
+#include <algorithm>
+
 //----------------------------------------------------------------------------------------------------------------------
 InputSystem*			g_theInput			= nullptr;
 Window*					g_theWindow			= nullptr;
@@ -22,6 +35,31 @@ App*					g_theApp			= nullptr; //Created and owned by Main_Windows.cpp
 //----------------------------------------------------------------------------------------------------------------------
 GameMode				g_gameModeNum = GAMEMODE_3D;
 
+//----------------------------------------------------------------------------------------------------------------------
+// Scripted keys for headless runs, looping every s_headlessScriptNumFrames. Walks the creature, turns it both ways,
+// sprints and stops, so step placement, the IK solves and the raycasts all get exercised
+struct HeadlessKeyEvent
+{
+	int				m_frame		= 0;
+	unsigned char	m_keyCode	= 0;
+	bool			m_isPressed	= false;
+};
+
+static int const				s_headlessScriptNumFrames = 600;
+static HeadlessKeyEvent const	s_headlessScript[] =
+{
+	{   0, 'W',				true  },
+	{ 180, 'D',				true  },
+	{ 240, 'D',				false },
+	{ 240, KEYCODE_SHIFT,	true  },
+	{ 360, KEYCODE_SHIFT,	false },
+	{ 360, 'A',				true  },
+	{ 420, 'A',				false },
+	{ 480, 'W',				false },
+	{ 540, 'S',				true  },
+	{ 570, 'S',				false },
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 App::App()
 {  
@@ -40,77 +78,182 @@ App::~App()
 	m_texture_Galaxy		= nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void App::ParseCommandLine( std::string const& commandLine )
+{
+	Strings tokenList = SplitStringOnDelimiter( commandLine, ' ' );
+	if ( tokenList.empty() )
+	{
+		return;
+	}
+
+	NamedStrings& args = m_headlessConfig.m_args;
+	for ( int i = 0; i < tokenList.size(); i++ )
+	{
+		Strings keyValuePair = SplitStringOnDelimiter( tokenList[i], '=' );
+		if ( keyValuePair.size() == 2 )
+		{
+			args.SetValue( keyValuePair[0], keyValuePair[1] );
+		}
+	}
+
+	m_headlessConfig.m_seed						= static_cast<unsigned int>( args.GetValue( "seed", int( m_headlessConfig.m_seed ) ) );
+	m_inputRecordingConfig.m_recordFilePath		= args.GetValue( "record", m_inputRecordingConfig.m_recordFilePath );
+	m_inputRecordingConfig.m_replayFilePath		= args.GetValue( "replay", m_inputRecordingConfig.m_replayFilePath );
+	m_inputRecordingConfig.m_profileFilePath	= args.GetValue( "profile", m_inputRecordingConfig.m_profileFilePath );
+	if ( tokenList[0] != "headless" )
+	{
+		return;
+	}
+
+	m_headlessConfig.m_isHeadless			= true;
+	m_headlessConfig.m_gameMode				= static_cast<GameMode>( args.GetValue( "mode", int( m_headlessConfig.m_gameMode ) ) );
+	m_headlessConfig.m_numFrames			= std::max( 1, args.GetValue( "frames", m_headlessConfig.m_numFrames ) );
+	m_headlessConfig.m_numWarmupFrames		= std::max( 0, args.GetValue( "warmup", m_headlessConfig.m_numWarmupFrames ) );
+	m_headlessConfig.m_fixedDeltaSeconds	= args.GetValue( "dt", m_headlessConfig.m_fixedDeltaSeconds );
+	m_headlessConfig.m_budgetMs				= args.GetValue( "budgetms", m_headlessConfig.m_budgetMs );
+	m_headlessConfig.m_statsFilePath		= args.GetValue( "out", m_headlessConfig.m_statsFilePath );
+	m_headlessConfig.m_countersFilePath		= args.GetValue( "counters", m_headlessConfig.m_countersFilePath );
+	m_headlessConfig.m_execCommand			= args.GetValue( "exec", m_headlessConfig.m_execCommand );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void App::Startup()
 {
+	// Profiler first, so every thread created from here on can record
+	ProfilerConfig profilerConfig;
+	ProfilerStartup( profilerConfig );
+
+	// Logger next, for the same reason
+	LoggerConfig loggerConfig;
+	LoggerStartup( loggerConfig );
+
 	// Creating EventSystem
 	g_theEventSystem = new EventSystem();
 
 	// Create engine subsystems and game
+	// Headless runs get keys from the script only
 	InputSystemConfig inputSystemConfig;
+	inputSystemConfig.m_pollDevices = !IsHeadless();
 	g_theInput = new InputSystem( inputSystemConfig );
 
-	// Creating Window
-	WindowConfig windowConfig;
-	windowConfig.m_windowTitle	= "SkeletalPlayground";
-	windowConfig.m_clientAspect = 2.0f;
-	windowConfig.m_inputSystem	= g_theInput;
-	windowConfig.m_isFullScreen = true;
-	g_theWindow					= new Window( windowConfig );
-
-	// Creating Renderer
-	RendererConfig rendererConfig;
-	rendererConfig.m_window		= g_theWindow;
-	g_theRenderer				= new Renderer( rendererConfig );
+	// Creating Window, Renderer and AudioSystem, none of which exist in headless runs
+	if ( !IsHeadless() )
+	{
+		WindowConfig windowConfig;
+		windowConfig.m_windowTitle	= "SkeletalPlayground";
+		windowConfig.m_clientAspect = 2.0f;
+		windowConfig.m_inputSystem	= g_theInput;
+		windowConfig.m_isFullScreen = true;
+		g_theWindow					= new Window( windowConfig );
+
+		RendererConfig rendererConfig;
+		rendererConfig.m_window		= g_theWindow;
+		g_theRenderer				= new Renderer( rendererConfig );
+
+		AudioSystemConfig audioConfig;
+		g_theAudio = new AudioSystem( audioConfig );
+	}
 
-	// Creating DevConsole
+	// Creating DevConsole, commands still print to it when headless
 	DevConsoleConfig devConsoleConfig;
 	m_devConsoleCamera.SetOrthoView( Vec2( 0.0f, 0.0f), Vec2(WORLD_SIZE_X, WORLD_SIZE_Y) );
 	devConsoleConfig.m_camera	= &m_devConsoleCamera; 
 	devConsoleConfig.m_renderer	= g_theRenderer;
 	g_theDevConsole				= new DevConsole( devConsoleConfig );
 
-	// Creating AudioSystem
-	AudioSystemConfig audioConfig;
-	g_theAudio = new AudioSystem( audioConfig );
-	
-	// Creating DebugRenderSystem
-	DebugRenderConfig debugRenderConfig;
-	debugRenderConfig.m_renderer = g_theRenderer;
-	DebugRenderSystemStartup( debugRenderConfig );
+	if ( !IsHeadless() )
+	{
+		// Creating DebugRenderSystem
+		DebugRenderConfig debugRenderConfig;
+		debugRenderConfig.m_renderer = g_theRenderer;
+		DebugRenderSystemStartup( debugRenderConfig );
+
+		// Creating PerfHUD, "perfhud" toggles it
+		PerfHUDConfig perfHUDConfig;
+		perfHUDConfig.m_renderer	= g_theRenderer;
+		perfHUDConfig.m_camera		= &m_devConsoleCamera;
+		// Main-thread IK solve time; the counters below it count solves, raycasts and sweeps on every thread
+		perfHUDConfig.m_watchList.push_back( PerfHUDWatch{ "IK solves", "IK_Chain3D::Solve" } );
+		PerfHUDStartup( perfHUDConfig );
+	}
+
+	// Input recording and replay, before the RNG so a replay runs with the seed it was recorded with
+	unsigned int seed = m_headlessConfig.m_seed;
+	if ( !m_inputRecordingConfig.m_replayFilePath.empty() )
+	{
+		if ( g_theInput->StartReplay( m_inputRecordingConfig.m_replayFilePath ) )
+		{
+			seed = g_theInput->GetReplaySeed();
+		}
+		else
+		{
+			// Nonzero exit code, so a scripted comparison doesn't quietly measure a different run
+			DebuggerPrintf( "Could not load input recording \"%s\"\n", m_inputRecordingConfig.m_replayFilePath.c_str() );
+			m_exitCode = 1;
+		}
+	}
+	if ( !m_inputRecordingConfig.m_recordFilePath.empty() )
+	{
+		g_theInput->StartRecording( m_inputRecordingConfig.m_recordFilePath, seed );
+	}
 
 	// Creating RNG
-	g_theRNG = new RandomNumberGenerator();
+	g_theRNG = new RandomNumberGenerator( seed );
+
+	// Creating JobSystem
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.m_taskClock = &m_gameClock;
+	g_theJobSystem = new JobSystem( jobSystemConfig );
 
 	// Start up engine subsystems and game
 	g_theEventSystem->Startup();
 	 g_theDevConsole->Startup();
   	      g_theInput->StartUp();
-	     g_theWindow->Startup();
-	   g_theRenderer->Startup();
-	      g_theAudio->Startup();
+	if ( !IsHeadless() )
+	{
+		  g_theWindow->Startup();
+		g_theRenderer->Startup();
+		   g_theAudio->Startup();
+	}
+	  g_theJobSystem->Startup();
 
 //	m_theGame = new GameModeProtogame3D();
 //	m_theGame->StartUp();
 
-	//----------------------------------------------------------------------------------------------------------------------
-	// Initializing bitmap font text
-	m_textFont = g_theRenderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/SquirrelFixedFont" );
-
-	//----------------------------------------------------------------------------------------------------------------------
-	// Initializing texture
-	m_texture_TestUV		= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/TestUV.png" );
-	m_texture_MoonSurface	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/MoonSurface.png" );
-	m_texture_RockWithGrass = g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/rockWithGrass.png" );
-	m_texture_Grass			= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Grass.png" );
-	m_texture_GlowingRock	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/GlowingRock.png" );
-	m_texture_Galaxy		= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/galaxy.png" );
-	m_texture_TestOpenGL	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Test_StbiFlippedAndOpenGL.png" );
+	if ( !IsHeadless() )
+	{
+		//----------------------------------------------------------------------------------------------------------------------
+		// Initializing bitmap font text
+		m_textFont = g_theRenderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/SquirrelFixedFont" );
+
+		//----------------------------------------------------------------------------------------------------------------------
+		// Initializing texture
+		m_texture_TestUV		= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/TestUV.png" );
+		m_texture_MoonSurface	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/MoonSurface.png" );
+		m_texture_RockWithGrass = g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/rockWithGrass.png" );
+		m_texture_Grass			= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Grass.png" );
+		m_texture_GlowingRock	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/GlowingRock.png" );
+		m_texture_Galaxy		= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/galaxy.png" );
+		m_texture_TestOpenGL	= g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Test_StbiFlippedAndOpenGL.png" );
+	}
 
 	//----------------------------------------------------------------------------------------------------------------------
 	g_theEventSystem->SubscribeToEvent( "quit", App::Quit );
 	g_theEventSystem->SubscribeToEvent( "debugrenderclear", Command_DebugRenderClear );
 	g_theEventSystem->SubscribeToEvent( "debugrendertoggle", Command_DebugRenderToggle );
+	g_theEventSystem->SubscribeToEvent( "jobsystembenchmark", Command_JobSystemBenchmark );
+	g_theEventSystem->SubscribeToEvent( "jobstats", Command_JobStats );
+	g_theEventSystem->SubscribeToEvent( "jobtrace", Command_JobTrace );
+	g_theEventSystem->SubscribeToEvent( "mpmcbenchmark", Command_MPMCQueueBenchmark );
+	g_theEventSystem->SubscribeToEvent( "profiletree", Command_ProfileTree );
+	g_theEventSystem->SubscribeToEvent( "profilecapture", Command_ProfileCapture );
+	g_theEventSystem->SubscribeToEvent( "framestats", Command_FrameStats );
+	g_theEventSystem->SubscribeToEvent( "allocstats", Command_AllocStats );
+	g_theEventSystem->SubscribeToEvent( "perfhud", Command_PerfHUD );
+	g_theEventSystem->SubscribeToEvent( "mathbenchmark", Command_MathBenchmark );
+	g_theEventSystem->SubscribeToEvent( "log", Command_Log );
+	g_theEventSystem->SubscribeToEvent( "counters", Command_Counters );
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Debug keys for "FIFA_TEST_3D"
@@ -129,17 +272,44 @@ void App::Startup()
 	g_theDevConsole->AddLine( Rgba8::GREEN, "U / O          - Raise / lower Elevator"					 );	
 	g_theDevConsole->AddLine( Rgba8::GREEN, "P              - Pause Game"								 );	
 	g_theDevConsole->AddLine( Rgba8::GREEN, "Escape         - Exit Game"								 );	
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Headless runs skip attract mode and step every clock by exactly dt
+	if ( IsHeadless() && m_headlessConfig.m_execCommand.empty() )
+	{
+		if ( !g_theInput->IsReplaying() )
+		{
+			// A replay steps the clock by its recorded deltas instead
+			Clock::SetSystemClockFixedStep( SecondsToNanoseconds( double( m_headlessConfig.m_fixedDeltaSeconds ) ) );
+		}
+		g_gameModeNum		= m_headlessConfig.m_gameMode;
+		m_theGameMode		= GameModeBase::CreateNewGameOfType( g_gameModeNum );
+		m_attractModeIsOn	= false;
+		m_theGameMode->Startup();
+	}
+
+	if ( g_theInput->IsReplaying() && !m_inputRecordingConfig.m_profileFilePath.empty() )
+	{
+		ProfilerStartCapture( g_theInput->GetNumReplayFrames(), m_inputRecordingConfig.m_profileFilePath );
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void App::Shutdown()
 {
-	     g_theAudio->Shutdown();
-	  g_theRenderer->Shutdown();
-	    g_theWindow->Shutdown();
+	if ( !IsHeadless() )
+	{
+		   g_theAudio->Shutdown();
+		g_theRenderer->Shutdown();
+		  g_theWindow->Shutdown();
+	}
 	     g_theInput->ShutDown();
 	g_theDevConsole->Shutdown();
-	DebugRenderSystemShutdown();
+	if ( !IsHeadless() )
+	{
+		DebugRenderSystemShutdown();
+		PerfHUDShutdown();
+	}
 //	  m_theGameMode->Shutdown();
 
 	delete g_theAudio;
@@ -160,16 +330,29 @@ void App::Shutdown()
 	delete m_theGameMode;
 	m_theGameMode = nullptr;
 
+	// Game modes may still be waiting on jobs, so workers go last
+	g_theJobSystem->Shutdown();
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
+
+	LoggerShutdown();
+	ProfilerShutdown();
 }
  
 //-----------------------------------------------------------------------------------------------
 // One "frame" of the game.  Generally: Input, Update, Render.  We call this 60+ times per second.
 void App::RunFrame()
 {
+	ProfilerBeginFrame();
+	AllocTrackerBeginFrame();
+	PROFILE_SCOPE( "App::RunFrame" );
 	float deltaSeconds = m_gameClock.GetDeltaSeconds();
 	BeginFrame();
 	Update( deltaSeconds );
-	Render();	
+	if ( !IsHeadless() )
+	{
+		Render();	
+	}
 	EndFrame();	
 }
  
@@ -204,6 +387,12 @@ bool App::Quit( EventArgs& args )
 //----------------------------------------------------------------------------------------------------------------------
 void App::Run()
 {
+	if ( IsHeadless() )
+	{
+		RunHeadless();
+		return;
+	}
+
 	// Program main loop; keep running frames until it's time to quit
 	while (!IsQuitting())
 	{
@@ -211,23 +400,138 @@ void App::Run()
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void App::RunHeadless()
+{
+	if ( !m_headlessConfig.m_execCommand.empty() )
+	{
+		g_theEventSystem->FireEvent( m_headlessConfig.m_execCommand, m_headlessConfig.m_args );
+		return;
+	}
+
+	int numFrames		= m_headlessConfig.m_numFrames;
+	int numWarmupFrames	= m_headlessConfig.m_numWarmupFrames;
+	if ( g_theInput->IsReplaying() )
+	{
+		// Measure exactly the replay, the scripted keys are ignored while it runs
+		numWarmupFrames	= std::min( numWarmupFrames, g_theInput->GetNumReplayFrames() - 1 );
+		numFrames		= g_theInput->GetNumReplayFrames() - numWarmupFrames;
+	}
+	for ( int frameIndex = 0; frameIndex < numWarmupFrames && !IsQuitting(); frameIndex++ )
+	{
+		ApplyHeadlessInput( frameIndex );
+		RunFrame();
+	}
+
+	// Own stats rather than the system clock's, so the window holds every measured frame and nothing logs mid-run.
+	// Frames slower than dt count as hitches, i.e. the simulation alone could not keep up
+	FrameStats frameStats;
+	frameStats.m_windowSize			= numFrames;
+	frameStats.m_hitchThresholdMs	= double( m_headlessConfig.m_fixedDeltaSeconds ) * 1000.0;
+	frameStats.m_maxHitchesKept		= 0;
+	frameStats.m_logIntervalSeconds	= 0.0;
+
+	SampleCountersStartCapture( numFrames, m_headlessConfig.m_countersFilePath );
+	int64_t runStartTime = GetCurrentTimeNanoseconds();
+	for ( int frameIndex = numWarmupFrames; frameIndex < numWarmupFrames + numFrames && !IsQuitting(); frameIndex++ )
+	{
+		ApplyHeadlessInput( frameIndex );
+		int64_t frameStartTime = GetCurrentTimeNanoseconds();
+		RunFrame();
+		frameStats.AddFrame( NanosecondsToSeconds( GetCurrentTimeNanoseconds() - frameStartTime ), m_gameClock.GetFrameCount() );
+	}
+	double wallSeconds = NanosecondsToSeconds( GetCurrentTimeNanoseconds() - runStartTime );
+	SampleCountersStopCapture();		// Only left running if the game quit early
+
+	WriteHeadlessStats( frameStats, wallSeconds );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void App::ApplyHeadlessInput( int frameIndex )
+{
+	int scriptFrame = frameIndex % s_headlessScriptNumFrames;
+	for ( int i = 0; i < int( sizeof( s_headlessScript ) / sizeof( s_headlessScript[0] ) ); i++ )
+	{
+		HeadlessKeyEvent const& keyEvent = s_headlessScript[i];
+		if ( keyEvent.m_frame != scriptFrame )
+		{
+			continue;
+		}
+		if ( keyEvent.m_isPressed )
+		{
+			g_theInput->HandleKeyPressed( keyEvent.m_keyCode );
+		}
+		else
+		{
+			g_theInput->HandleKeyReleased( keyEvent.m_keyCode );
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void App::WriteHeadlessStats( FrameStats const& frameStats, double wallSeconds )
+{
+	FrameStatsSummary summary	= frameStats.GetSummary();
+	bool isOverBudget			= m_headlessConfig.m_budgetMs > 0.0f && summary.m_p95Ms > double( m_headlessConfig.m_budgetMs );
+	if ( isOverBudget )
+	{
+		m_exitCode = 1;
+	}
+
+	std::string header;
+	header += Stringf( "Headless run: mode %d  seed %u  dt %.3f ms  warmup %d frames\n", int( m_headlessConfig.m_gameMode ), g_theRNG->m_seed, 
+					   m_headlessConfig.m_fixedDeltaSeconds * 1000.0f, m_headlessConfig.m_numWarmupFrames );
+	if ( !m_inputRecordingConfig.m_replayFilePath.empty() )
+	{
+		header += Stringf( "Replay %s, dt from the recording\n", m_inputRecordingConfig.m_replayFilePath.c_str() );
+	}
+	header += Stringf( "Wall %.3f s  simulated %.3f s\n", wallSeconds, m_gameClock.GetTotalSeconds() );
+	header += Stringf( "Counters per frame in %s\n", m_headlessConfig.m_countersFilePath.c_str() );
+	header += frameStats.GetSummaryText() + "\n";
+	if ( m_headlessConfig.m_budgetMs > 0.0f )
+	{
+		header += Stringf( "Budget p95 <= %.2f ms: %s\n", m_headlessConfig.m_budgetMs, isOverBudget ? "FAIL" : "PASS" );
+	}
+	DebuggerPrintf( "%s", header.c_str() );
+
+	// Header, then one line per measured frame, oldest first
+	std::string text = header + "\nframe,ms\n";
+	int numFrames = frameStats.GetNumFrames();
+	for ( int i = 0; i < numFrames; i++ )
+	{
+		text += Stringf( "%d,%.4f\n", i, frameStats.GetFrameMs( numFrames - 1 - i ) );
+	}
+	std::vector<char> buffer( text.begin(), text.end() );
+	WriteBinaryBufferToFile( buffer, m_headlessConfig.m_statsFilePath );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void App::BeginFrame()
 {
+	PROFILE_SCOPE( "App::BeginFrame" );
 	Clock::TickSystemClock();
 
-	g_theDevConsole->BeginFrame();
-	     g_theInput->BeginFrame();
-	    g_theWindow->BeginFrame();
-	  g_theRenderer->BeginFrame();
-	     g_theAudio->BeginFrame();
+	g_theEventSystem->BeginFrame();
+	 g_theDevConsole->BeginFrame();
+	      g_theInput->BeginFrame();
+	if ( !IsHeadless() )
+	{
+		  g_theWindow->BeginFrame();
+		g_theRenderer->BeginFrame();
+		   g_theAudio->BeginFrame();
+	}
+	  g_theJobSystem->BeginFrame();
 
-	DebugRenderBeginFrame();
+	if ( !IsHeadless() )
+	{
+		DebugRenderBeginFrame();
+	}
 }	 
  
 //----------------------------------------------------------------------------------------------------------------------
 void App::Update( float deltaSeconds ) 
 { 
+	PROFILE_SCOPE( "App::Update" );
 	if ( m_attractModeIsOn )
 	{
 		// updates only attractMode cam
@@ -239,7 +543,7 @@ void App::Update( float deltaSeconds )
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Mouse is visible if ( window does NOT have focus || devConsole is open || m_attractModeIsOn
-	if ( g_theWindow->HasFocus() == false || g_theDevConsole->m_isOpen == true || m_attractModeIsOn == true || g_gameModeNum == GAMEMODE_2D )
+	if ( g_theWindow == nullptr || g_theWindow->HasFocus() == false || g_theDevConsole->m_isOpen == true || m_attractModeIsOn == true || g_gameModeNum == GAMEMODE_2D )
 	{
 		g_theInput->SetCursorMode( false, false );
 	}
@@ -283,6 +587,7 @@ void App::Update( float deltaSeconds )
 //----------------------------------------------------------------------------------------------------------------------
 void App::Render() const
 {
+	PROFILE_SCOPE( "App::Render" );
 	// Draw attract mode
 	if ( m_attractModeIsOn )
 	{
@@ -298,6 +603,7 @@ void App::Render() const
 	}
 
 	//----------------------------------------------------------------------------------------------------------------------
+	PerfHUDRender();
 	if ( g_theDevConsole )
 	{
 		AABB2 bounds = AABB2( 0.0f, 0.0f, WORLD_SIZE_X, WORLD_SIZE_Y );
@@ -308,13 +614,23 @@ void App::Render() const
 //----------------------------------------------------------------------------------------------------------------------
 void App::EndFrame()
 {
-	g_theDevConsole->EndFrame();
-	     g_theInput->EndFrame();
-	    g_theWindow->EndFrame();
-	  g_theRenderer->EndFrame();
-	     g_theAudio->EndFrame();
+	PROFILE_SCOPE( "App::EndFrame" );
+	g_theEventSystem->EndFrame();
+	 g_theDevConsole->EndFrame();
+	      g_theInput->EndFrame();
+	if ( !IsHeadless() )
+	{
+		  g_theWindow->EndFrame();
+		g_theRenderer->EndFrame();
+		   g_theAudio->EndFrame();
+	}
+	  g_theJobSystem->EndFrame();
+	SampleCountersEndFrame();
 
-	DebugRenderEndFrame();
+	if ( !IsHeadless() )
+	{
+		DebugRenderEndFrame();
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1,14 +1,50 @@
 #pragma once
 
+#include "Game/GameModeBase.hpp"
+
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------
 class GameModeProtogame3D; 
 class GameModeBase;
+class FrameStats;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Command line "headless frames=3000 seed=7" runs a game mode with no Window, Renderer or AudioSystem, on a fixed
+// timestep and scripted input, then writes frame time stats. Same seed and frames, same simulation.
+// Per-frame counters (raycasts, blocks tested, ...) for the measured frames go to a CSV next to the stats.
+// "headless exec=mathbenchmark file=MathBenchmark.csv" runs that one console command with the same args instead.
+struct HeadlessConfig
+{
+	bool			m_isHeadless			= false;
+	GameMode		m_gameMode				= GAMEMODE_3D;			// "mode="
+	int				m_numFrames				= 3000;					// "frames=", measured
+	int				m_numWarmupFrames		= 60;					// "warmup=", run first and left out of the stats
+	unsigned int	m_seed					= 0;					// "seed=", for g_theRNG
+	float			m_fixedDeltaSeconds		= 1.0f / 60.0f;			// "dt="
+	float			m_budgetMs				= 0.0f;					// "budgetms=", p95 over this fails the run, 0 is off
+	std::string		m_statsFilePath			= "HeadlessStats.txt";	// "out="
+	std::string		m_countersFilePath		= "HeadlessCounters.csv";	// "counters=", per-frame counts over the measured frames
+	std::string		m_execCommand;									// "exec="
+	NamedStrings	m_args;											// Every key=value, passed on to m_execCommand
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Command line "record=Run.inputs" saves every frame's input and clock delta until exit, "replay=Run.inputs" plays one
+// back with its seed, and "profile=Replay.json" captures a profiler trace over the whole replay, so two builds can be
+// compared along the same trajectory. Works with or without "headless", but a recording replays in the kind of run
+// it was made in, since windowed runs start in attract mode.
+struct InputRecordingConfig
+{
+	std::string		m_recordFilePath;								// "record="
+	std::string		m_replayFilePath;								// "replay="
+	std::string		m_profileFilePath;								// "profile=", only with "replay="
+};
 
 //----------------------------------------------------------------------------------------------------------------------
 class App
@@ -16,12 +52,15 @@ class App
 public:
 	App();
 	~App();
+	void ParseCommandLine( std::string const& commandLine );
 	void Startup();
 	void Shutdown();
 	void Run();
 	void RunFrame();
 	 
 	bool IsQuitting() const { return m_isQuitting; }
+	bool IsHeadless() const { return m_headlessConfig.m_isHeadless; }
+	int  GetExitCode() const { return m_exitCode; }
 	bool HandleKeyPressed(unsigned char keyCode);	
 	bool HandleKeyReleased(unsigned char keyCode);
 	bool HandleQuitRequested();
@@ -42,8 +81,16 @@ private:
 	void Render() const;		// draws entities' every frame
 	void EndFrame();
 
+	// Headless runs
+	void RunHeadless();
+	void ApplyHeadlessInput( int frameIndex );
+	void WriteHeadlessStats( FrameStats const& frameStats, double wallSeconds );
+
 private:
 	bool					m_isQuitting		= false;
+	int						m_exitCode			= 0;
+	HeadlessConfig			m_headlessConfig;
+	InputRecordingConfig	m_inputRecordingConfig;
 //	GameModeProtogame3D*	m_theGame			= nullptr;
 	Camera					m_devConsoleCamera;
 	Camera					m_attractCamera;
@@ -9,6 +9,10 @@
 //
 
 //#define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
+//#define ENGINE_DISABLE_PROFILER	// (If uncommented) PROFILE_SCOPE compiles to nothing.
+//#define ENGINE_TRACK_ALLOCATIONS	// (If uncommented) Counts heap allocations per ALLOC_TAG, see "allocstats".
+//#define ENGINE_LOG_MIN_SEVERITY 1	// (If uncommented) LOG calls below this severity compile to nothing (0 Verbose, 1 Info, 2 Warning, 3 Error).
+//#define ENGINE_DISABLE_COUNTERS	// (If uncommented) COUNTER_ADD compiles to nothing, see "counters".
 
 #if defined( _DEBUG )
 #define ENGINE_DEBUG_RENDER 
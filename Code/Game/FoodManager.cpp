@@ -7,6 +7,7 @@
 #include "Engine/SkeletalSystem/IK_Chain3D.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/SampleCounters.hpp"
 
 //----------------------------------------------------------------------------------------------------------------------
 FoodManager::FoodManager( int numFoodOrbs, GameMode3D* game ) 
@@ -40,6 +41,17 @@ FoodManager::~FoodManager()
 void FoodManager::Update( float deltaSeconds )
 {
 	MoveFoodOrbs( deltaSeconds );
+
+	// Added once per frame, so the per-frame counter reads as the number of orbs still out
+	int numActiveOrbs = 0;
+	for ( int i = 0; i < m_foodList.size(); i++ )
+	{
+		if ( !m_foodList[ i ].m_isConsumed )
+		{
+			numActiveOrbs++;
+		}
+	}
+	COUNTER_ADD( "Food orbs active", numActiveOrbs );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -108,7 +120,7 @@ void FoodManager::MoveFoodOrbs( float deltaSeconds )
 				IK_Chain3D* rightArm					= currentFoodOrb.m_quadSpider->m_rightArm;
 				rightArm->m_position_WS					= currentFoodOrb.m_position;
 				rightArm->m_target.m_currentPos			= currentFoodOrb.m_position + Vec3::Y_LEFT	* 10.0f;
-				float time								= float( GetCurrentTimeSeconds() );
+				float time								= g_theApp->m_gameClock.GetTotalSeconds();
 				float sineSpeedScalar					= 10.0f;
 
 				float distPrevGoalPosToNewGoalPos		= GetDistance3D( currentFoodOrb.m_prevPos, currentFoodOrb.m_goalPos  );
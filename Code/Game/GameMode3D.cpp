@@ -10,11 +10,15 @@
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/SampleCounters.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/SkeletalSystem/CreatureBase.hpp"
 
+#include <thread>
+
 
 //----------------------------------------------------------------------------------------------------------------------
 GameMode3D::GameMode3D()
@@ -24,6 +28,8 @@ GameMode3D::GameMode3D()
 //----------------------------------------------------------------------------------------------------------------------
 GameMode3D::~GameMode3D()
 {
+	RetrieveCameraPick();
+
 	m_root = nullptr;
 	delete m_root;
 	m_rightArm = nullptr;
@@ -61,10 +67,10 @@ void GameMode3D::Startup()
 	// Setting logic to enable anchoring and walk logic on startup
 	m_rightArm->m_anchorState  = ANCHOR_STATE_FREE;
 	m_rightFoot->m_anchorState = ANCHOR_STATE_FREE;
-	SpecifyFootPlacementPos(  m_rightArm->m_target.m_goalPos,					    m_maxArmLength * 0.5f,  -m_maxArmLength * 0.25f );
-	SpecifyFootPlacementPos(   m_leftArm->m_target.m_goalPos,					    m_maxArmLength * 0.5f,   m_maxArmLength * 0.25f );
-	SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_hip->m_firstJoint, m_maxFeetLength * 0.5f, -m_maxFeetLength * 0.25f );
-	SpecifyFootPlacementPos(  m_leftFoot->m_target.m_goalPos, m_hip->m_firstJoint, m_maxFeetLength * 0.5f,  m_maxFeetLength * 0.25f );
+	SpecifyFootPlacementPos(  m_rightArm->m_target.m_goalPos,  m_rightArm,					    m_maxArmLength * 0.5f,  -m_maxArmLength * 0.25f );
+	SpecifyFootPlacementPos(   m_leftArm->m_target.m_goalPos,   m_leftArm,					    m_maxArmLength * 0.5f,   m_maxArmLength * 0.25f );
+	SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_rightFoot, m_hip->m_firstJoint, m_maxFeetLength * 0.5f, -m_maxFeetLength * 0.25f );
+	SpecifyFootPlacementPos(  m_leftFoot->m_target.m_goalPos,  m_leftFoot, m_hip->m_firstJoint, m_maxFeetLength * 0.5f,  m_maxFeetLength * 0.25f );
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Initialize Raycasts
@@ -76,8 +82,12 @@ void GameMode3D::Startup()
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::Update( float deltaSeconds )
 {	
+	PROFILE_SCOPE( "GameMode3D::Update" );
+	// Last frame's pick reads the scene, finish it before anything moves
+	RetrieveCameraPick();
+
 	// Move "elevator" using sine
-	float time			= float( GetCurrentTimeSeconds() );
+	float time			= g_theApp->m_gameClock.GetTotalSeconds();
 	m_sine				= SinDegrees( time * 100.0f );
 	Vec3 elevatorCenter = m_elevator_1->m_aabb3.GetCenter();
 	m_elevator_1->m_aabb3.SetCenterXYZ( Vec3( elevatorCenter.x, elevatorCenter.y, elevatorCenter.z + m_sine ) );
@@ -85,6 +95,10 @@ void GameMode3D::Update( float deltaSeconds )
 	// Update core systems
 	UpdatePauseQuitAndSlowMo();
 	UpdateDebugKeys();
+
+	// Both elevators have moved for this frame, let the footstep graph catch up with them
+	m_walkableNavGraph.UpdateMovingBlock( m_elevator_1, m_sceneSpatialIndex );
+	m_walkableNavGraph.UpdateMovingBlock( m_elevator_2, m_sceneSpatialIndex );
 	UpdateCameraInput( deltaSeconds );
 //	UpdateDebugTargetPosInput();
 	
@@ -135,14 +149,22 @@ void GameMode3D::Update( float deltaSeconds )
 
 	m_map->Update( deltaSeconds );
 
+	// Push limbs back out of blocks and terrain after all chains are solved
+	m_creatureLimbCollision.SolveChains(  m_creatureSkeletalSystemsList,		m_sceneSpatialIndex );
+	m_quadrupedLimbCollision.SolveChains( m_quadruped->m_skeletalSystemsList, m_sceneSpatialIndex );
+
 	// Update Camera
 	UpdateGameMode3DCamera();
 	TurnCreatureTowardsCameraDir();
+
+	// Pick runs alongside Render
+	RequestCameraPick();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::Render() const
 {
+	PROFILE_SCOPE( "GameMode3D::Render" );
 	RenderWorldObjects();
 	RenderUIObjects();
 }
@@ -355,6 +377,7 @@ void GameMode3D::UpdateGameMode3DCamera()
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::RenderWorldObjects() const
 {
+	ALLOC_TAG( "Render" );
 	//----------------------------------------------------------------------------------------------------------------------
 	// Begin World Camera
 	//----------------------------------------------------------------------------------------------------------------------
@@ -446,6 +469,7 @@ void GameMode3D::RenderWorldObjects() const
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::RenderUIObjects() const
 {
+	ALLOC_TAG( "DebugText" );
 	//----------------------------------------------------------------------------------------------------------------------
 	// Begin UI Camera
 	g_theRenderer->BeginCamera( m_gameMode3DUICamera );
@@ -1126,6 +1150,7 @@ void GameMode3D::RenderCreature( std::vector<Vertex_PCU>& verts_Creature, std::v
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::UpdateCreature( float deltaSeconds )
 {
+	PROFILE_SCOPE( "GameMode3D::UpdateCreature" );
 	//----------------------------------------------------------------------------------------------------------------------
 	// Keep things attached 
 	//----------------------------------------------------------------------------------------------------------------------
@@ -1280,6 +1305,8 @@ void GameMode3D::UpdateCreatureRootPosInput_Walking( float deltaSeconds )
 	kBasis   = kBasis.GetNormalized();
 
 	Vec3 moveIntention = m_moveFwdDir;
+	IK_Joint3D* movedRoot	= g_debugToggleLegs_2 ? m_root : m_quadruped->m_root;
+	Vec3		prevRootPos	= movedRoot->m_jointPos_LS;
 	//----------------------------------------------------------------------------------------------------------------------
 	// All directions are local
 	//----------------------------------------------------------------------------------------------------------------------
@@ -1375,6 +1402,9 @@ void GameMode3D::UpdateCreatureRootPosInput_Walking( float deltaSeconds )
 		moveIntention -= ( kBasis * m_currentSpeed ) * deltaSeconds;
 	}
 
+	// Resolve this frame's root motion against the scene in one sweep
+	movedRoot->m_jointPos_LS = SweepRootMotion( prevRootPos, movedRoot->m_jointPos_LS - prevRootPos );
+
 	//----------------------------------------------------------------------------------------------------------------------
 	// Enable Climb
 	//----------------------------------------------------------------------------------------------------------------------
@@ -1409,7 +1439,7 @@ void GameMode3D::UpdateCreatureRootPosInput_Walking( float deltaSeconds )
 void GameMode3D::UpdateCreatureHeight( float deltaSeconds )
 {
 	// Breathing
-	m_currentTime		= float( GetCurrentTimeSeconds() );
+	m_currentTime		= g_theApp->m_gameClock.GetTotalSeconds();
 	float sine			= SinDegrees( m_currentTime * 60.0f );
 	float heightOffset	= 1.0f;
 
@@ -1424,7 +1454,8 @@ void GameMode3D::UpdateCreatureHeight( float deltaSeconds )
 	// Lerp from currentRootPos to goalPos
 	float fractionTowardsEnd			= 0.01f;
 	fractionTowardsEnd					+= deltaSeconds * 8.0f;
-	m_root->m_jointPos_LS.z			    = Interpolate( m_root->m_jointPos_LS.z, rootGoalHeightZ, fractionTowardsEnd );
+	float rootHeightZ					= Interpolate( m_root->m_jointPos_LS.z, rootGoalHeightZ, fractionTowardsEnd );
+	m_root->m_jointPos_LS			    = SweepRootMotion( m_root->m_jointPos_LS, Vec3( 0.0f, 0.0f, rootHeightZ - m_root->m_jointPos_LS.z ) );
 //	m_root->m_jointPos_LS.z			    = 30.0f;		// #Constraints Hack code
 //	hipGoalHeightZ						= 30.0f;		// #Constraints Hack code
 //	m_root->m_jointPos_LS.z			    = 20.0f;		// #Constraints Hack code
@@ -1436,6 +1467,43 @@ void GameMode3D::UpdateCreatureHeight( float deltaSeconds )
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Collide and slide: move until the body capsule touches something, drop the part of the motion going into the
+// contact and carry on with the rest. Anything the body already overlaps only blocks motion going deeper into it, so
+// it can still walk out.
+//----------------------------------------------------------------------------------------------------------------------
+Vec3 GameMode3D::SweepRootMotion( Vec3 const& rootPos, Vec3 const& rootDisp ) const
+{
+	Vec3 currentPos		= rootPos;
+	Vec3 remainingDisp	= rootDisp;
+	Vec3 capsuleOffset	= Vec3( 0.0f, 0.0f, m_rootCollisionHalfHeight );
+	for ( int i = 0; i < m_maxRootSlideIterations; i++ )
+	{
+		float remainingDist = remainingDisp.GetLength();
+		if ( remainingDist < 0.0001f )
+		{
+			break;
+		}
+		Vec3 sweepDir = remainingDisp / remainingDist;
+		SceneRaycastResult sweepResult = m_sceneSpatialIndex.SweepCapsule( currentPos - capsuleOffset, currentPos + capsuleOffset, m_rootCollisionRadius,
+																		   sweepDir, remainingDist, SCENE_QUERY_TERRAIN | SCENE_QUERY_BLOCKS, true );
+		if ( !sweepResult.m_rayResult.m_didImpact )
+		{
+			currentPos += remainingDisp;
+			break;
+		}
+
+		// Stop just short of the contact so the next sweep does not start touching it
+		float travelDist	= sweepResult.m_rayResult.m_impactDist - m_rootCollisionSkin;
+		travelDist			= ( travelDist > 0.0f ) ? travelDist : 0.0f;
+		currentPos		   += sweepDir * travelDist;
+		Vec3 const& normal	= sweepResult.m_rayResult.m_impactNormal;
+		remainingDisp		= sweepDir * ( remainingDist - travelDist );
+		remainingDisp	   -= normal * DotProduct3D( remainingDisp, normal );
+	}
+	return currentPos;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void GameMode3D::DetermineBestSprintStepPos()
 {
@@ -1481,7 +1549,7 @@ void GameMode3D::DetermineBestSprintStepPos()
 			{
 				m_rightArm->m_target.m_goalPos = m_raycast_rightArmDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, halfArmLength, -quarterArmLength );
+			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, m_rightArm, halfArmLength, -quarterArmLength );
 			 m_rightArm->m_anchorState = ANCHOR_STATE_MOVING;
 			m_rightFoot->m_anchorState = ANCHOR_STATE_LOCKED;
 			 m_leftFoot->m_anchorState = ANCHOR_STATE_LOCKED;
@@ -1517,7 +1585,7 @@ void GameMode3D::DetermineBestSprintStepPos()
 			{
 				m_leftArm->m_target.m_goalPos = m_raycast_LeftArmDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, halfArmLength, quarterArmLength );
+			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, m_leftArm, halfArmLength, quarterArmLength );
 			 m_leftArm->m_anchorState  = ANCHOR_STATE_MOVING;	
 			m_leftFoot->m_anchorState  = ANCHOR_STATE_LOCKED;
 			m_rightFoot->m_anchorState = ANCHOR_STATE_LOCKED;
@@ -1553,7 +1621,7 @@ void GameMode3D::DetermineBestSprintStepPos()
 			{
 				m_rightFoot->m_target.m_goalPos = m_raycast_rightFootDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_hip->m_firstJoint, halfFeetLength, -quarterFeetLength );
+			SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_rightFoot, m_hip->m_firstJoint, halfFeetLength, -quarterFeetLength );
 			m_rightFoot->m_anchorState = ANCHOR_STATE_MOVING;
 			 m_rightArm->m_anchorState = ANCHOR_STATE_LOCKED;
 			 m_leftFoot->m_anchorState = ANCHOR_STATE_LOCKED;
@@ -1589,7 +1657,7 @@ void GameMode3D::DetermineBestSprintStepPos()
 			{
 				m_leftFoot->m_target.m_goalPos = m_raycast_leftFootDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_leftFoot->m_target.m_goalPos, m_hip->m_firstJoint, halfFeetLength, quarterFeetLength );
+			SpecifyFootPlacementPos( m_leftFoot->m_target.m_goalPos, m_leftFoot, m_hip->m_firstJoint, halfFeetLength, quarterFeetLength );
 			m_leftFoot->m_anchorState = ANCHOR_STATE_MOVING;
 			 m_leftArm->m_anchorState  = ANCHOR_STATE_LOCKED;
 			m_rightArm->m_anchorState  = ANCHOR_STATE_LOCKED;
@@ -1651,8 +1719,8 @@ void GameMode3D::DetermineBestWalkStepPos()
 			{
 				m_rightArm->m_target.m_goalPos = m_raycast_rightArmDown.m_updatedImpactPos;
 			}
-//			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, quarterArmLength, -quarterArmLength );
-			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, halfArmLength, -quarterArmLength );
+//			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, m_rightArm, quarterArmLength, -quarterArmLength );
+			SpecifyFootPlacementPos( m_rightArm->m_target.m_goalPos, m_rightArm, halfArmLength, -quarterArmLength );
 			m_root->m_eulerAngles_LS.GetAsVectors_XFwd_YLeft_ZUp( m_root->m_fwdDir, m_root->m_leftDir, m_root->m_upDir );
 			m_rightArm->m_target.m_fwdDir  = m_root->m_fwdDir;
 			m_rightArm->m_target.m_leftDir = m_root->m_leftDir;
@@ -1713,8 +1781,8 @@ void GameMode3D::DetermineBestWalkStepPos()
 			{
 				m_leftArm->m_target.m_goalPos = m_raycast_LeftArmDown.m_updatedImpactPos;
 			}
-//			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, quarterArmLength , quarterArmLength );
-			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, halfArmLength, quarterArmLength );
+//			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, m_leftArm, quarterArmLength , quarterArmLength );
+			SpecifyFootPlacementPos( m_leftArm->m_target.m_goalPos, m_leftArm, halfArmLength, quarterArmLength );
 			m_root->m_eulerAngles_LS.GetAsVectors_XFwd_YLeft_ZUp( m_root->m_fwdDir, m_root->m_leftDir, m_root->m_upDir );
 			m_leftArm->m_target.m_fwdDir   = m_root->m_fwdDir;
 			m_leftArm->m_target.m_leftDir  = m_root->m_leftDir;
@@ -1774,7 +1842,7 @@ void GameMode3D::DetermineBestWalkStepPos()
 			{
 				m_rightFoot->m_target.m_goalPos = m_raycast_rightFootDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_hip->m_firstJoint, halfFeetLength, -quarterFeetLength );
+			SpecifyFootPlacementPos( m_rightFoot->m_target.m_goalPos, m_rightFoot, m_hip->m_firstJoint, halfFeetLength, -quarterFeetLength );
 			m_root->m_eulerAngles_LS.GetAsVectors_XFwd_YLeft_ZUp( m_root->m_fwdDir, m_root->m_leftDir, m_root->m_upDir );
 			m_rightFoot->m_target.m_fwdDir  = m_root->m_fwdDir;
 			m_rightFoot->m_target.m_leftDir = m_root->m_leftDir;
@@ -1833,7 +1901,7 @@ void GameMode3D::DetermineBestWalkStepPos()
 			{
 				m_leftFoot->m_target.m_goalPos = m_raycast_leftFootDown.m_updatedImpactPos;
 			}
-			SpecifyFootPlacementPos( m_leftFoot->m_target.m_goalPos, m_hip->m_firstJoint, halfFeetLength, quarterFeetLength );
+			SpecifyFootPlacementPos( m_leftFoot->m_target.m_goalPos, m_leftFoot, m_hip->m_firstJoint, halfFeetLength, quarterFeetLength );
 			m_root->m_eulerAngles_LS.GetAsVectors_XFwd_YLeft_ZUp( m_root->m_fwdDir, m_root->m_leftDir, m_root->m_upDir );
 			m_leftFoot->m_target.m_fwdDir  = m_root->m_fwdDir;
 			m_leftFoot->m_target.m_leftDir = m_root->m_leftDir;
@@ -1888,7 +1956,7 @@ bool GameMode3D::IsLimbIsTooFarFromHip( IK_Chain3D* currentLimb, Vec3 footTarget
 
 
 //----------------------------------------------------------------------------------------------------------------------
-void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, float fwdStepAmount, float leftStepAmount )
+void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, float fwdStepAmount, float leftStepAmount )
 {
 	Vec3 prevTargetPos		= targetPos;
 
@@ -1897,17 +1965,13 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, float fwdStepAmount,
 	Vec3 moveLeftDir		= m_moveFwdDir.GetRotatedAboutZDegrees( 90.0f );	
 	Vec3 idealNewPos		= Vec3( m_root->m_jointPos_LS.x, m_root->m_jointPos_LS.y, 0.0f ) + ( m_moveFwdDir * fwdStepAmount ) + ( moveLeftDir * leftStepAmount );
 
-	// Use raycast to ensure the ideal next step is "placed" on a walkable block
-	RaycastResult3D raycastResult3D;
-	Vec3 rayStartPos		= idealNewPos + Vec3( 0.0f, 0.0f, 5.0f );
-	Vec3 impactPos			= Vec3::ZERO;
-	Vec3 impactNormal		= Vec3::ZERO;
+	// Walk the nav graph toward the ideal next step, it is "placed" on a walkable surface the limb can step onto
+	Vec3 goalHintPos		= Vec3( idealNewPos.x, idealNewPos.y, prevTargetPos.z );
+	float maxStepHeight		= m_walkableNavGraph.GetMaxStepHeightForChain( limbChain );
 	bool didRayImpactBlock	= false;
-//	didRayImpactBlock		= DidRaycastHitWalkableBlock( raycastResult3D, rayStartPos, Vec3::NEGATIVE_Z, m_raylength_Long, impactPos, impactNormal );
-	didRayImpactBlock		= m_quadruped->DoesRaycastHitFloor( raycastResult3D, rayStartPos, Vec3::NEGATIVE_Z, maxLength );
-	idealNewPos				= raycastResult3D.m_impactPos;
+	float maxStrideLength	= maxLength * 2.0f;		// A stride swings the foot from behind the body to in front of it
+	didRayImpactBlock		= m_walkableNavGraph.FindNextFootPos( prevTargetPos, goalHintPos, maxStrideLength, maxStepHeight, idealNewPos );
 
-	float distRootToPreviousAlternativePos = 500.0f;
 	// Ensure ideal next step is close enough AND on a walkable block
 //	float distRootToNewPos = GetDistance3D( idealNewPos, m_root->m_jointPos_LS );
 //	if ( CompareIfFloatsAreEqual( distRootToNewPos, maxLength, 2.0f ) && didRayImpactBlock )
@@ -1919,60 +1983,19 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, float fwdStepAmount,
 	else
 	{
 		// Since normal "next step" position is invalid, find better footPlacement position
-
-		/*
-		//  Get nearest valid footstep algorithm
-		  	1. Check if this block is walkable
-		  	2. Check if alternative next step is close enough
-		  		2a. True: Step
-		  		2b. False: Keep searching
-		  			2b1. Stay in the same position if next position was not found
-		*/
-
-		Vec3 nearestPoint3D = Vec3( 0.0f, 0.0f, -1000.0f );
-		for ( int i = 0; i < m_blockList.size(); i++ )
-		{
-			// Ensure currentBlock is "Walkable"
-			Block* currentBlock = m_blockList[i];
-			if ( !currentBlock->m_isWalkable )
-			{
-				continue;
-			}
-
-			// Get nearestPoint
-			Vec3 alternativeNewPos	= currentBlock->m_aabb3.GetNearestPoint( idealNewPos );
-			alternativeNewPos.z		= currentBlock->m_aabb3.m_maxs.z;
-
-			// Determine the closest position as valid 
-			float distRootToNewAlternativePos = GetDistance3D( alternativeNewPos, m_root->m_jointPos_LS );
-			if ( distRootToNewAlternativePos <= maxLength )
-			{
-				nearestPoint3D						= alternativeNewPos;
-				distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-			}
-			else
-			{
-				// Keep track of the closest position to creature
-				if ( distRootToNewAlternativePos <= distRootToPreviousAlternativePos )
-				{
-					nearestPoint3D						= alternativeNewPos;
-					distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-				}
-			}
-		}
-
-		if ( nearestPoint3D == Vec3( 0.0f, 0.0f, -1000.0f ) )
+		// The search is XY only, so also check it is within maxLength of the root in 3D; stay in the same position if not
+		Vec3 nearestWalkablePos = prevTargetPos;
+		bool didFindSurface		= m_walkableSurfaceIndex.GetNearestWalkablePoint( idealNewPos, maxLength, nearestWalkablePos );
+		if ( !didFindSurface || ( GetDistance3D( nearestWalkablePos, m_root->m_jointPos_LS ) > maxLength ) )
 		{
-			nearestPoint3D = prevTargetPos;
+			nearestWalkablePos	= prevTargetPos;
 		}
-
-		// Set targetPos to nearestPoint
-		targetPos = nearestPoint3D;
+		targetPos = nearestWalkablePos;
 	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb, float fwdStepAmount, float leftStepAmount )
+void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, IK_Joint3D* refLimb, float fwdStepAmount, float leftStepAmount )
 {
 	Vec3 prevTargetPos	= targetPos;
 	// Determine the ideal next step position
@@ -1981,17 +2004,13 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb,
 	Vec3 refLimbLeftDir	= refLimb->m_eulerAngles_LS.GetAsMatrix_XFwd_YLeft_ZUp().GetJBasis3D();
 	Vec3 idealNewPos	= Vec3( refLimb->m_jointPos_LS.x, refLimb->m_jointPos_LS.y, 0.0f ) + ( refLimbFwdDir * fwdStepAmount ) + ( refLimbLeftDir * leftStepAmount );
 
-	// Use raycast to ensure the ideal next step is "placed" on a walkable block
-	RaycastResult3D raycastResult3D;
-	Vec3 rayStartPos		= idealNewPos + Vec3( 0.0f, 0.0f, 5.0f );
-	Vec3 impactPos			= Vec3::ZERO;
-	Vec3 impactNormal		= Vec3::ZERO;
+	// Walk the nav graph toward the ideal next step, it is "placed" on a walkable surface the limb can step onto
+	Vec3 goalHintPos		= Vec3( idealNewPos.x, idealNewPos.y, prevTargetPos.z );
+	float maxStepHeight		= m_walkableNavGraph.GetMaxStepHeightForChain( limbChain );
 	bool didRayImpactBlock	= false;
-//	didRayImpactBlock		= DidRaycastHitWalkableBlock( raycastResult3D, rayStartPos, Vec3::NEGATIVE_Z, m_raylength_Long, impactPos, impactNormal );
-	didRayImpactBlock		= m_quadruped->DoesRaycastHitFloor( raycastResult3D, rayStartPos, Vec3::NEGATIVE_Z, maxLength );
-	idealNewPos				= raycastResult3D.m_impactPos;
+	float maxStrideLength	= maxLength * 2.0f;		// A stride swings the foot from behind the body to in front of it
+	didRayImpactBlock		= m_walkableNavGraph.FindNextFootPos( prevTargetPos, goalHintPos, maxStrideLength, maxStepHeight, idealNewPos );
 
-	float distRootToPreviousAlternativePos = 500.0f;
 	// Ensure ideal next step is close enough AND on a walkable block
 //	float distRootToNewPos	= GetDistance3D( idealNewPos, refLimb->m_jointPos_LS );
 //	if ( CompareIfFloatsAreEqual( distRootToNewPos, maxLength, 2.0f ) && didRayImpactBlock )
@@ -2003,72 +2022,14 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb,
 	else
 	{
 		// Since normal "next step" position is invalid, find better footPlacement position
-		/*
-		//  Get nearest valid footstep algorithm
-		  	1. Check if this block is walkable
-		  	2. Check if alternative next step is close enough
-		  		2a. True: Step
-		  		2b. False: Keep searching
-		  			2b1. Stay in the same position if next position was not found
-		*/
-
-		Vec3 nearestPoint3D = Vec3( 0.0f, 0.0f, -1000.0f );
-		for ( int i = 0; i < m_blockList.size(); i++ )
+		// The search is XY only, so also check it is within maxLength of refLimb in 3D; stay in the same position if not
+		Vec3 nearestWalkablePos = prevTargetPos;
+		bool didFindSurface		= m_walkableSurfaceIndex.GetNearestWalkablePoint( idealNewPos, maxLength, nearestWalkablePos );
+		if ( !didFindSurface || ( GetDistance3D( nearestWalkablePos, refLimb->m_jointPos_LS ) > maxLength ) )
 		{
-			// Ensure currentBlock is "Walkable"
-			Block* currentBlock = m_blockList[i];
-			if ( !currentBlock->m_isWalkable )
-			{
-				continue;
-			}
-
-			// Get nearestPoint
-			Vec3 alternativeNewPos	= currentBlock->m_aabb3.GetNearestPoint( idealNewPos );
-			alternativeNewPos.z		= currentBlock->m_aabb3.m_maxs.z;
-
-			// Determine the closest position as valid 
-			float distRootToNewAlternativePos = GetDistance3D( alternativeNewPos, m_root->m_jointPos_LS );
-			if ( distRootToNewAlternativePos <= maxLength )
-			{
-				nearestPoint3D						= alternativeNewPos;
-				distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-			}
-			else
-			{
-				// Keep track of the closest position to creature
-				if ( distRootToNewAlternativePos <= distRootToPreviousAlternativePos )
-				{
-					nearestPoint3D						= alternativeNewPos;
-					distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-				}
-			}
-
-/*
-			// Determine the closest position as valid 
-			float distRootToNewAlternativePos = GetDistance3D( alternativeNewPos, m_root->m_jointPos_LS );
-			if ( distRootToNewAlternativePos <= maxLength )
-			{
-				nearestPoint3D						= alternativeNewPos;
-				distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-			}
-			else
-			{
-				// Keep track of the closest position to creature
-				if ( distRootToNewAlternativePos <= distRootToPreviousAlternativePos )
-				{
-					nearestPoint3D = alternativeNewPos;
-				}
-			}
-*/
+			nearestWalkablePos	= prevTargetPos;
 		}
-
-		if ( nearestPoint3D == Vec3( 0.0f, 0.0f, -1000.0f ) )
-		{
-			nearestPoint3D = prevTargetPos;
-		}
-
-		// Set targetPos to nearestPoint
-		targetPos = nearestPoint3D;
+		targetPos = nearestWalkablePos;
 	}
 }
 
@@ -2089,7 +2050,6 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb,
 	bool didRayImpactBlock	= false;
 	didRayImpactBlock		= DidRaycastHitWalkableBlock( raycastResult3D, rayStartPos, Vec3::NEGATIVE_Z, m_raylength_Long, impactPos, impactNormal );
 
-	float distRootToPreviousAlternativePos = 500.0f;
 	// Ensure ideal next step is close enough AND on a walkable block
 	float distRootToNewPos	= GetDistance3D( idealNewPos, refLimb->m_jointPos_LS );
 	if ( CompareIfFloatsAreEqual( distRootToNewPos, maxLength, 2.0f ) && didRayImpactBlock )
@@ -2100,54 +2060,14 @@ void GameMode3D::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb,
 	else
 	{
 		// Since normal "next step" position is invalid, find better footPlacement position
-		/*
-			Get nearest valid footstep algorithm
-			1. Check if this block is walkable
-			2. Check if alternative next step is close enough
-			2a. True: Step
-			2b. False: Keep searching
-			2b1. Stay in the same position if next position was not found
-		*/
-
-		Vec3 nearestPoint3D = Vec3( 0.0f, 0.0f, -1000.0f );
-		for ( int i = 0; i < m_blockList.size(); i++ )
-		{
-			// Ensure currentBlock is "Walkable"
-			Block* currentBlock = m_blockList[i];
-			if ( !currentBlock->m_isWalkable )
-			{
-				continue;
-			}
-
-			// Get nearestPoint
-			Vec3 alternativeNewPos	= currentBlock->m_aabb3.GetNearestPoint( idealNewPos );
-			alternativeNewPos.z		= currentBlock->m_aabb3.m_maxs.z;
-
-			// Determine the closest position as valid 
-			float distRootToNewAlternativePos = GetDistance3D( alternativeNewPos, refLimb->m_jointPos_LS );
-			if ( distRootToNewAlternativePos <= maxLength )
-			{
-				nearestPoint3D						= alternativeNewPos;
-				distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-			}
-			else
-			{
-				// Keep track of the closest position to creature
-				if ( distRootToNewAlternativePos <= distRootToPreviousAlternativePos )
-				{
-					nearestPoint3D						= alternativeNewPos;
-					distRootToPreviousAlternativePos	= distRootToNewAlternativePos;
-				}
-			}
-		}
-
-		if ( nearestPoint3D == Vec3( 0.0f, 0.0f, -1000.0f ) )
+		// The search is XY only, so also check it is within maxLength of refLimb in 3D; stay in the same position if not
+		Vec3 nearestWalkablePos = prevTargetPos;
+		bool didFindSurface		= m_walkableSurfaceIndex.GetNearestWalkablePoint( idealNewPos, maxLength, nearestWalkablePos );
+		if ( !didFindSurface || ( GetDistance3D( nearestWalkablePos, refLimb->m_jointPos_LS ) > maxLength ) )
 		{
-			nearestPoint3D = prevTargetPos;
+			nearestWalkablePos	= prevTargetPos;
 		}
-
-		// Set targetPos to nearestPoint
-		targetPos = nearestPoint3D;
+		targetPos = nearestWalkablePos;
 	}
 }
 
@@ -2179,6 +2099,7 @@ void GameMode3D::InitStepBezier( CubicBezierCurve3D& bezierCurve, IK_Chain3D* co
 	bezierCurve.m_endPos	= end;
 	// Start bezierTimer;
 	bezierTimer.Start();
+	COUNTER_ADD( "Bezier steps started", 1 );
 }
 
 
@@ -2311,6 +2232,29 @@ void GameMode3D::InitializeEnvironment()
 	m_blockList.emplace_back( m_cliff );
 
 	m_map = new Map_GameMode3D( this );
+	RebuildSpatialIndices();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void GameMode3D::RebuildSpatialIndices()
+{
+	m_walkableSurfaceIndex.Rebuild( m_blockList, m_map->m_planeVerts, m_map->m_indexList );
+	m_sceneSpatialIndex.RebuildStatic( m_blockList, m_map->m_planeVerts, m_map->m_indexList );
+
+	// Step edges are built for the longest limb, shorter limbs tighten the limit per query
+	std::vector<IK_Chain3D*> chainList = m_quadruped->m_skeletalSystemsList;
+	chainList.push_back( m_rightArm  );
+	chainList.push_back( m_rightFoot );
+	float maxStepHeight = 0.0f;
+	for ( int i = 0; i < chainList.size(); i++ )
+	{
+		float chainStepHeight = m_walkableNavGraph.GetMaxStepHeightForChain( chainList[i] );
+		if ( chainStepHeight > maxStepHeight )
+		{
+			maxStepHeight = chainStepHeight;
+		}
+	}
+	m_walkableNavGraph.Rebuild( m_walkableSurfaceIndex, m_sceneSpatialIndex, maxStepHeight );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2454,6 +2398,17 @@ void GameMode3D::RenderRaycasts( std::vector<Vertex_PCU>& verts ) const
 	//----------------------------------------------------------------------------------------------------------------------
 	m_quadruped->DebugRenderRaycasts( verts );
 
+	//----------------------------------------------------------------------------------------------------------------------
+	// Camera pick
+	//----------------------------------------------------------------------------------------------------------------------
+	if ( m_rayVsTri.m_didImpact )
+	{
+		Vec3  impactNormalEnd	= m_rayVsTri.m_impactPos + m_rayVsTri.m_impactNormal * 4.0f;
+		Rgba8 impactColor		= ( m_cameraPickType == SCENE_COLLIDER_LIMB ) ? Rgba8::YELLOW : Rgba8::MAGENTA;
+		AddVertsForArrow3D ( verts, m_rayVsTri.m_impactPos,	impactNormalEnd, 0.1f, Rgba8::BLUE );
+		AddVertsForSphere3D( verts, m_rayVsTri.m_impactPos,	0.5f, 6.0f, 4.0f, impactColor );
+	}
+
 	//----------------------------------------------------------------------------------------------------------------------
 	// Mount raycast
 	//----------------------------------------------------------------------------------------------------------------------
@@ -2853,10 +2808,63 @@ void GameMode3D::MoveRaycastInput( float deltaSeconds )
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void GameMode3D::RetrieveCameraPick()
+{
+	if ( !m_isCameraPickPending )
+	{
+		return;
+	}
+
+	// The pick is tiny and had all of Render to finish, EndFrame has already waited on it
+	g_theJobSystem->WaitFor( m_cameraPickCounter );
+	m_rayVsTri				= m_cameraPickResult.m_rayResult;
+	m_cameraPickType		= m_cameraPickResult.m_colliderType;
+	m_isCameraPickPending	= false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void GameMode3D::RequestCameraPick()
+{
+	// Only the debug raycast view needs the camera pick
+	if ( !g_debugRenderRaycast_F2 )
+	{
+		return;
+	}
+
+	// Limbs moved this frame, refresh their capsules before the pick reads them
+	float limbRadius = 1.0f;		// Matches the rendered joint spheres
+	m_sceneSpatialIndex.ClearLimbCapsules();
+	m_sceneSpatialIndex.AddLimbCapsules( m_creatureSkeletalSystemsList,		 limbRadius );
+	m_sceneSpatialIndex.AddLimbCapsules( m_quadruped->m_skeletalSystemsList, limbRadius );
+
+	Vec3  rayStart		= m_gameMode3DWorldCamera.m_position;
+	Vec3  rayFwdNormal	= m_gameMode3DWorldCamera.m_orientation.GetForwardDir_XFwd_YLeft_ZUp();
+	float rayMaxLength	= 100.0f;
+	if ( g_theJobSystem == nullptr )
+	{
+		SceneRaycastResult pickResult	= m_sceneSpatialIndex.Raycast( rayStart, rayFwdNormal, rayMaxLength );
+		m_rayVsTri						= pickResult.m_rayResult;
+		m_cameraPickType				= pickResult.m_colliderType;
+		return;
+	}
+	SceneSpatialIndex const*	sceneIndex	= &m_sceneSpatialIndex;
+	SceneRaycastResult*			pickResult	= &m_cameraPickResult;
+	g_theJobSystem->PostFrameJob( [sceneIndex, pickResult, rayStart, rayFwdNormal, rayMaxLength]()
+	{
+		*pickResult = sceneIndex->Raycast( rayStart, rayFwdNormal, rayMaxLength );
+	}, &m_cameraPickCounter, JOB_PRIORITY_FRAME_CRITICAL );
+	m_isCameraPickPending = true;
+}
+
 
 //----------------------------------------------------------------------------------------------------------------------
 bool GameMode3D::DidRaycastHitTriangle( RaycastResult3D& raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal )
 {
+	PROFILE_SCOPE( "GameMode3D::DidRaycastHitTriangle" );
+	// Brute force, every triangle of the map
+	COUNTER_ADD( "Raycasts", 1 );
+	COUNTER_ADD( "Triangles tested", m_map->m_indexList.size() / 3 );
 	bool  didImpact		= false;
 	float t, u, v		= 0.0f;
 	RaycastResult3D tempRayResult;
@@ -2890,6 +2898,10 @@ bool GameMode3D::DidRaycastHitTriangle( RaycastResult3D& raycastResult, Vec3& ra
 //----------------------------------------------------------------------------------------------------------------------
 bool GameMode3D::DidRaycastHitWalkableBlock( RaycastResult3D& raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal )
 {
+	PROFILE_SCOPE( "GameMode3D::DidRaycastHitWalkableBlock" );
+	// Brute force, every block
+	COUNTER_ADD( "Raycasts", 1 );
+	COUNTER_ADD( "Blocks tested", m_blockList.size() );
 	float superDist_FWD = 500.0f;
 	bool  didImpact		= false;
 	RaycastResult3D tempRayResult;
@@ -2926,6 +2938,10 @@ bool GameMode3D::DidRaycastHitWalkableBlock( RaycastResult3D& raycastResult, Vec
 //----------------------------------------------------------------------------------------------------------------------
 bool GameMode3D::DidRaycastHitClimbableBlock( RaycastResult3D& raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal )
 {
+	PROFILE_SCOPE( "GameMode3D::DidRaycastHitClimbableBlock" );
+	// Brute force, every block
+	COUNTER_ADD( "Raycasts", 1 );
+	COUNTER_ADD( "Blocks tested", m_blockList.size() );
 	float superDist_FWD = 500.0f;
 	bool  didImpact		= false;
 	for ( int i = 0; i < m_blockList.size(); i++ )
@@ -3,7 +3,12 @@
 #include "Game/GameModeBase.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/App.hpp"
+#include "Game/WalkableSurfaceIndex.hpp"
+#include "Game/WalkableNavGraph.hpp"
+#include "Game/SceneSpatialIndex.hpp"
+#include "Game/LimbCollisionSolver.hpp"
 
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -82,13 +87,14 @@ public:
 	void UpdateCreature( float deltaSeconds );
 	void UpdateCreatureRootPosInput_Walking( float deltaSeconds );
 	void UpdateCreatureHeight( float deltaSeconds );
+	Vec3 SweepRootMotion( Vec3 const& rootPos, Vec3 const& rootDisp ) const;
 	void DetermineBestSprintStepPos();
 	void DetermineBestWalkStepPos();
 	bool IsLimbIsTooFarFromRoot( IK_Chain3D* currentLimb, Vec3 footTargetPos );
 	bool IsLimbIsTooFarFromHip(  IK_Chain3D* currentLimb, Vec3 footTargetPos );
 	bool DoesTargetPosOverlapWalkableObject( Vec3& footTargetPos );
-	void SpecifyFootPlacementPos( Vec3& targetPos, float fwdStepAmount, float leftStepAmount );
-	void SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb, float fwdStepAmount, float leftStepAmount );
+	void SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, float fwdStepAmount, float leftStepAmount );
+	void SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, IK_Joint3D* refLimb, float fwdStepAmount, float leftStepAmount );
 	//----------------------------------------------------------------------------------------------------------------------
 	// #GenericRefactoring 
 	//----------------------------------------------------------------------------------------------------------------------
@@ -103,6 +109,7 @@ public:
 
 	// Environment
 	void InitializeEnvironment();
+	void RebuildSpatialIndices();
 	void RenderEnvironment( std::vector<Vertex_PCU>& verts ) const;
 
 	// Tree Functions
@@ -114,6 +121,8 @@ public:
 	void RenderRaycasts( std::vector<Vertex_PCU>& verts ) const;
 	void UpdateRaycastResult3D();
 	void MoveRaycastInput( float deltaSeconds );
+	void RetrieveCameraPick();
+	void RequestCameraPick();
 	bool DidRaycastHitTriangle( RaycastResult3D& raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal );
 	bool DidRaycastHitWalkableBlock(  RaycastResult3D& m_raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal );
 	bool DidRaycastHitClimbableBlock( RaycastResult3D& m_raycastResult, Vec3& rayStartPos, Vec3& rayfwdNormal, float rayLength, Vec3& updatedImpactPos, Vec3& updatedImpactNormal );
@@ -123,7 +132,11 @@ public:
 	Quadruped* m_quadruped = nullptr;
 
 	// Debug rayVsTri
-	RaycastResult3D m_rayVsTri;
+	RaycastResult3D		m_rayVsTri;
+	SceneColliderType	m_cameraPickType	= SCENE_COLLIDER_NONE;
+	SceneRaycastResult	m_cameraPickResult;					// Filled by a frame job posted at the end of Update, read at the start of the next one
+	JobCounter			m_cameraPickCounter;
+	bool				m_isCameraPickPending	= false;
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Core Variables
@@ -175,6 +188,11 @@ public:
 	float					m_rootDefaultHeightZ	= 20.0f;
 	float					m_maxArmLength			= m_limbLength * m_numArms;
 	float					m_maxFeetLength			= m_limbLength * m_numFeet;
+	// Root body capsule, swept along each frame's root motion so sprinting cannot tunnel through blocks
+	float					m_rootCollisionRadius		= 6.0f;
+	float					m_rootCollisionHalfHeight	= 3.0f;
+	float					m_rootCollisionSkin			= 0.05f;
+	int						m_maxRootSlideIterations	= 3;
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Creature Limb placement variables
@@ -224,6 +242,11 @@ public:
 	// Block Objects
 	//----------------------------------------------------------------------------------------------------------------------
 	std::vector<Block*> m_blockList; 
+	WalkableSurfaceIndex m_walkableSurfaceIndex;		// Block tops + terrain, used to snap foot targets that missed the floor
+	WalkableNavGraph	 m_walkableNavGraph;			// Footstep graph over the walkable surfaces, used to place foot targets
+	SceneSpatialIndex	 m_sceneSpatialIndex;			// Blocks + terrain + limb capsules, used for camera picking
+	LimbCollisionSolver	 m_creatureLimbCollision;		// One per creature, each has its own test budget
+	LimbCollisionSolver	 m_quadrupedLimbCollision;
 	// Floors
 	Block* m_floor_NE	= new Block( AABB3(	  10.0f,   10.0f, 0.0f, 400.0f, 1500.0f,   1.0f ), true );
 	Block* m_floor_NW	= new Block( AABB3( -200.0f,   10.0f, 0.0f, -10.0f,  200.0f,  40.0f ), true );
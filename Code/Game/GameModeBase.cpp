@@ -56,8 +56,11 @@ void GameModeBase::UpdatePauseQuitAndSlowMo()
 	// Pause functionality
 	if ( g_theInput->WasKeyJustPressed( 'P' ) || g_theInput->GetController( 0 ).WasButtonJustPressed( XboxButtonID::BUTTON_START ) )
 	{
-		SoundID testSound = g_theAudio->CreateOrGetSound( "Data/Audio/TestSound.mp3" );
-		g_theAudio->StartSound( testSound );			// Comment out this line of code to remove pause sound playing
+		if ( g_theAudio )
+		{
+			SoundID testSound = g_theAudio->CreateOrGetSound( "Data/Audio/TestSound.mp3" );
+			g_theAudio->StartSound( testSound );			// Comment out this line of code to remove pause sound playing
+		}
 
 		g_theApp->m_gameClock.TogglePause();
 	}
@@ -0,0 +1,292 @@
+#include "Game/LimbCollisionSolver.hpp"
+#include "Game/SceneSpatialIndex.hpp"
+#include "Game/GameMode3D.hpp"
+
+#include "Engine/SkeletalSystem/IK_Chain3D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <math.h>
+
+
+//----------------------------------------------------------------------------------------------------------------------
+LimbCollisionSolver::LimbCollisionSolver()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+LimbCollisionSolver::~LimbCollisionSolver()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void LimbCollisionSolver::SolveChains( std::vector<IK_Chain3D*> const& chainList, SceneSpatialIndex const& sceneIndex )
+{
+	m_numNarrowphaseTests	= 0;
+	m_numPushes				= 0;
+	int numChains			= int( chainList.size() );
+	if ( numChains == 0 )
+	{
+		return;
+	}
+	if ( m_firstChainIndex >= numChains )
+	{
+		m_firstChainIndex = 0;
+	}
+
+	for ( int i = 0; i < numChains; i++ )
+	{
+		int chainIndex = ( m_firstChainIndex + i ) % numChains;
+		if ( !SolveChain( chainList[ chainIndex ], sceneIndex ) )
+		{
+			// Out of budget, this chain did not finish so it goes first next frame
+			m_firstChainIndex = chainIndex;
+			return;
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LimbCollisionSolver::SolveChain( IK_Chain3D* chain, SceneSpatialIndex const& sceneIndex )
+{
+	// Only FABRIK chains keep world space positions in m_jointPos_LS and m_endPos
+	if ( chain->m_solverType != CHAIN_SOLVER_FABRIK )
+	{
+		return true;
+	}
+
+	bool hasBudget		= true;
+	Vec3 inheritedDisp	= Vec3::ZERO;
+	for ( int jointIndex = 0; jointIndex < chain->m_jointList.size(); jointIndex++ )
+	{
+		// Carry along whatever the parent segments were pushed by
+		IK_Joint3D* currentJoint = chain->m_jointList[ jointIndex ];
+		if ( jointIndex > 0 )
+		{
+			currentJoint->m_jointPos_LS = chain->m_jointList[ jointIndex - 1 ]->m_endPos;
+		}
+		Vec3 originalEndPos		 = currentJoint->m_endPos;
+		currentJoint->m_endPos	+= inheritedDisp;
+
+		if ( hasBudget )
+		{
+			// The end effector is meant to touch the ground, so keep its tip out of the test
+			bool  isFinalJoint		= ( jointIndex == ( chain->m_jointList.size() - 1 ) );
+			float tipTrimLength		= isFinalJoint ? ( 2.0f * m_limbRadius ) : 0.0f;
+			hasBudget				= ResolveCapsule( currentJoint->m_jointPos_LS, currentJoint->m_endPos, currentJoint->m_distToChild, tipTrimLength, sceneIndex );
+		}
+		currentJoint->UpdateFwdFromEndStart();
+		inheritedDisp = currentJoint->m_endPos - originalEndPos;
+	}
+	return hasBudget;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LimbCollisionSolver::ResolveCapsule( Vec3 const& boneStart, Vec3& boneEnd, float boneLength, float tipTrimLength, SceneSpatialIndex const& sceneIndex )
+{
+	if ( boneLength <= tipTrimLength )
+	{
+		return true;
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Broadphase
+	//----------------------------------------------------------------------------------------------------------------------
+	Vec3  testEnd	= boneStart + ( ( boneEnd - boneStart ).GetNormalized() * ( boneLength - tipTrimLength ) );
+	AABB2 bounds	= AABB2( Vec2( boneStart.x, boneStart.y ), Vec2( boneStart.x, boneStart.y ) );
+	bounds.StretchToIncludePoint( Vec2( testEnd.x, testEnd.y ) );
+	bounds.m_mins  -= Vec2( m_limbRadius, m_limbRadius );
+	bounds.m_maxs  += Vec2( m_limbRadius, m_limbRadius );
+	sceneIndex.m_staticGrid.GetItemsOverlappingBounds( bounds, m_candidateList );
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Narrowphase; a push rotates the bone so one pass can under-correct or push it into a neighbour, repeat until settled.
+	// A push can swing the bone out of the queried bounds, so grow them and query again before testing any further
+	//----------------------------------------------------------------------------------------------------------------------
+	int numBlocks = int( sceneIndex.m_blockList.size() );
+	for ( int iteration = 0; iteration < m_maxIterationsPerCapsule; iteration++ )
+	{
+		bool didPush = false;
+		for ( int i = 0; i < m_candidateList.size(); i++ )
+		{
+			int   itemIndex		= m_candidateList[i];
+			float capsuleMinZ	= ( ( boneStart.z < testEnd.z ) ? boneStart.z : testEnd.z ) - m_limbRadius;
+			float capsuleMaxZ	= ( ( boneStart.z > testEnd.z ) ? boneStart.z : testEnd.z ) + m_limbRadius;
+			Vec3  contactPos	= Vec3::ZERO;
+			Vec3  pushOut		= Vec3::ZERO;
+			bool  isPenetrating = false;
+			if ( itemIndex < numBlocks )
+			{
+				AABB3 const& box = sceneIndex.m_blockList[ itemIndex ]->m_aabb3;
+				if ( capsuleMaxZ < box.m_mins.z || capsuleMinZ > box.m_maxs.z )
+				{
+					continue;
+				}
+				if ( m_numNarrowphaseTests >= m_maxNarrowphaseTestsPerCall )
+				{
+					return false;
+				}
+				m_numNarrowphaseTests++;
+				isPenetrating = GetPushOutOfBlock( boneStart, testEnd, box, contactPos, pushOut );
+			}
+			else
+			{
+				int			triVertIndex	= ( itemIndex - numBlocks ) * 3;
+				Vec3 const& vert0			= sceneIndex.m_terrainTriVertList[ triVertIndex + 0 ];
+				Vec3 const& vert1			= sceneIndex.m_terrainTriVertList[ triVertIndex + 1 ];
+				Vec3 const& vert2			= sceneIndex.m_terrainTriVertList[ triVertIndex + 2 ];
+				float		triMaxZ			= ( vert0.z > vert1.z ) ? vert0.z : vert1.z;
+				triMaxZ						= ( vert2.z > triMaxZ ) ? vert2.z : triMaxZ;
+				if ( capsuleMinZ > triMaxZ )
+				{
+					continue;
+				}
+				if ( m_numNarrowphaseTests >= m_maxNarrowphaseTestsPerCall )
+				{
+					return false;
+				}
+				m_numNarrowphaseTests++;
+				isPenetrating = GetPushOutOfTriangle( boneStart, testEnd, vert0, vert1, vert2, contactPos, pushOut );
+			}
+
+			if ( !isPenetrating )
+			{
+				continue;
+			}
+
+			// Rotate the bone about its start; the end moves further than the contact by the lever ratio
+			float testLength	= boneLength - tipTrimLength;
+			float leverFraction = DotProduct3D( contactPos - boneStart, testEnd - boneStart ) / ( testLength * testLength );
+			if ( leverFraction < m_minLeverFraction )
+			{
+				continue;
+			}
+			Vec3 pushedTestEnd	= testEnd + ( pushOut / leverFraction );
+			Vec3 boneDir		= ( pushedTestEnd - boneStart ).GetNormalized();
+			testEnd				= boneStart + ( boneDir * testLength );
+			boneEnd				= boneStart + ( boneDir * boneLength );
+			didPush				= true;
+			m_numPushes++;
+
+			Vec2 pushedEndMins	= Vec2( testEnd.x - m_limbRadius, testEnd.y - m_limbRadius );
+			Vec2 pushedEndMaxs	= Vec2( testEnd.x + m_limbRadius, testEnd.y + m_limbRadius );
+			if ( pushedEndMins.x < bounds.m_mins.x || pushedEndMins.y < bounds.m_mins.y ||
+				 pushedEndMaxs.x > bounds.m_maxs.x || pushedEndMaxs.y > bounds.m_maxs.y )
+			{
+				bounds.StretchToIncludePoint( pushedEndMins );
+				bounds.StretchToIncludePoint( pushedEndMaxs );
+				sceneIndex.m_staticGrid.GetItemsOverlappingBounds( bounds, m_candidateList );
+				break;
+			}
+		}
+
+		if ( !didPush )
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LimbCollisionSolver::GetPushOutOfBlock( Vec3 const& boneStart, Vec3 const& boneEnd, AABB3 const& box, Vec3& out_contactPos, Vec3& out_pushOut ) const
+{
+	// Closest points between bone and box, by projecting back and forth (converges since both are convex)
+	Vec3 pointOnBone	= GetNearestPointOnLineSegment3D( box.GetCenter(), boneStart, boneEnd );
+	Vec3 pointOnBox		= box.GetNearestPoint( pointOnBone );
+	for ( int i = 0; i < 3; i++ )
+	{
+		pointOnBone		= GetNearestPointOnLineSegment3D( pointOnBox, boneStart, boneEnd );
+		pointOnBox		= box.GetNearestPoint( pointOnBone );
+	}
+
+	Vec3  dispBoxToBone	= pointOnBone - pointOnBox;
+	float distSquared	= dispBoxToBone.GetLengthSquared();
+	if ( distSquared >= ( m_limbRadius * m_limbRadius ) )
+	{
+		return false;
+	}
+
+	out_contactPos = pointOnBone;
+	if ( distSquared > 0.0f )
+	{
+		float dist		= sqrtf( distSquared );
+		out_pushOut		= ( dispBoxToBone / dist ) * ( m_limbRadius - dist );
+		return true;
+	}
+
+	// Bone is inside the box, leave through the nearest face
+	float distToFaceList[6] = { pointOnBone.x - box.m_mins.x, box.m_maxs.x - pointOnBone.x,
+								pointOnBone.y - box.m_mins.y, box.m_maxs.y - pointOnBone.y,
+								pointOnBone.z - box.m_mins.z, box.m_maxs.z - pointOnBone.z };
+	Vec3  faceNormalList[6] = { Vec3( -1.0f,  0.0f,  0.0f ), Vec3( 1.0f, 0.0f, 0.0f ),
+								Vec3(  0.0f, -1.0f,  0.0f ), Vec3( 0.0f, 1.0f, 0.0f ),
+								Vec3(  0.0f,  0.0f, -1.0f ), Vec3( 0.0f, 0.0f, 1.0f ) };
+	int nearestFaceIndex = 0;
+	for ( int faceIndex = 1; faceIndex < 6; faceIndex++ )
+	{
+		if ( distToFaceList[ faceIndex ] < distToFaceList[ nearestFaceIndex ] )
+		{
+			nearestFaceIndex = faceIndex;
+		}
+	}
+	out_pushOut = faceNormalList[ nearestFaceIndex ] * ( distToFaceList[ nearestFaceIndex ] + m_limbRadius );
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LimbCollisionSolver::GetPushOutOfTriangle( Vec3 const& boneStart, Vec3 const& boneEnd, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2, Vec3& out_contactPos, Vec3& out_pushOut ) const
+{
+	// Terrain faces up regardless of winding
+	Vec3 triNormal = CrossProduct3D( vert1 - vert0, vert2 - vert0 ).GetNormalized();
+	if ( triNormal.z < 0.0f )
+	{
+		triNormal = -1.0f * triNormal;
+	}
+
+	// Closest points between bone and triangle
+	Vec3 centroid		= ( vert0 + vert1 + vert2 ) / 3.0f;
+	Vec3 pointOnBone	= GetNearestPointOnLineSegment3D( centroid, boneStart, boneEnd );
+	Vec3 pointOnTri		= GetNearestPointOnTriangle3D( pointOnBone, vert0, vert1, vert2 );
+	for ( int i = 0; i < 3; i++ )
+	{
+		pointOnBone		= GetNearestPointOnLineSegment3D( pointOnTri, boneStart, boneEnd );
+		pointOnTri		= GetNearestPointOnTriangle3D( pointOnBone, vert0, vert1, vert2 );
+	}
+
+	// A bone crossing the surface converges on the crossing point; the endpoint below the surface is the deeper contact
+	float contactHeight = DotProduct3D( pointOnBone - vert0, triNormal );
+	Vec3  endpointList[2] = { boneStart, boneEnd };
+	for ( int i = 0; i < 2; i++ )
+	{
+		float endpointHeight = DotProduct3D( endpointList[i] - vert0, triNormal );
+		Vec3  endpointOnTri	 = GetNearestPointOnTriangle3D( endpointList[i], vert0, vert1, vert2 );
+		bool  isOverFace	 = GetDistanceSquared3D( endpointOnTri, endpointList[i] - ( triNormal * endpointHeight ) ) < 0.0001f;
+		if ( isOverFace && endpointHeight < contactHeight )
+		{
+			pointOnBone		= endpointList[i];
+			pointOnTri		= endpointOnTri;
+			contactHeight	= endpointHeight;
+		}
+	}
+	if ( contactHeight >= m_limbRadius )
+	{
+		return false;
+	}
+
+	// Terrain is a continuous surface, so contacts past this triangle's edges belong to its neighbours
+	Vec3 planePos		= pointOnBone - ( triNormal * contactHeight );
+	bool isOverFace		= GetDistanceSquared3D( pointOnTri, planePos ) < 0.0001f;
+	if ( !isOverFace )
+	{
+		return false;
+	}
+	out_contactPos	= pointOnBone;
+	out_pushOut		= triNormal * ( m_limbRadius - contactHeight );
+	return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/AABB3.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class IK_Chain3D;
+class SceneSpatialIndex;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Post-IK pass that keeps limbs out of blocks and terrain. Each FABRIK joint segment (m_jointPos_LS to m_endPos) is
+// treated as a capsule; a penetrating capsule is rotated about its start until the contact clears by m_limbRadius,
+// and the rest of the chain is carried along with it.
+// Narrowphase tests are capped per call. Chains that miss out on a frame are first in line on the next one.
+//----------------------------------------------------------------------------------------------------------------------
+class LimbCollisionSolver
+{
+public:
+	LimbCollisionSolver();
+	~LimbCollisionSolver();
+
+	void SolveChains( std::vector<IK_Chain3D*> const& chainList, SceneSpatialIndex const& sceneIndex );
+
+private:
+	bool SolveChain( IK_Chain3D* chain, SceneSpatialIndex const& sceneIndex );
+	bool ResolveCapsule( Vec3 const& boneStart, Vec3& boneEnd, float boneLength, float tipTrimLength, SceneSpatialIndex const& sceneIndex );
+	bool GetPushOutOfBlock(	   Vec3 const& boneStart, Vec3 const& boneEnd, AABB3 const& box, Vec3& out_contactPos, Vec3& out_pushOut ) const;
+	bool GetPushOutOfTriangle( Vec3 const& boneStart, Vec3 const& boneEnd, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2, Vec3& out_contactPos, Vec3& out_pushOut ) const;
+
+public:
+	float				m_limbRadius					= 1.0f;			// Matches the rendered joint spheres
+	float				m_minLeverFraction				= 0.2f;			// Contacts closer to the joint than this are left to the parent segment
+	int					m_maxIterationsPerCapsule		= 4;
+	int					m_maxNarrowphaseTestsPerCall	= 256;
+	int					m_firstChainIndex				= 0;
+
+	// Stats from the last call
+	int					m_numNarrowphaseTests			= 0;
+	int					m_numPushes						= 0;
+
+	std::vector<int>	m_candidateList;
+};
@@ -10,16 +10,17 @@ extern App* g_theApp;
 int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR commandLineString, int )
 {
 	UNUSED(applicationInstanceHandle);
-	UNUSED(commandLineString);
 
 	g_theApp = new App();
+	g_theApp->ParseCommandLine( commandLineString );
 	g_theApp->Startup();
 	g_theApp->Run();
 	g_theApp->Shutdown();
+	int exitCode = g_theApp->GetExitCode();
 	delete g_theApp;
 	g_theApp = nullptr;
 
-	return 0;
+	return exitCode;
 }
 
 
@@ -4,6 +4,7 @@
 #include "Game/GameCommon.hpp"
 #include "Game/FoodManager.hpp"
 
+#include "Engine/Core/AllocTracker.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 
 
@@ -25,10 +26,14 @@ Map_GameMode3D::Map_GameMode3D( GameMode3D* game )
 		float rand					= g_theRNG->RollRandomFloatInRange( m_minFloorHeight, m_maxFloorHeight );
 		height						+= rand;
 	}
-	m_vbo = g_theRenderer->CreateVertexBuffer( m_planeVerts.size(), sizeof(Vertex_PCU) );
-	m_ibo = g_theRenderer->CreateIndexBuffer (  m_indexList.size() );
-	g_theRenderer->Copy_CPU_To_GPU( m_planeVerts.data(), sizeof( Vertex_PCU )   * m_planeVerts.size(), m_vbo, sizeof( Vertex_PCU ) );
-	g_theRenderer->Copy_CPU_To_GPU(  m_indexList.data(), sizeof( unsigned int ) *  m_indexList.size(), m_ibo );
+	// No GPU buffers in headless runs, the CPU verts are all the simulation needs
+	if ( g_theRenderer )
+	{
+		m_vbo = g_theRenderer->CreateVertexBuffer( m_planeVerts.size(), sizeof(Vertex_PCU) );
+		m_ibo = g_theRenderer->CreateIndexBuffer (  m_indexList.size() );
+		g_theRenderer->Copy_CPU_To_GPU( m_planeVerts.data(), sizeof( Vertex_PCU )   * m_planeVerts.size(), m_vbo, sizeof( Vertex_PCU ) );
+		g_theRenderer->Copy_CPU_To_GPU(  m_indexList.data(), sizeof( unsigned int ) *  m_indexList.size(), m_ibo );
+	}
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Initialize food orbs
@@ -64,42 +69,12 @@ void Map_GameMode3D::Update( float deltaSeconds )
 			float rand					= g_theRNG->RollRandomFloatInRange( m_minFloorHeight, m_maxFloorHeight );
 			height						-= rand;
 		}
-		g_theRenderer->Copy_CPU_To_GPU( m_planeVerts.data(), sizeof( Vertex_PCU )   * m_planeVerts.size(), m_vbo, sizeof( Vertex_PCU ) );
-		g_theRenderer->Copy_CPU_To_GPU(  m_indexList.data(), sizeof( unsigned int ) *  m_indexList.size(), m_ibo );
-	}
-
-	//----------------------------------------------------------------------------------------------------------------------
-	// Raycast test logic
-	//----------------------------------------------------------------------------------------------------------------------
-	float rayMaxLength = 100.0f;
-	RaycastResult3D tempRayResult;
-	tempRayResult.m_rayMaxLength			= rayMaxLength;
-	m_game->m_rayVsTri						= tempRayResult;
-	m_game->m_rayVsTri.m_rayStartPosition	= m_game->m_gameMode3DWorldCamera.m_position;
-	m_game->m_rayVsTri.m_rayFwdNormal		= m_game->m_gameMode3DWorldCamera.m_orientation.GetForwardDir_XFwd_YLeft_ZUp();
-
-	float t, u, v = 0.0f;
-	for ( int i = i = 0; i < m_indexList.size(); i += 3 )
-	{
-		int const& currentIndex_A = m_indexList[ i + 0];
-		int const& currentIndex_B = m_indexList[ i + 1];
-		int const& currentIndex_C = m_indexList[ i + 2];
-
-		//  m_vbo->m_buffer[ currentIndex ];
-		Vec3 vert0 = m_planeVerts[ currentIndex_A ].m_position;
-		Vec3 vert1 = m_planeVerts[ currentIndex_B ].m_position;
-		Vec3 vert2 = m_planeVerts[ currentIndex_C ].m_position;
-
-		tempRayResult = RaycastVsTriangle( m_game->m_gameMode3DWorldCamera.m_position, m_game->m_gameMode3DWorldCamera.m_orientation.GetForwardDir_XFwd_YLeft_ZUp(), 
-																	m_game->m_rayVsTri.m_rayMaxLength, vert0, vert1, vert2, t, u, v );
-		if ( tempRayResult.m_didImpact )
+		if ( g_theRenderer )
 		{
-			// If ray hit AND is closer
-			if ( tempRayResult.m_impactDist < m_game->m_rayVsTri.m_impactDist )
-			{
-				m_game->m_rayVsTri = tempRayResult;
-			}
+			g_theRenderer->Copy_CPU_To_GPU( m_planeVerts.data(), sizeof( Vertex_PCU )   * m_planeVerts.size(), m_vbo, sizeof( Vertex_PCU ) );
+			g_theRenderer->Copy_CPU_To_GPU(  m_indexList.data(), sizeof( unsigned int ) *  m_indexList.size(), m_ibo );
 		}
+		m_game->RebuildSpatialIndices();
 	}
 
 	//----------------------------------------------------------------------------------------------------------------------
@@ -112,6 +87,7 @@ void Map_GameMode3D::Update( float deltaSeconds )
 //----------------------------------------------------------------------------------------------------------------------
 void Map_GameMode3D::Render() const
 {
+	ALLOC_TAG( "Render" );
 	std::vector<Vertex_PCU> skyVerts;
 	std::vector<Vertex_PCU> verts;
 	verts.reserve( 441 );
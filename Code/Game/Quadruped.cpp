@@ -5,6 +5,9 @@
 
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/SampleCounters.hpp"
+#include "Engine/Core/Logger.hpp"
 #include "Engine/SkeletalSystem/IK_Chain3D.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 
@@ -88,6 +91,7 @@ void Quadruped::InitLimbs()
 //----------------------------------------------------------------------------------------------------------------------
 void Quadruped::UpdateLimbs( float deltaSeconds )
 {
+	PROFILE_SCOPE( "Quadruped::UpdateLimbs" );
 	//----------------------------------------------------------------------------------------------------------------------
 	// Update Quadruped Hip EndEffector
 	//----------------------------------------------------------------------------------------------------------------------
@@ -120,7 +124,7 @@ void Quadruped::UpdateLimbs( float deltaSeconds )
 	float rightArmDistRoot  = GetDistance3D(   m_leftArm->m_finalJoint->m_endPos, m_root->m_jointPos_LS );
 	float leftFootDistRoot  = GetDistance3D(  m_leftFoot->m_finalJoint->m_endPos, m_spine->m_position_WS );
 	float rightFootDistRoot = GetDistance3D( m_rightFoot->m_finalJoint->m_endPos, m_spine->m_position_WS );
-	DebuggerPrintf( Stringf( "LA: %0.2f, RA: %0.2f,\nLF: %0.2f, RF: %0.2f, MaxLimbLength: %0.2f\n", leftArmDistRoot, rightArmDistRoot,  leftFootDistRoot, rightFootDistRoot, skeletonMaxLength ).c_str() );
+	LOG( LOG_SEVERITY_VERBOSE, LOG_CATEGORY_ANIMATION, "LA: %0.2f, RA: %0.2f, LF: %0.2f, RF: %0.2f, MaxLimbLength: %0.2f", leftArmDistRoot, rightArmDistRoot, leftFootDistRoot, rightFootDistRoot, skeletonMaxLength );
 	//----------------------------------------------------------------------------------------------------------------------			
 	// Arms + Feet
 	//----------------------------------------------------------------------------------------------------------------------
@@ -190,7 +194,7 @@ void Quadruped::UpdateLimbs( float deltaSeconds )
 	goalHeight							+= m_defaultHeightZ;
 
 	// Lerp from currentRootPos to goalPos (Breathing)
-	float currentTime					= float( GetCurrentTimeSeconds() );
+	float currentTime					= g_theApp->m_gameClock.GetTotalSeconds();
 	float sine							= SinDegrees( currentTime * 60.0f );
 	float heightOffset					= 1.0f;
 	float rootGoalHeightZ				= goalHeight + ( heightOffset * sine );
@@ -218,7 +222,7 @@ void Quadruped::MoveIfNeeded( IK_Chain3D*		const  IK_Chain,
 		if ( IK_Chain->TryUnlockAndToggleAnchor( anchorToggleSkeleton ) )
 		{
 			// Determine Best next step
-			SpecifyFootPlacementPos( IK_Chain->m_target.m_goalPos, refSegment, maxDistStartPosToNewPos, fwdStep, leftStep );
+			SpecifyFootPlacementPos( IK_Chain->m_target.m_goalPos, IK_Chain, refSegment, maxDistStartPosToNewPos, fwdStep, leftStep );
 			// Setup and start bezier curve
 			InitStepBezier( bezierCurve, IK_Chain, refSegment->m_upDir, bezierTimer );
 			IK_Chain->UpdateTargetOrientationToRef( refSegment->m_fwdDir, refSegment->m_leftDir, refSegment->m_upDir );
@@ -233,18 +237,18 @@ void Quadruped::MoveIfNeeded( IK_Chain3D*		const  IK_Chain,
 // #ToDo: Rename "MaxLength" to something else that makes more sense
 // Current understanding of "MaxLength" is "maxDistStartPosToNewPos"
 //----------------------------------------------------------------------------------------------------------------------
-void Quadruped::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb, float maxDistStartPosToNewPos, float fwdStepAmount, float leftStepAmount )
+void Quadruped::SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, IK_Joint3D* refLimb, float maxDistStartPosToNewPos, float fwdStepAmount, float leftStepAmount )
 {
 	Vec3 prevTargetPos	= targetPos;
 	// Determine the ideal next step position
 	Vec3 idealNewPos	= ComputeIdealStepPos( refLimb, fwdStepAmount, leftStepAmount );
 
-	bool didRayImpact	= false;
-	didRayImpact		= DoesRaycastHitFloor( idealNewPos );
-	// Raycast against all tri
-	// Choose closest hit (between ABB3 and Triangles)
+	// Walk the nav graph toward the ideal next step, the limb's reach limits how high it can step
+	float maxStepHeight		= m_game->m_walkableNavGraph.GetMaxStepHeightForChain( limbChain );
+	float maxStrideLength	= limbChain->GetMaxLengthOfSkeleton() * 2.0f;		// A stride swings the foot from behind the body to in front of it
+	bool didRayImpact		= false;
+	didRayImpact			= m_game->m_walkableNavGraph.FindNextFootPos( prevTargetPos, idealNewPos, maxStrideLength, maxStepHeight, idealNewPos );
 
-	float distRefPosToOldAlternativePos = 500.0f;
 	// Ensure ideal next step is close enough AND on a walkable block
 //	float distRefPosToIdealPos = GetDistance3D( idealNewPos, refLimb->m_jointPos_LS );
 //	if ( CompareIfFloatsAreEqual( distRefPosToIdealPos, maxLength, 2.0f ) && didRayImpact )
@@ -256,54 +260,14 @@ void Quadruped::SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb, f
 	else
 	{
 		// Since normal "next step" position is invalid, find better footPlacement position
-		/*
-			Get nearest valid footstep algorithm
-			1. Check if this block is walkable
-			2. Check if alternative next step is close enough
-			2a. True: Step
-			2b. False: Keep searching
-			2b1. Stay in the same position if next position was not found
-		*/
-
-		Vec3 nearestPoint3D = Vec3( 0.0f, 0.0f, -1000.0f );
-		for ( int i = 0; i < m_game->m_blockList.size(); i++ )
+		// The search is XY only, so also check it is within maxDistStartPosToNewPos of refLimb in 3D; stay put if not
+		Vec3 nearestWalkablePos = prevTargetPos;
+		bool didFindSurface		= m_game->m_walkableSurfaceIndex.GetNearestWalkablePoint( idealNewPos, maxDistStartPosToNewPos, nearestWalkablePos );
+		if ( !didFindSurface || ( GetDistance3D( nearestWalkablePos, refLimb->m_jointPos_LS ) > maxDistStartPosToNewPos ) )
 		{
-			// Ensure currentBlock is "Walkable"
-			Block* currentBlock = m_game->m_blockList[i];
-			if ( !currentBlock->m_isWalkable )
-			{
-				continue;
-			}
-
-			// Get nearestPoint
-			Vec3 alternativeNewPos	= currentBlock->m_aabb3.GetNearestPoint( idealNewPos );
-			alternativeNewPos.z		= currentBlock->m_aabb3.m_maxs.z;
-
-			// Determine the closest position as valid 
-			float distRootToNewAlternativePos = GetDistance3D( alternativeNewPos, refLimb->m_jointPos_LS );
-			if ( distRootToNewAlternativePos <= maxDistStartPosToNewPos )
-			{
-				nearestPoint3D					= alternativeNewPos;
-				distRefPosToOldAlternativePos	= distRootToNewAlternativePos;
-			}
-			else
-			{
-				// Keep track of the closest position to creature
-				if ( distRootToNewAlternativePos <= distRefPosToOldAlternativePos )
-				{
-					nearestPoint3D				  = alternativeNewPos;
-					distRefPosToOldAlternativePos = distRootToNewAlternativePos;
-				}
-			}
+			nearestWalkablePos	= prevTargetPos;
 		}
-
-		if ( nearestPoint3D == Vec3( 0.0f, 0.0f, -1000.0f ) )
-		{
-			nearestPoint3D = prevTargetPos;
-		}
-
-		// Set targetPos to nearestPoint
-		targetPos = nearestPoint3D;
+		targetPos = nearestWalkablePos;
 	}
 }
 
@@ -465,6 +429,7 @@ void Quadruped::InitStepBezier( CubicBezierCurve3D& bezierCurve, IK_Chain3D* con
 	bezierCurve.m_endPos	= end;
 	// Start bezierTimer;
 	bezierTimer.Start();
+	COUNTER_ADD( "Bezier steps started", 1 );
 }
 
 
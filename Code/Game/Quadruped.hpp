@@ -34,7 +34,7 @@ public:
 						float maxDistFromRef, float maxLength, float fwdStep, float leftStep, 
 						CubicBezierCurve3D& bezierCurve, Stopwatch& bezierTimer );
 
-	void SpecifyFootPlacementPos( Vec3& targetPos, IK_Joint3D* refLimb, float maxLength, float fwdStepAmount, float leftStepAmount );
+	void SpecifyFootPlacementPos( Vec3& targetPos, IK_Chain3D* limbChain, IK_Joint3D* refLimb, float maxLength, float fwdStepAmount, float leftStepAmount );
 	Vec3 ComputeIdealStepPos( IK_Joint3D const* refLimb, float fwdStepAmound, float leftStepAmount );
 	bool DoesRaycastHitFloor( Vec3& refPosition );
 	bool DoesRaycastHitFloor( RaycastResult3D& raycastResult, Vec3 rayStartPos, Vec3& rayfwdNormal, float rayLength );
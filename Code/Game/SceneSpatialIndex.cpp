@@ -0,0 +1,374 @@
+#include "Game/SceneSpatialIndex.hpp"
+#include "Game/GameMode3D.hpp"
+
+#include "Engine/SkeletalSystem/IK_Chain3D.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/SampleCounters.hpp"
+
+#include <float.h>
+#include <math.h>
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sweeps run on workers as well as the main thread, so each thread reuses its own candidate list instead of
+// allocating one per query
+static thread_local std::vector<int>	t_sweepCandidateList;
+
+
+//----------------------------------------------------------------------------------------------------------------------
+SceneSpatialIndex::SceneSpatialIndex()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+SceneSpatialIndex::~SceneSpatialIndex()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SceneSpatialIndex::RebuildStatic( std::vector<Block*> const& blockList, std::vector<Vertex_PCU> const& terrainVerts, std::vector<unsigned int> const& terrainIndexList )
+{
+	m_blockList.clear();
+	m_terrainTriVertList.clear();
+
+	std::vector<AABB2> itemBoundsList;
+	itemBoundsList.reserve( blockList.size() + ( terrainIndexList.size() / 3 ) );
+
+	// Blocks (XY footprint only, so vertical motion does not need a rebuild)
+	for ( int i = 0; i < blockList.size(); i++ )
+	{
+		AABB3 const& box = blockList[i]->m_aabb3;
+		m_blockList.push_back( blockList[i] );
+		itemBoundsList.push_back( AABB2( box.m_mins.x, box.m_mins.y, box.m_maxs.x, box.m_maxs.y ) );
+	}
+
+	// Terrain triangles
+	m_terrainTriVertList.reserve( terrainIndexList.size() );
+	for ( int i = 0; i + 2 < terrainIndexList.size(); i += 3 )
+	{
+		Vec3 const& vert0 = terrainVerts[ terrainIndexList[ i + 0 ] ].m_position;
+		Vec3 const& vert1 = terrainVerts[ terrainIndexList[ i + 1 ] ].m_position;
+		Vec3 const& vert2 = terrainVerts[ terrainIndexList[ i + 2 ] ].m_position;
+		m_terrainTriVertList.push_back( vert0 );
+		m_terrainTriVertList.push_back( vert1 );
+		m_terrainTriVertList.push_back( vert2 );
+
+		AABB2 triBounds = AABB2( Vec2( vert0.x, vert0.y ), Vec2( vert0.x, vert0.y ) );
+		triBounds.StretchToIncludePoint( Vec2( vert1.x, vert1.y ) );
+		triBounds.StretchToIncludePoint( Vec2( vert2.x, vert2.y ) );
+		itemBoundsList.push_back( triBounds );
+	}
+
+	m_staticGrid.Build( itemBoundsList, m_cellSize );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SceneSpatialIndex::ClearLimbCapsules()
+{
+	m_limbCapsuleList.clear();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SceneSpatialIndex::AddLimbCapsules( std::vector<IK_Chain3D*> const& chainList, float limbRadius )
+{
+	for ( int chainIndex = 0; chainIndex < chainList.size(); chainIndex++ )
+	{
+		IK_Chain3D const* currentChain = chainList[ chainIndex ];
+		for ( int jointIndex = 0; jointIndex < currentChain->m_jointList.size(); jointIndex++ )
+		{
+			IK_Joint3D* currentJoint = currentChain->m_jointList[ jointIndex ];
+			LimbCapsule capsule;
+			capsule.m_boneStart	= currentJoint->m_jointPos_LS;
+			capsule.m_boneEnd	= currentJoint->m_endPos;
+			capsule.m_radius	= limbRadius;
+			capsule.m_joint		= currentJoint;
+			m_limbCapsuleList.push_back( capsule );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+SceneRaycastResult SceneSpatialIndex::Raycast( Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, unsigned int queryMask ) const
+{
+	PROFILE_SCOPE( "SceneSpatialIndex::Raycast" );
+	COUNTER_ADD( "Raycasts", 1 );
+	SceneRaycastResult bestResult;
+	bestResult.m_rayResult.m_rayStartPosition	= rayStart;
+	bestResult.m_rayResult.m_rayFwdNormal		= rayFwdNormal;
+	bestResult.m_rayResult.m_rayMaxLength		= rayMaxLength;
+
+	if ( queryMask & SCENE_QUERY_LIMBS )
+	{
+		RaycastVsLimbs( rayStart, rayFwdNormal, rayMaxLength, bestResult );
+	}
+
+	if ( ( queryMask & ( SCENE_QUERY_TERRAIN | SCENE_QUERY_BLOCKS ) ) == 0 || m_staticGrid.IsEmpty() )
+	{
+		return bestResult;
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Clip the ray against the grid's XY bounds
+	//----------------------------------------------------------------------------------------------------------------------
+	AABB2 gridBounds	= m_staticGrid.GetGridBounds();
+	float rayStartXY[2]	= { rayStart.x, rayStart.y };
+	float rayFwdXY[2]	= { rayFwdNormal.x, rayFwdNormal.y };
+	float gridMins[2]	= { gridBounds.m_mins.x, gridBounds.m_mins.y };
+	float gridMaxs[2]	= { gridBounds.m_maxs.x, gridBounds.m_maxs.y };
+	float tEnter		= 0.0f;
+	float tExit			= rayMaxLength;
+	for ( int axis = 0; axis < 2; axis++ )
+	{
+		if ( rayFwdXY[axis] == 0.0f )
+		{
+			if ( rayStartXY[axis] < gridMins[axis] || rayStartXY[axis] > gridMaxs[axis] )
+			{
+				return bestResult;
+			}
+			continue;
+		}
+		float tMin = ( gridMins[axis] - rayStartXY[axis] ) / rayFwdXY[axis];
+		float tMax = ( gridMaxs[axis] - rayStartXY[axis] ) / rayFwdXY[axis];
+		if ( tMin > tMax )
+		{
+			SwapValueOfTwoVariables( tMin, tMax );
+		}
+		tEnter	= ( tMin > tEnter ) ? tMin : tEnter;
+		tExit	= ( tMax < tExit  ) ? tMax : tExit;
+	}
+	if ( tEnter > tExit )
+	{
+		return bestResult;
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Walk the cells the ray crosses in XY (Amanatides & Woo), nearest first
+	//----------------------------------------------------------------------------------------------------------------------
+	float	cellSize		= m_staticGrid.GetCellSize();
+	IntVec2	gridDimensions	= m_staticGrid.GetGridDimensions();
+	Vec2	entryPosXY		= Vec2( rayStart.x + ( rayFwdNormal.x * tEnter ), rayStart.y + ( rayFwdNormal.y * tEnter ) );
+	IntVec2	cellCoords		= m_staticGrid.GetCellCoordsForPoint( entryPosXY );
+	int		cell[2]			= { cellCoords.x, cellCoords.y };
+	int		step[2]			= { 0, 0 };
+	float	tNextBoundary[2]= { FLT_MAX, FLT_MAX };
+	float	tDelta[2]		= { FLT_MAX, FLT_MAX };
+	int		gridSize[2]		= { gridDimensions.x, gridDimensions.y };
+	for ( int axis = 0; axis < 2; axis++ )
+	{
+		// Entry point can land a hair outside due to float error
+		cell[axis] = ( cell[axis] < 0 ) ? 0 : cell[axis];
+		cell[axis] = ( cell[axis] >= gridSize[axis] ) ? ( gridSize[axis] - 1 ) : cell[axis];
+		if ( rayFwdXY[axis] == 0.0f )
+		{
+			continue;
+		}
+		step[axis]			= ( rayFwdXY[axis] > 0.0f ) ? 1 : -1;
+		float boundary		= gridMins[axis] + ( float( cell[axis] + ( step[axis] > 0 ? 1 : 0 ) ) * cellSize );
+		tNextBoundary[axis]	= ( boundary - rayStartXY[axis] ) / rayFwdXY[axis];
+		tDelta[axis]		= cellSize / fabsf( rayFwdXY[axis] );
+	}
+
+	int numBlocksTested		= 0;
+	int numTrianglesTested	= 0;
+	while ( true )
+	{
+		RaycastVsStaticCell( IntVec2( cell[0], cell[1] ), rayStart, rayFwdNormal, rayMaxLength, queryMask, bestResult, numBlocksTested, numTrianglesTested );
+
+		// Anything hit before leaving this cell cannot be beaten by later cells
+		float tCellExit = ( tNextBoundary[0] < tNextBoundary[1] ) ? tNextBoundary[0] : tNextBoundary[1];
+		if ( bestResult.m_rayResult.m_didImpact && bestResult.m_rayResult.m_impactDist <= tCellExit )
+		{
+			break;
+		}
+		if ( tCellExit > tExit )
+		{
+			break;
+		}
+
+		int axis			 = ( tNextBoundary[0] < tNextBoundary[1] ) ? 0 : 1;
+		cell[axis]			+= step[axis];
+		tNextBoundary[axis]	+= tDelta[axis];
+		if ( cell[axis] < 0 || cell[axis] >= gridSize[axis] )
+		{
+			break;
+		}
+	}
+	COUNTER_ADD( "Blocks tested", numBlocksTested );
+	COUNTER_ADD( "Triangles tested", numTrianglesTested );
+	return bestResult;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+SceneRaycastResult SceneSpatialIndex::SweepCapsule( Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist, unsigned int queryMask, bool ignoreStartOverlaps ) const
+{
+	PROFILE_SCOPE( "SceneSpatialIndex::SweepCapsule" );
+	COUNTER_ADD( "Capsule sweeps", 1 );
+	SceneRaycastResult bestResult;
+	bestResult.m_rayResult.m_rayStartPosition	= boneStart;
+	bestResult.m_rayResult.m_rayFwdNormal		= sweepFwdNormal;
+	bestResult.m_rayResult.m_rayMaxLength		= sweepMaxDist;
+	if ( ( queryMask & ( SCENE_QUERY_TERRAIN | SCENE_QUERY_BLOCKS ) ) == 0 || m_staticGrid.IsEmpty() )
+	{
+		return bestResult;
+	}
+
+	// Bounds of the capsule at both ends of the sweep
+	Vec3 sweepDisp	= sweepFwdNormal * sweepMaxDist;
+	Vec3 sweptMins	= boneStart;
+	Vec3 sweptMaxs	= boneStart;
+	Vec3 pointList[4] = { boneStart, boneEnd, boneStart + sweepDisp, boneEnd + sweepDisp };
+	for ( int i = 1; i < 4; i++ )
+	{
+		sweptMins.x = ( pointList[i].x < sweptMins.x ) ? pointList[i].x : sweptMins.x;
+		sweptMins.y = ( pointList[i].y < sweptMins.y ) ? pointList[i].y : sweptMins.y;
+		sweptMins.z = ( pointList[i].z < sweptMins.z ) ? pointList[i].z : sweptMins.z;
+		sweptMaxs.x = ( pointList[i].x > sweptMaxs.x ) ? pointList[i].x : sweptMaxs.x;
+		sweptMaxs.y = ( pointList[i].y > sweptMaxs.y ) ? pointList[i].y : sweptMaxs.y;
+		sweptMaxs.z = ( pointList[i].z > sweptMaxs.z ) ? pointList[i].z : sweptMaxs.z;
+	}
+	sweptMins -= Vec3( radius, radius, radius );
+	sweptMaxs += Vec3( radius, radius, radius );
+
+	std::vector<int>& candidateList = t_sweepCandidateList;
+	m_staticGrid.GetItemsOverlappingBounds( AABB2( sweptMins.x, sweptMins.y, sweptMaxs.x, sweptMaxs.y ), candidateList );
+	int numBlocks			= int( m_blockList.size() );
+	int numBlocksTested		= 0;
+	int numTrianglesTested	= 0;
+	for ( int i = 0; i < candidateList.size(); i++ )
+	{
+		int				itemIndex = candidateList[i];
+		RaycastResult3D	sweepResult;
+		if ( itemIndex < numBlocks )
+		{
+			if ( ( queryMask & SCENE_QUERY_BLOCKS ) == 0 )
+			{
+				continue;
+			}
+			AABB3 const& box = m_blockList[ itemIndex ]->m_aabb3;
+			if ( box.m_maxs.z < sweptMins.z || box.m_mins.z > sweptMaxs.z )
+			{
+				continue;
+			}
+			sweepResult = SweepCapsuleVsAABB3D( boneStart, boneEnd, radius, sweepFwdNormal, sweepMaxDist, box );
+			numBlocksTested++;
+		}
+		else
+		{
+			if ( ( queryMask & SCENE_QUERY_TERRAIN ) == 0 )
+			{
+				continue;
+			}
+			int			triVertIndex	= ( itemIndex - numBlocks ) * 3;
+			Vec3 const& vert0			= m_terrainTriVertList[ triVertIndex + 0 ];
+			Vec3 const& vert1			= m_terrainTriVertList[ triVertIndex + 1 ];
+			Vec3 const& vert2			= m_terrainTriVertList[ triVertIndex + 2 ];
+			float		triMinZ			= ( vert0.z < vert1.z ) ? vert0.z : vert1.z;
+			float		triMaxZ			= ( vert0.z > vert1.z ) ? vert0.z : vert1.z;
+			triMinZ						= ( vert2.z < triMinZ ) ? vert2.z : triMinZ;
+			triMaxZ						= ( vert2.z > triMaxZ ) ? vert2.z : triMaxZ;
+			if ( triMaxZ < sweptMins.z || triMinZ > sweptMaxs.z )
+			{
+				continue;
+			}
+			sweepResult = SweepCapsuleVsTriangle3D( boneStart, boneEnd, radius, sweepFwdNormal, sweepMaxDist, vert0, vert1, vert2 );
+			numTrianglesTested++;
+		}
+
+		if ( !sweepResult.m_didImpact )
+		{
+			continue;
+		}
+		// A starting overlap only stops motion going further in; moving out (or along) it is left alone
+		if ( ignoreStartOverlaps && ( sweepResult.m_impactDist <= 0.0f ) && ( DotProduct3D( sweepFwdNormal, sweepResult.m_impactNormal ) >= 0.0f ) )
+		{
+			continue;
+		}
+		if ( sweepResult.m_impactDist < bestResult.m_rayResult.m_impactDist )
+		{
+			bestResult.m_rayResult		= sweepResult;
+			bestResult.m_colliderType	= ( itemIndex < numBlocks ) ? SCENE_COLLIDER_BLOCK : SCENE_COLLIDER_TERRAIN;
+			bestResult.m_colliderIndex	= ( itemIndex < numBlocks ) ? itemIndex : ( itemIndex - numBlocks );
+		}
+	}
+	COUNTER_ADD( "Blocks tested", numBlocksTested );
+	COUNTER_ADD( "Triangles tested", numTrianglesTested );
+	return bestResult;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SceneSpatialIndex::RaycastVsStaticCell( IntVec2 const& cellCoords, Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, unsigned int queryMask, SceneRaycastResult& bestResult, int& numBlocksTested, int& numTrianglesTested ) const
+{
+	// Tested counts are added to the caller's totals, Raycast reports them once per query
+	int			numItems			= m_staticGrid.GetNumItemsInCell( cellCoords );
+	int const*	itemList			= m_staticGrid.GetItemsInCell( cellCoords );
+	int			numBlocks			= int( m_blockList.size() );
+	for ( int i = 0; i < numItems; i++ )
+	{
+		int				itemIndex = itemList[i];
+		RaycastResult3D	rayResult;
+		if ( itemIndex < numBlocks )
+		{
+			if ( ( queryMask & SCENE_QUERY_BLOCKS ) == 0 )
+			{
+				continue;
+			}
+			rayResult = RaycastVsAABB3D( rayStart, rayFwdNormal, rayMaxLength, m_blockList[ itemIndex ]->m_aabb3 );
+			numBlocksTested++;
+		}
+		else
+		{
+			if ( ( queryMask & SCENE_QUERY_TERRAIN ) == 0 )
+			{
+				continue;
+			}
+			int		triVertIndex	= ( itemIndex - numBlocks ) * 3;
+			float	t				= 0.0f;
+			float	u				= 0.0f;
+			float	v				= 0.0f;
+			rayResult = RaycastVsTriangle( rayStart, rayFwdNormal, rayMaxLength, m_terrainTriVertList[ triVertIndex + 0 ],
+										   m_terrainTriVertList[ triVertIndex + 1 ], m_terrainTriVertList[ triVertIndex + 2 ], t, u, v );
+			numTrianglesTested++;
+			// RaycastVsTriangle also reports triangles behind the ray start
+			if ( t < 0.0f )
+			{
+				continue;
+			}
+		}
+
+		if ( !rayResult.m_didImpact || rayResult.m_impactDist > rayMaxLength )
+		{
+			continue;
+		}
+		if ( rayResult.m_impactDist < bestResult.m_rayResult.m_impactDist )
+		{
+			bestResult.m_rayResult		= rayResult;
+			bestResult.m_colliderType	= ( itemIndex < numBlocks ) ? SCENE_COLLIDER_BLOCK : SCENE_COLLIDER_TERRAIN;
+			bestResult.m_colliderIndex	= ( itemIndex < numBlocks ) ? itemIndex : ( itemIndex - numBlocks );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SceneSpatialIndex::RaycastVsLimbs( Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, SceneRaycastResult& bestResult ) const
+{
+	for ( int i = 0; i < m_limbCapsuleList.size(); i++ )
+	{
+		LimbCapsule const& capsule	= m_limbCapsuleList[i];
+		RaycastResult3D rayResult	= RaycastVsCapsule3D( rayStart, rayFwdNormal, rayMaxLength, capsule.m_boneStart, capsule.m_boneEnd, capsule.m_radius );
+		if ( rayResult.m_didImpact && rayResult.m_impactDist < bestResult.m_rayResult.m_impactDist )
+		{
+			bestResult.m_rayResult		= rayResult;
+			bestResult.m_colliderType	= SCENE_COLLIDER_LIMB;
+			bestResult.m_colliderIndex	= i;
+		}
+	}
+}
+
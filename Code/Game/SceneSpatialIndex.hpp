@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/UniformGrid2D.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+struct Block;
+class IK_Joint3D;
+class IK_Chain3D;
+
+//----------------------------------------------------------------------------------------------------------------------
+enum SceneColliderType
+{
+	SCENE_COLLIDER_NONE = -1,
+	SCENE_COLLIDER_TERRAIN,
+	SCENE_COLLIDER_BLOCK,
+	SCENE_COLLIDER_LIMB,
+	SCENE_COLLIDER_NUM,
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr unsigned int SCENE_QUERY_TERRAIN	= 1 << SCENE_COLLIDER_TERRAIN;
+constexpr unsigned int SCENE_QUERY_BLOCKS	= 1 << SCENE_COLLIDER_BLOCK;
+constexpr unsigned int SCENE_QUERY_LIMBS	= 1 << SCENE_COLLIDER_LIMB;
+constexpr unsigned int SCENE_QUERY_ALL		= SCENE_QUERY_TERRAIN | SCENE_QUERY_BLOCKS | SCENE_QUERY_LIMBS;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct SceneRaycastResult
+{
+	RaycastResult3D		m_rayResult;
+	SceneColliderType	m_colliderType		= SCENE_COLLIDER_NONE;
+	int					m_colliderIndex		= -1;			// Index into the block list, terrain triangle list or limb capsule list
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct LimbCapsule
+{
+	Vec3				m_boneStart			= Vec3::ZERO;
+	Vec3				m_boneEnd			= Vec3::ZERO;
+	float				m_radius			= 1.0f;
+	IK_Joint3D*			m_joint				= nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Scene broadphase. Blocks and terrain triangles are static and bucketed in an XY grid which rays walk cell by cell;
+// limb capsules are dynamic, refreshed once per frame and tested directly (there are only a few dozen).
+// Sweeps are short (one frame of motion), so they gather the cells under the swept bounds instead of walking them.
+// Queries are const and may run on worker threads, as long as nothing is rebuilt or refreshed meanwhile.
+//----------------------------------------------------------------------------------------------------------------------
+class SceneSpatialIndex
+{
+public:
+	SceneSpatialIndex();
+	~SceneSpatialIndex();
+
+	void RebuildStatic( std::vector<Block*> const& blockList, std::vector<Vertex_PCU> const& terrainVerts, std::vector<unsigned int> const& terrainIndexList );
+	void ClearLimbCapsules();
+	void AddLimbCapsules( std::vector<IK_Chain3D*> const& chainList, float limbRadius );
+
+	SceneRaycastResult Raycast( Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, unsigned int queryMask = SCENE_QUERY_ALL ) const;
+
+	// Sweeps a capsule (boneStart == boneEnd for a sphere) against blocks and terrain; limbs are not swept against.
+	// With ignoreStartOverlaps, anything the capsule already touches is skipped when the sweep moves out of (or along)
+	// it, so it can walk free; sweeping further in still reports the overlap at distance 0.
+	SceneRaycastResult SweepCapsule( Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist,
+									 unsigned int queryMask = SCENE_QUERY_TERRAIN | SCENE_QUERY_BLOCKS, bool ignoreStartOverlaps = false ) const;
+
+private:
+	void RaycastVsStaticCell( IntVec2 const& cellCoords, Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, unsigned int queryMask, SceneRaycastResult& bestResult, int& numBlocksTested, int& numTrianglesTested ) const;
+	void RaycastVsLimbs( Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxLength, SceneRaycastResult& bestResult ) const;
+
+public:
+	float						m_cellSize			= 20.0f;
+	std::vector<Block const*>	m_blockList;						// Static items [0, numBlocks) in the grid
+	std::vector<Vec3>			m_terrainTriVertList;				// Static items [numBlocks, ...), three verts per triangle
+	std::vector<LimbCapsule>	m_limbCapsuleList;
+	UniformGrid2D				m_staticGrid;
+};
@@ -0,0 +1,552 @@
+#include "Game/WalkableNavGraph.hpp"
+#include "Game/WalkableSurfaceIndex.hpp"
+#include "Game/SceneSpatialIndex.hpp"
+#include "Game/GameMode3D.hpp"
+
+#include "Engine/SkeletalSystem/IK_Chain3D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+
+//----------------------------------------------------------------------------------------------------------------------
+static IntVec2 const s_neighborOffsets[ NAV_NUM_NEIGHBORS ] =
+{
+	IntVec2(  1,  0 ), IntVec2(  1,  1 ), IntVec2(  0,  1 ), IntVec2( -1,  1 ),
+	IntVec2( -1,  0 ), IntVec2( -1, -1 ), IntVec2(  0, -1 ), IntVec2(  1, -1 ),
+};
+
+
+//----------------------------------------------------------------------------------------------------------------------
+WalkableNavGraph::WalkableNavGraph()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+WalkableNavGraph::~WalkableNavGraph()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::Rebuild( WalkableSurfaceIndex const& walkableIndex, SceneSpatialIndex const& sceneIndex, float maxStepHeight )
+{
+	Clear();
+	if ( walkableIndex.m_grid.IsEmpty() )
+	{
+		return;
+	}
+
+	m_walkableIndex		= &walkableIndex;
+	m_maxStepHeight		= maxStepHeight;
+
+	// Lattice covers the walkable index bounds, with a point on both edges
+	AABB2 bounds		= walkableIndex.m_grid.GetGridBounds();
+	Vec2  boundsSize	= bounds.m_maxs - bounds.m_mins;
+	m_latticeOrigin		= bounds.m_mins;
+	m_latticeDimensions	= IntVec2( int( ceilf( boundsSize.x / m_nodeSpacing ) ) + 1, int( ceilf( boundsSize.y / m_nodeSpacing ) ) + 1 );
+
+	int numColumns		= m_latticeDimensions.x * m_latticeDimensions.y;
+	int numNodes		= numColumns * NAV_MAX_LAYERS_PER_COLUMN;
+	m_columnNumLayersList.resize( numColumns, 0 );
+	m_nodeList.resize( numNodes );
+	m_visitedStampList.resize( numNodes, 0 );
+	m_closedStampList.resize( numNodes, 0 );
+	m_gScoreList.resize( numNodes, 0.0f );
+	m_parentList.resize( numNodes, -1 );
+	m_searchStamp		= 0;
+
+	RebuildRegion( AABB2( bounds.m_mins, bounds.m_maxs ), sceneIndex );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::RebuildRegion( AABB2 const& dirtyBoundsXY, SceneSpatialIndex const& sceneIndex )
+{
+	if ( IsEmpty() )
+	{
+		return;
+	}
+
+	// Columns under the dirty bounds get new nodes; edges also need redoing one column further out,
+	// since the neighbours' edges point into the rebuilt columns
+	IntVec2 minCoords = GetClampedColumnCoords( GetColumnCoordsForPoint( dirtyBoundsXY.m_mins ) );
+	IntVec2 maxCoords = GetClampedColumnCoords( GetColumnCoordsForPoint( dirtyBoundsXY.m_maxs ) + IntVec2( 1, 1 ) );
+	for ( int y = minCoords.y; y <= maxCoords.y; y++ )
+	{
+		for ( int x = minCoords.x; x <= maxCoords.x; x++ )
+		{
+			BuildColumn( IntVec2( x, y ), sceneIndex );
+		}
+	}
+
+	IntVec2 minEdgeCoords = GetClampedColumnCoords( minCoords - IntVec2( 1, 1 ) );
+	IntVec2 maxEdgeCoords = GetClampedColumnCoords( maxCoords + IntVec2( 1, 1 ) );
+	for ( int y = minEdgeCoords.y; y <= maxEdgeCoords.y; y++ )
+	{
+		for ( int x = minEdgeCoords.x; x <= maxEdgeCoords.x; x++ )
+		{
+			BuildColumnEdges( IntVec2( x, y ) );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::UpdateMovingBlock( Block const* block, SceneSpatialIndex const& sceneIndex )
+{
+	if ( IsEmpty() )
+	{
+		return;
+	}
+
+	// The first call only records where the block is, Rebuild() already built the columns around it
+	AABB3 const& box	= block->m_aabb3;
+	float		 blockZ	= box.m_maxs.z;
+	for ( int i = 0; i < m_movingBlockList.size(); i++ )
+	{
+		MovingBlockEntry& entry = m_movingBlockList[i];
+		if ( entry.m_block != block )
+		{
+			continue;
+		}
+		if ( fabsf( blockZ - entry.m_builtZ ) >= m_blockMoveRebuildDistance )
+		{
+			RebuildRegion( AABB2( Vec2( box.m_mins.x, box.m_mins.y ), Vec2( box.m_maxs.x, box.m_maxs.y ) ), sceneIndex );
+			entry.m_builtZ = blockZ;
+		}
+		return;
+	}
+	MovingBlockEntry newEntry;
+	newEntry.m_block	= block;
+	newEntry.m_builtZ	= blockZ;
+	m_movingBlockList.push_back( newEntry );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::Clear()
+{
+	m_walkableIndex		= nullptr;
+	m_latticeDimensions	= IntVec2( 0, 0 );
+	m_columnNumLayersList.clear();
+	m_nodeList.clear();
+	m_movingBlockList.clear();
+	m_visitedStampList.clear();
+	m_closedStampList.clear();
+	m_gScoreList.clear();
+	m_parentList.clear();
+	m_openList.clear();
+	m_pathNodeList.clear();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableNavGraph::IsEmpty() const
+{
+	return ( m_walkableIndex == nullptr ) || m_nodeList.empty();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableNavGraph::FindNextFootPos( Vec3 const& footPos, Vec3 const& goalPos, float maxStepLength, float maxStepHeight, Vec3& out_nextFootPos )
+{
+	m_numExpansions	= 0;
+	m_didReachGoal	= false;
+	if ( IsEmpty() )
+	{
+		return false;
+	}
+
+	// Edges were only built up to m_maxStepHeight, a query cannot loosen that
+	if ( maxStepHeight > m_maxStepHeight )
+	{
+		maxStepHeight = m_maxStepHeight;
+	}
+	int startNode	= FindNearestNode( footPos, maxStepHeight );
+	int goalNode	= FindNearestNode( goalPos, FLT_MAX );
+	if ( ( startNode < 0 ) || ( goalNode < 0 ) )
+	{
+		return false;
+	}
+
+	FindPath( startNode, goalNode, maxStepHeight );
+
+	// Step straight onto the goal if walking there along the path is within reach
+	if ( m_didReachGoal )
+	{
+		int  goalSurface	= m_nodeList[ goalNode ].m_surfaceIndex;
+		Vec3 exactGoalPos	= m_walkableIndex->GetNearestPointOnSurface( goalSurface, Vec2( goalPos.x, goalPos.y ) );
+		float pathLength	= m_gScoreList[ goalNode ] + GetDistance3D( GetNodePos( goalNode ), exactGoalPos );
+		if ( pathLength <= maxStepLength )
+		{
+			out_nextFootPos = exactGoalPos;
+			return true;
+		}
+	}
+
+	// Otherwise walk the path as far as a single step allows
+	int furthestPathIndex = 0;
+	for ( int i = 1; i < m_pathNodeList.size(); i++ )
+	{
+		if ( m_gScoreList[ m_pathNodeList[i] ] > maxStepLength )
+		{
+			break;
+		}
+		furthestPathIndex = i;
+	}
+	if ( furthestPathIndex == 0 )
+	{
+		return false;
+	}
+	out_nextFootPos = GetNodePos( m_pathNodeList[ furthestPathIndex ] );
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+float WalkableNavGraph::GetMaxStepHeightForChain( IK_Chain3D* chain ) const
+{
+	return chain->GetMaxLengthOfSkeleton() * m_stepHeightPerLimbReach;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Vec3 WalkableNavGraph::GetNodePos( int nodeIndex ) const
+{
+	int  columnIndex = nodeIndex / NAV_MAX_LAYERS_PER_COLUMN;
+	Vec2 columnPos	 = GetColumnPos( columnIndex );
+	return m_walkableIndex->GetNearestPointOnSurface( m_nodeList[ nodeIndex ].m_surfaceIndex, columnPos );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::BuildColumn( IntVec2 const& columnCoords, SceneSpatialIndex const& sceneIndex )
+{
+	int  columnIndex	= GetColumnIndex( columnCoords );
+	Vec2 columnPos		= GetColumnPos( columnIndex );
+
+	// Every surface whose XY footprint contains the column point, highest first
+	float layerHeightList[ NAV_MAX_LAYERS_PER_COLUMN ];
+	int	  layerSurfaceList[ NAV_MAX_LAYERS_PER_COLUMN ];
+	int	  numLayers		= 0;
+
+	UniformGrid2D const& surfaceGrid = m_walkableIndex->m_grid;
+	IntVec2		cellCoords	= surfaceGrid.GetCellCoordsForPoint( columnPos );
+	int			numItems	= surfaceGrid.GetNumItemsInCell( cellCoords );
+	int const*	itemList	= surfaceGrid.GetItemsInCell( cellCoords );
+	for ( int i = 0; i < numItems; i++ )
+	{
+		int  surfaceIndex	= itemList[i];
+		Vec3 surfacePos		= m_walkableIndex->GetNearestPointOnSurface( surfaceIndex, columnPos );
+		if ( GetDistanceSquared2D( Vec2( surfacePos.x, surfacePos.y ), columnPos ) > 0.0001f )
+		{
+			// Column point is off this surface
+			continue;
+		}
+		if ( IsPointInsideAnyBlock( surfacePos + Vec3( 0.0f, 0.0f, m_minLayerSeparation * 0.5f ), sceneIndex ) )
+		{
+			// Floor under a box, terrain under a cliff
+			continue;
+		}
+
+		// Neighbouring terrain triangles share their edges, keep one node per height
+		bool isDuplicate = false;
+		for ( int layer = 0; layer < numLayers; layer++ )
+		{
+			if ( fabsf( layerHeightList[ layer ] - surfacePos.z ) < m_minLayerSeparation )
+			{
+				isDuplicate = true;
+				break;
+			}
+		}
+		if ( isDuplicate )
+		{
+			continue;
+		}
+
+		// Insertion sort, highest first, dropping the lowest layer when full
+		int insertIndex = numLayers;
+		while ( ( insertIndex > 0 ) && ( layerHeightList[ insertIndex - 1 ] < surfacePos.z ) )
+		{
+			if ( insertIndex < NAV_MAX_LAYERS_PER_COLUMN )
+			{
+				layerHeightList [ insertIndex ] = layerHeightList [ insertIndex - 1 ];
+				layerSurfaceList[ insertIndex ] = layerSurfaceList[ insertIndex - 1 ];
+			}
+			insertIndex--;
+		}
+		if ( insertIndex < NAV_MAX_LAYERS_PER_COLUMN )
+		{
+			layerHeightList [ insertIndex ] = surfacePos.z;
+			layerSurfaceList[ insertIndex ] = surfaceIndex;
+			if ( numLayers < NAV_MAX_LAYERS_PER_COLUMN )
+			{
+				numLayers++;
+			}
+		}
+	}
+
+	m_columnNumLayersList[ columnIndex ] = numLayers;
+	for ( int layer = 0; layer < NAV_MAX_LAYERS_PER_COLUMN; layer++ )
+	{
+		WalkableNavNode& node	= m_nodeList[ ( columnIndex * NAV_MAX_LAYERS_PER_COLUMN ) + layer ];
+		node.m_surfaceIndex		= ( layer < numLayers ) ? layerSurfaceList[ layer ] : -1;
+		for ( int dir = 0; dir < NAV_NUM_NEIGHBORS; dir++ )
+		{
+			node.m_neighborList[ dir ] = -1;
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableNavGraph::BuildColumnEdges( IntVec2 const& columnCoords )
+{
+	int columnIndex = GetColumnIndex( columnCoords );
+	int numLayers	= m_columnNumLayersList[ columnIndex ];
+	for ( int layer = 0; layer < numLayers; layer++ )
+	{
+		int				 nodeIndex	= ( columnIndex * NAV_MAX_LAYERS_PER_COLUMN ) + layer;
+		WalkableNavNode& node		= m_nodeList[ nodeIndex ];
+		float			 nodeZ		= GetNodePos( nodeIndex ).z;
+		for ( int dir = 0; dir < NAV_NUM_NEIGHBORS; dir++ )
+		{
+			// Link to the neighbour layer closest in height, if a limb can reach it
+			node.m_neighborList[ dir ] = -1;
+			IntVec2 neighborCoords = columnCoords + s_neighborOffsets[ dir ];
+			if ( !IsColumnInBounds( neighborCoords ) )
+			{
+				continue;
+			}
+			int	  neighborColumn	= GetColumnIndex( neighborCoords );
+			float bestDeltaZ		= m_maxStepHeight;
+			for ( int neighborLayer = 0; neighborLayer < m_columnNumLayersList[ neighborColumn ]; neighborLayer++ )
+			{
+				int	  neighborNode	= ( neighborColumn * NAV_MAX_LAYERS_PER_COLUMN ) + neighborLayer;
+				float deltaZ		= fabsf( GetNodePos( neighborNode ).z - nodeZ );
+				if ( deltaZ <= bestDeltaZ )
+				{
+					node.m_neighborList[ dir ]	= neighborNode;
+					bestDeltaZ					= deltaZ;
+				}
+			}
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableNavGraph::IsPointInsideAnyBlock( Vec3 const& point, SceneSpatialIndex const& sceneIndex ) const
+{
+	// Blocks are the first items in the scene grid
+	UniformGrid2D const& sceneGrid	= sceneIndex.m_staticGrid;
+	int					 numBlocks	= int( sceneIndex.m_blockList.size() );
+	IntVec2				 cellCoords	= sceneGrid.GetCellCoordsForPoint( Vec2( point.x, point.y ) );
+	int					 numItems	= sceneGrid.GetNumItemsInCell( cellCoords );
+	int const*			 itemList	= sceneGrid.GetItemsInCell( cellCoords );
+	for ( int i = 0; i < numItems; i++ )
+	{
+		if ( itemList[i] >= numBlocks )
+		{
+			continue;
+		}
+		if ( sceneIndex.m_blockList[ itemList[i] ]->m_aabb3.IsPointInside( point ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+int WalkableNavGraph::FindNearestNode( Vec3 const& pos, float maxDeltaZ ) const
+{
+	// Closest node in the column under pos or the ring around it
+	IntVec2 centerCoords	= GetColumnCoordsForPoint( Vec2( pos.x, pos.y ) + Vec2( m_nodeSpacing * 0.5f, m_nodeSpacing * 0.5f ) );
+	int		bestNode		= -1;
+	float	bestDistSq		= FLT_MAX;
+	for ( int y = centerCoords.y - 1; y <= centerCoords.y + 1; y++ )
+	{
+		for ( int x = centerCoords.x - 1; x <= centerCoords.x + 1; x++ )
+		{
+			IntVec2 columnCoords = IntVec2( x, y );
+			if ( !IsColumnInBounds( columnCoords ) )
+			{
+				continue;
+			}
+			int columnIndex = GetColumnIndex( columnCoords );
+			for ( int layer = 0; layer < m_columnNumLayersList[ columnIndex ]; layer++ )
+			{
+				int	  nodeIndex	= ( columnIndex * NAV_MAX_LAYERS_PER_COLUMN ) + layer;
+				Vec3  nodePos	= GetNodePos( nodeIndex );
+				if ( fabsf( nodePos.z - pos.z ) > maxDeltaZ )
+				{
+					continue;
+				}
+				// Height counts double so a foot on a box does not snap to the floor beside it
+				float deltaZ	= nodePos.z - pos.z;
+				float distSq	= GetDistanceXYSquared3D( nodePos, pos ) + ( 4.0f * deltaZ * deltaZ );
+				if ( distSq < bestDistSq )
+				{
+					bestNode	= nodeIndex;
+					bestDistSq	= distSq;
+				}
+			}
+		}
+	}
+	return bestNode;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool IsOpenEntryWorse( float fScoreA, float fScoreB )
+{
+	return fScoreA > fScoreB;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableNavGraph::FindPath( int startNode, int goalNode, float maxStepHeight )
+{
+	m_pathNodeList.clear();
+	m_openList.clear();
+	m_searchStamp++;
+	if ( m_searchStamp == 0 )
+	{
+		// Wrapped around, old stamps could alias the new search
+		std::fill( m_visitedStampList.begin(), m_visitedStampList.end(), 0 );
+		std::fill( m_closedStampList.begin(),  m_closedStampList.end(),  0 );
+		m_searchStamp = 1;
+	}
+	auto compareEntries = []( OpenEntry const& a, OpenEntry const& b ) { return IsOpenEntryWorse( a.m_fScore, b.m_fScore ); };
+
+	// Edge cost is the 3D distance between node positions, so the straight line to the goal never overestimates
+	Vec3  goalPos		= GetNodePos( goalNode );
+	Vec3  startPos		= GetNodePos( startNode );
+	int	  bestNode		= startNode;
+	float bestHScore	= GetDistance3D( startPos, goalPos );
+	m_visitedStampList[ startNode ] = m_searchStamp;
+	m_gScoreList	  [ startNode ] = 0.0f;
+	m_parentList	  [ startNode ] = -1;
+	OpenEntry startEntry;
+	startEntry.m_fScore	= bestHScore;
+	startEntry.m_node	= startNode;
+	m_openList.push_back( startEntry );
+
+	while ( !m_openList.empty() )
+	{
+		std::pop_heap( m_openList.begin(), m_openList.end(), compareEntries );
+		int currentNode = m_openList.back().m_node;
+		m_openList.pop_back();
+		if ( m_closedStampList[ currentNode ] == m_searchStamp )
+		{
+			// Stale entry, a cheaper route got here first
+			continue;
+		}
+		m_closedStampList[ currentNode ] = m_searchStamp;
+
+		Vec3  currentPos	= GetNodePos( currentNode );
+		float hScore		= GetDistance3D( currentPos, goalPos );
+		if ( hScore < bestHScore )
+		{
+			bestNode	= currentNode;
+			bestHScore	= hScore;
+		}
+		if ( currentNode == goalNode )
+		{
+			bestNode		= goalNode;
+			m_didReachGoal	= true;
+			break;
+		}
+		m_numExpansions++;
+		if ( m_numExpansions >= m_maxExpansionsPerQuery )
+		{
+			break;
+		}
+
+		WalkableNavNode const& node = m_nodeList[ currentNode ];
+		for ( int dir = 0; dir < NAV_NUM_NEIGHBORS; dir++ )
+		{
+			int neighborNode = node.m_neighborList[ dir ];
+			if ( ( neighborNode < 0 ) || ( m_closedStampList[ neighborNode ] == m_searchStamp ) )
+			{
+				continue;
+			}
+			// Heights are live, the edge may have become too steep since it was built
+			Vec3 neighborPos = GetNodePos( neighborNode );
+			if ( fabsf( neighborPos.z - currentPos.z ) > maxStepHeight )
+			{
+				continue;
+			}
+			float gScore = m_gScoreList[ currentNode ] + GetDistance3D( currentPos, neighborPos );
+			if ( ( m_visitedStampList[ neighborNode ] == m_searchStamp ) && ( gScore >= m_gScoreList[ neighborNode ] ) )
+			{
+				continue;
+			}
+			m_visitedStampList[ neighborNode ]	= m_searchStamp;
+			m_gScoreList	  [ neighborNode ]	= gScore;
+			m_parentList	  [ neighborNode ]	= currentNode;
+			OpenEntry entry;
+			entry.m_fScore	= gScore + GetDistance3D( neighborPos, goalPos );
+			entry.m_node	= neighborNode;
+			m_openList.push_back( entry );
+			std::push_heap( m_openList.begin(), m_openList.end(), compareEntries );
+		}
+	}
+
+	// Path to the goal, or toward it as far as the search got
+	for ( int node = bestNode; node >= 0; node = m_parentList[ node ] )
+	{
+		m_pathNodeList.push_back( node );
+	}
+	std::reverse( m_pathNodeList.begin(), m_pathNodeList.end() );
+	return m_didReachGoal;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Vec2 WalkableNavGraph::GetColumnPos( int columnIndex ) const
+{
+	int x = columnIndex % m_latticeDimensions.x;
+	int y = columnIndex / m_latticeDimensions.x;
+	return m_latticeOrigin + Vec2( float( x ) * m_nodeSpacing, float( y ) * m_nodeSpacing );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+IntVec2 WalkableNavGraph::GetColumnCoordsForPoint( Vec2 const& point ) const
+{
+	Vec2 localPos = point - m_latticeOrigin;
+	return IntVec2( int( floorf( localPos.x / m_nodeSpacing ) ), int( floorf( localPos.y / m_nodeSpacing ) ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+IntVec2 WalkableNavGraph::GetClampedColumnCoords( IntVec2 const& columnCoords ) const
+{
+	IntVec2 clampedCoords = columnCoords;
+	clampedCoords.x = ( clampedCoords.x < 0 ) ? 0 : clampedCoords.x;
+	clampedCoords.y = ( clampedCoords.y < 0 ) ? 0 : clampedCoords.y;
+	clampedCoords.x = ( clampedCoords.x >= m_latticeDimensions.x ) ? ( m_latticeDimensions.x - 1 ) : clampedCoords.x;
+	clampedCoords.y = ( clampedCoords.y >= m_latticeDimensions.y ) ? ( m_latticeDimensions.y - 1 ) : clampedCoords.y;
+	return clampedCoords;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableNavGraph::IsColumnInBounds( IntVec2 const& columnCoords ) const
+{
+	return ( columnCoords.x >= 0 ) && ( columnCoords.y >= 0 ) && ( columnCoords.x < m_latticeDimensions.x ) && ( columnCoords.y < m_latticeDimensions.y );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+int WalkableNavGraph::GetColumnIndex( IntVec2 const& columnCoords ) const
+{
+	return ( columnCoords.y * m_latticeDimensions.x ) + columnCoords.x;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class IK_Chain3D;
+class SceneSpatialIndex;
+class WalkableSurfaceIndex;
+struct Block;
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int NAV_MAX_LAYERS_PER_COLUMN	= 4;			// Floor, box on the floor, elevator above both, ...
+constexpr int NAV_NUM_NEIGHBORS			= 8;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct WalkableNavNode
+{
+	int		m_surfaceIndex						= -1;	// Into WalkableSurfaceIndex::m_surfaceList, height is read live
+	int		m_neighborList[ NAV_NUM_NEIGHBORS ];		// Node index per lattice direction, -1 if no step edge
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Footstep graph over the walkable surfaces. Nodes sit on an XY lattice, one per walkable surface stacked under each
+// lattice point (points buried inside a block are dropped). Edges link neighbouring points whose height difference
+// a limb can step, up to m_maxStepHeight; queries can only tighten that limit.
+// Node heights are read from their surface on demand, but which nodes exist (buried ones are dropped) and which edges
+// exist is only decided when a column is built. UpdateMovingBlock() redoes the columns under a block once it has moved
+// m_blockMoveRebuildDistance in Z since they were last built, so an elevator can open and close steps as it travels.
+// RebuildRegion() redoes the lattice columns under one area and is what Rebuild() runs over the whole map.
+//----------------------------------------------------------------------------------------------------------------------
+class WalkableNavGraph
+{
+public:
+	WalkableNavGraph();
+	~WalkableNavGraph();
+
+	void Rebuild( WalkableSurfaceIndex const& walkableIndex, SceneSpatialIndex const& sceneIndex, float maxStepHeight );
+	void RebuildRegion( AABB2 const& dirtyBoundsXY, SceneSpatialIndex const& sceneIndex );
+	void UpdateMovingBlock( Block const* block, SceneSpatialIndex const& sceneIndex );		// Call after moving it in Z
+	void Clear();
+	bool IsEmpty() const;
+
+	// A* from the node under footPos toward the node under goalPos. out_nextFootPos is the furthest point along the
+	// path still within maxStepLength of footPos, or the exact goal if it is in reach.
+	// Returns false if either end is off the graph or no progress can be made.
+	bool  FindNextFootPos( Vec3 const& footPos, Vec3 const& goalPos, float maxStepLength, float maxStepHeight, Vec3& out_nextFootPos );
+	float GetMaxStepHeightForChain( IK_Chain3D* chain ) const;
+	Vec3  GetNodePos( int nodeIndex ) const;
+
+private:
+	void	BuildColumn( IntVec2 const& columnCoords, SceneSpatialIndex const& sceneIndex );
+	void	BuildColumnEdges( IntVec2 const& columnCoords );
+	bool	IsPointInsideAnyBlock( Vec3 const& point, SceneSpatialIndex const& sceneIndex ) const;
+	int		FindNearestNode( Vec3 const& pos, float maxDeltaZ ) const;
+	bool	FindPath( int startNode, int goalNode, float maxStepHeight );
+	Vec2	GetColumnPos( int columnIndex ) const;
+	IntVec2 GetColumnCoordsForPoint( Vec2 const& point ) const;
+	IntVec2 GetClampedColumnCoords( IntVec2 const& columnCoords ) const;
+	bool	IsColumnInBounds( IntVec2 const& columnCoords ) const;
+	int		GetColumnIndex( IntVec2 const& columnCoords ) const;
+
+public:
+	float							m_nodeSpacing				= 5.0f;
+	float							m_stepHeightPerLimbReach	= 0.5f;		// Fraction of a limb's full length it can step up or down
+	float							m_minLayerSeparation		= 1.0f;		// Surfaces closer than this in one column are merged
+	int								m_maxExpansionsPerQuery		= 2048;		// A* gives up and walks toward its best node after this
+	float							m_blockMoveRebuildDistance	= 2.0f;		// Z a moving block travels before its columns are redone
+
+	// Stats from the last query
+	int								m_numExpansions				= 0;
+	bool							m_didReachGoal				= false;
+
+private:
+	WalkableSurfaceIndex const*		m_walkableIndex				= nullptr;
+	float							m_maxStepHeight				= 0.0f;
+	Vec2							m_latticeOrigin				= Vec2( 0.0f, 0.0f );
+	IntVec2							m_latticeDimensions			= IntVec2( 0, 0 );
+	std::vector<int>				m_columnNumLayersList;
+	std::vector<WalkableNavNode>	m_nodeList;								// NAV_MAX_LAYERS_PER_COLUMN slots per column, highest first
+
+	// Height each moving block was at when the columns under it were last built
+	struct MovingBlockEntry
+	{
+		Block const*	m_block		= nullptr;
+		float			m_builtZ	= 0.0f;
+	};
+	std::vector<MovingBlockEntry>	m_movingBlockList;
+
+	// A* scratch, stamped per search so nothing is cleared between queries
+	struct OpenEntry
+	{
+		float	m_fScore	= 0.0f;
+		int		m_node		= -1;
+	};
+	unsigned int					m_searchStamp				= 0;
+	std::vector<unsigned int>		m_visitedStampList;
+	std::vector<unsigned int>		m_closedStampList;
+	std::vector<float>				m_gScoreList;
+	std::vector<int>				m_parentList;
+	std::vector<OpenEntry>			m_openList;
+	std::vector<int>				m_pathNodeList;
+};
@@ -0,0 +1,174 @@
+#include "Game/WalkableSurfaceIndex.hpp"
+#include "Game/GameMode3D.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+
+#include <math.h>
+
+
+//----------------------------------------------------------------------------------------------------------------------
+WalkableSurfaceIndex::WalkableSurfaceIndex()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+WalkableSurfaceIndex::~WalkableSurfaceIndex()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableSurfaceIndex::Rebuild( std::vector<Block*> const& blockList, std::vector<Vertex_PCU> const& terrainVerts, std::vector<unsigned int> const& terrainIndexList )
+{
+	Clear();
+
+	std::vector<AABB2> surfaceBoundsList;
+	surfaceBoundsList.reserve( blockList.size() + ( terrainIndexList.size() / 3 ) );
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Walkable block tops
+	//----------------------------------------------------------------------------------------------------------------------
+	for ( int i = 0; i < blockList.size(); i++ )
+	{
+		Block const* currentBlock = blockList[i];
+		if ( !currentBlock->m_isWalkable )
+		{
+			continue;
+		}
+		WalkableSurface surface;
+		surface.m_block = currentBlock;
+		m_surfaceList.push_back( surface );
+		AABB3 const& box = currentBlock->m_aabb3;
+		surfaceBoundsList.push_back( AABB2( box.m_mins.x, box.m_mins.y, box.m_maxs.x, box.m_maxs.y ) );
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Terrain triangles
+	//----------------------------------------------------------------------------------------------------------------------
+	for ( int i = 0; i + 2 < terrainIndexList.size(); i += 3 )
+	{
+		WalkableSurface surface;
+		surface.m_triVerts[0] = terrainVerts[ terrainIndexList[ i + 0 ] ].m_position;
+		surface.m_triVerts[1] = terrainVerts[ terrainIndexList[ i + 1 ] ].m_position;
+		surface.m_triVerts[2] = terrainVerts[ terrainIndexList[ i + 2 ] ].m_position;
+		m_surfaceList.push_back( surface );
+
+		AABB2 triBounds = AABB2( Vec2( surface.m_triVerts[0].x, surface.m_triVerts[0].y ), Vec2( surface.m_triVerts[0].x, surface.m_triVerts[0].y ) );
+		triBounds.StretchToIncludePoint( Vec2( surface.m_triVerts[1].x, surface.m_triVerts[1].y ) );
+		triBounds.StretchToIncludePoint( Vec2( surface.m_triVerts[2].x, surface.m_triVerts[2].y ) );
+		surfaceBoundsList.push_back( triBounds );
+	}
+
+	m_grid.Build( surfaceBoundsList, m_cellSize );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WalkableSurfaceIndex::Clear()
+{
+	m_surfaceList.clear();
+	m_grid.Clear();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WalkableSurfaceIndex::GetNearestWalkablePoint( Vec3 const& refPos, float maxRadius, Vec3& out_nearestPoint ) const
+{
+	if ( m_grid.IsEmpty() )
+	{
+		return false;
+	}
+
+	// Search rings of cells outward from the cell containing refPos; stop once a ring cannot contain anything closer
+	Vec2	refPosXY			= Vec2( refPos.x, refPos.y );
+	IntVec2	centerCell			= m_grid.GetCellCoordsForPoint( refPosXY );
+	float	cellSize			= m_grid.GetCellSize();
+	int		maxRing				= int( ceilf( maxRadius / cellSize ) ) + 1;
+	float	bestDistSqXY		= maxRadius * maxRadius;
+	float	bestDistXY			= maxRadius;
+	float	bestDistZ			= 0.0f;
+	bool	didFindSurface		= false;
+	for ( int ring = 0; ring <= maxRing; ring++ )
+	{
+		float ringMinDist = float( ring - 1 ) * cellSize;
+		if ( ( ring > 0 ) && ( ringMinDist > ( bestDistXY + m_tieToleranceXY ) ) )
+		{
+			break;
+		}
+
+		for ( int y = centerCell.y - ring; y <= centerCell.y + ring; y++ )
+		{
+			// Only the perimeter of the ring is new, interior cells were covered by previous rings
+			bool isEdgeRow	= ( y == centerCell.y - ring ) || ( y == centerCell.y + ring );
+			int  xStep		= isEdgeRow ? 1 : ( 2 * ring );
+			for ( int x = centerCell.x - ring; x <= centerCell.x + ring; x += xStep )
+			{
+				IntVec2		cellCoords	= IntVec2( x, y );
+				int			numItems	= m_grid.GetNumItemsInCell( cellCoords );
+				int const*	itemList	= m_grid.GetItemsInCell( cellCoords );
+				for ( int i = 0; i < numItems; i++ )
+				{
+					Vec3  candidatePos	= GetNearestPointOnSurface( itemList[i], refPosXY );
+					float distSqXY		= GetDistanceXYSquared3D( candidatePos, refPos );
+					float distZ			= fabsf( candidatePos.z - refPos.z );
+					if ( distSqXY > ( ( bestDistXY + m_tieToleranceXY ) * ( bestDistXY + m_tieToleranceXY ) ) )
+					{
+						continue;
+					}
+					// Stacked surfaces (box on a floor) tie in XY, prefer the one closest in height
+					float distXY		= sqrtf( distSqXY );
+					bool  isTiedXY		= didFindSurface && ( fabsf( distXY - bestDistXY ) <= m_tieToleranceXY );
+					if ( isTiedXY ? ( distZ >= bestDistZ ) : ( distSqXY > bestDistSqXY ) )
+					{
+						continue;
+					}
+					out_nearestPoint	= candidatePos;
+					bestDistSqXY		= distSqXY;
+					bestDistXY			= distXY;
+					bestDistZ			= distZ;
+					didFindSurface		= true;
+				}
+			}
+		}
+	}
+	return didFindSurface;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Vec3 WalkableSurfaceIndex::GetNearestPointOnSurface( int surfaceIndex, Vec2 const& refPosXY ) const
+{
+	WalkableSurface const& surface = m_surfaceList[ surfaceIndex ];
+	if ( surface.m_block != nullptr )
+	{
+		// Clamp to the block footprint and snap to its top face
+		AABB3 const& box		= surface.m_block->m_aabb3;
+		float		 nearestX	= GetClamped( refPosXY.x, box.m_mins.x, box.m_maxs.x );
+		float		 nearestY	= GetClamped( refPosXY.y, box.m_mins.y, box.m_maxs.y );
+		return Vec3( nearestX, nearestY, box.m_maxs.z );
+	}
+
+	// Nearest point on the triangle's XY projection, height from barycentric interpolation
+	Vec3 const& vert0	= surface.m_triVerts[0];
+	Vec3 const& vert1	= surface.m_triVerts[1];
+	Vec3 const& vert2	= surface.m_triVerts[2];
+	Vec2 a				= Vec2( vert0.x, vert0.y );
+	Vec2 b				= Vec2( vert1.x, vert1.y );
+	Vec2 c				= Vec2( vert2.x, vert2.y );
+	Vec2 nearestXY		= GetNearestPointOnTriangle2D( refPosXY, a, b, c );
+	float denominator	= CrossProduct2D( b - a, c - a );
+	if ( denominator == 0.0f )
+	{
+		// Degenerate (vertical) triangle, use its highest vert
+		float topZ = vert0.z;
+		topZ = ( vert1.z > topZ ) ? vert1.z : topZ;
+		topZ = ( vert2.z > topZ ) ? vert2.z : topZ;
+		return Vec3( nearestXY.x, nearestXY.y, topZ );
+	}
+	float weightB		= CrossProduct2D( nearestXY - a, c - a ) / denominator;
+	float weightC		= CrossProduct2D( b - a, nearestXY - a ) / denominator;
+	float weightA		= 1.0f - weightB - weightC;
+	float nearestZ		= ( weightA * vert0.z ) + ( weightB * vert1.z ) + ( weightC * vert2.z );
+	return Vec3( nearestXY.x, nearestXY.y, nearestZ );
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/Math/UniformGrid2D.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+struct Block;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct WalkableSurface
+{
+	Block const*	m_block			= nullptr;		// Top face of a walkable block, read live so vertically moving blocks (elevators) stay current
+	Vec3			m_triVerts[3];					// Terrain triangle, used when m_block is nullptr
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Precomputed index of everything a foot can stand on (walkable block tops + terrain triangles), bucketed by XY.
+// Must be rebuilt when a block moves in XY or the terrain heights change; vertical block motion is picked up for free.
+//----------------------------------------------------------------------------------------------------------------------
+class WalkableSurfaceIndex
+{
+public:
+	WalkableSurfaceIndex();
+	~WalkableSurfaceIndex();
+
+	void Rebuild( std::vector<Block*> const& blockList, std::vector<Vertex_PCU> const& terrainVerts, std::vector<unsigned int> const& terrainIndexList );
+	void Clear();
+
+	// Returns false (and leaves out_nearestPoint untouched) if no walkable surface lies within maxRadius (in XY) of refPos
+	bool GetNearestWalkablePoint( Vec3 const& refPos, float maxRadius, Vec3& out_nearestPoint ) const;
+	Vec3 GetNearestPointOnSurface( int surfaceIndex, Vec2 const& refPosXY ) const;
+
+public:
+	float							m_cellSize			= 20.0f;
+	float							m_tieToleranceXY	= 0.01f;		// Surfaces this close in XY count as stacked, the nearest in Z wins
+	std::vector<WalkableSurface>	m_surfaceList;
+	UniformGrid2D					m_grid;
+};
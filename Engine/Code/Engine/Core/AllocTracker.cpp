@@ -0,0 +1,309 @@
+#include "Engine/Core/AllocTracker.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Everything the hooks touch is zero-initialized, so allocations made before main (or after exit) are safe to count
+struct AllocTagSlot
+{
+	std::atomic<char const*>	m_name;
+	std::atomic<int64_t>		m_frameNumAllocs;
+	std::atomic<int64_t>		m_frameNumBytes;
+	std::atomic<int64_t>		m_liveBytes;
+	std::atomic<int64_t>		m_peakLiveBytes;
+	std::atomic<int64_t>		m_totalNumAllocs;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static AllocTagSlot					s_allocTagSlotList[ MAX_ALLOC_TAGS ];		// Slot 0 is "Untagged"
+static std::atomic<int64_t>			s_liveBytes;
+static std::atomic<int64_t>			s_peakLiveBytes;
+static thread_local int				t_allocTagIndex				= 0;
+
+// Main thread only
+static int64_t						s_lastFrameNumAllocsList[ MAX_ALLOC_TAGS ];
+static int64_t						s_lastFrameNumBytesList[ MAX_ALLOC_TAGS ];
+static AllocFrameStats				s_lastFrame;
+static int64_t						s_frameIndex				= 0;
+static int							s_numWarmupFramesLeft		= 60;
+static int64_t						s_numFlaggedFrames			= 0;
+static double						s_lastFlagLogSeconds		= -1.0;
+
+//----------------------------------------------------------------------------------------------------------------------
+static void RaiseToAtLeast( std::atomic<int64_t>& peak, int64_t value )
+{
+	int64_t currentPeak = peak.load( std::memory_order_relaxed );
+	while ( value > currentPeak && !peak.compare_exchange_weak( currentPeak, value, std::memory_order_relaxed ) )
+	{
+	}
+}
+
+#if defined( ENGINE_TRACK_ALLOCATIONS )
+//----------------------------------------------------------------------------------------------------------------------
+// Sits in front of every tracked block; 16 bytes keeps the block as aligned as malloc made it
+struct alignas( 16 ) AllocHeader
+{
+	uint64_t	m_numBytes	= 0;
+	uint32_t	m_tagIndex	= 0;
+	uint32_t	m_magic		= 0;
+};
+static uint32_t const ALLOC_HEADER_MAGIC = 0xA110C8ED;
+
+//----------------------------------------------------------------------------------------------------------------------
+static void* TrackedAlloc( size_t numBytes )
+{
+	AllocHeader* header = static_cast<AllocHeader*>( malloc( sizeof( AllocHeader ) + numBytes ) );
+	if ( header == nullptr )
+	{
+		return nullptr;
+	}
+	int tagIndex		= t_allocTagIndex;
+	header->m_numBytes	= numBytes;
+	header->m_tagIndex	= uint32_t( tagIndex );
+	header->m_magic		= ALLOC_HEADER_MAGIC;
+
+	AllocTagSlot& slot = s_allocTagSlotList[ tagIndex ];
+	slot.m_frameNumAllocs.fetch_add( 1, std::memory_order_relaxed );
+	slot.m_frameNumBytes.fetch_add( int64_t( numBytes ), std::memory_order_relaxed );
+	slot.m_totalNumAllocs.fetch_add( 1, std::memory_order_relaxed );
+	RaiseToAtLeast( slot.m_peakLiveBytes, slot.m_liveBytes.fetch_add( int64_t( numBytes ), std::memory_order_relaxed ) + int64_t( numBytes ) );
+	RaiseToAtLeast( s_peakLiveBytes, s_liveBytes.fetch_add( int64_t( numBytes ), std::memory_order_relaxed ) + int64_t( numBytes ) );
+	return header + 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void TrackedFree( void* block )
+{
+	if ( block == nullptr )
+	{
+		return;
+	}
+	AllocHeader* header = static_cast<AllocHeader*>( block ) - 1;
+	GUARANTEE_OR_DIE( header->m_magic == ALLOC_HEADER_MAGIC, "operator delete on a block the allocation tracker didn't allocate" );
+	header->m_magic = 0;
+
+	// Freed bytes go back to the tag that allocated them, whichever tag is current now
+	int64_t numBytes = int64_t( header->m_numBytes );
+	s_allocTagSlotList[ header->m_tagIndex ].m_liveBytes.fetch_sub( numBytes, std::memory_order_relaxed );
+	s_liveBytes.fetch_sub( numBytes, std::memory_order_relaxed );
+	free( header );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Global replacements. The aligned overloads are left to the runtime, they pair with their own deletes
+void* operator new( size_t numBytes )
+{
+	void* block = TrackedAlloc( numBytes );
+	if ( block == nullptr )
+	{
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void* operator new[]( size_t numBytes )
+{
+	void* block = TrackedAlloc( numBytes );
+	if ( block == nullptr )
+	{
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void* operator new( size_t numBytes, std::nothrow_t const& ) noexcept			{ return TrackedAlloc( numBytes ); }
+void* operator new[]( size_t numBytes, std::nothrow_t const& ) noexcept			{ return TrackedAlloc( numBytes ); }
+void operator delete( void* block ) noexcept									{ TrackedFree( block ); }
+void operator delete[]( void* block ) noexcept									{ TrackedFree( block ); }
+void operator delete( void* block, size_t ) noexcept							{ TrackedFree( block ); }
+void operator delete[]( void* block, size_t ) noexcept							{ TrackedFree( block ); }
+void operator delete( void* block, std::nothrow_t const& ) noexcept				{ TrackedFree( block ); }
+void operator delete[]( void* block, std::nothrow_t const& ) noexcept			{ TrackedFree( block ); }
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+bool AllocTrackerIsEnabled()
+{
+#if defined( ENGINE_TRACK_ALLOCATIONS )
+	return true;
+#else
+	return false;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int AllocTrackerGetTagIndex( char const* tagName )
+{
+	// Match by pointer first, then by text so the same literal from two translation units shares a slot
+	for ( int i = 1; i < MAX_ALLOC_TAGS; i++ )
+	{
+		char const* slotName = s_allocTagSlotList[i].m_name.load( std::memory_order_acquire );
+		if ( slotName == nullptr )
+		{
+			char const* expectedName = nullptr;
+			if ( s_allocTagSlotList[i].m_name.compare_exchange_strong( expectedName, tagName, std::memory_order_acq_rel ) )
+			{
+				return i;
+			}
+			slotName = expectedName;		// Another thread claimed it first, it may be the same tag
+		}
+		if ( slotName == tagName || strcmp( slotName, tagName ) == 0 )
+		{
+			return i;
+		}
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int AllocTrackerSetCurrentTag( int tagIndex )
+{
+	int previousTagIndex	= t_allocTagIndex;
+	t_allocTagIndex			= tagIndex;
+	return previousTagIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AllocTrackerBeginFrame()
+{
+	if ( !AllocTrackerIsEnabled() )
+	{
+		return;
+	}
+
+	AllocFrameStats frame;
+	frame.m_frameIndex = s_frameIndex++;
+	int busiestTagIndex = 0;
+	for ( int i = 0; i < MAX_ALLOC_TAGS; i++ )
+	{
+		s_lastFrameNumAllocsList[i]	= s_allocTagSlotList[i].m_frameNumAllocs.exchange( 0, std::memory_order_relaxed );
+		s_lastFrameNumBytesList[i]	= s_allocTagSlotList[i].m_frameNumBytes.exchange( 0, std::memory_order_relaxed );
+		frame.m_numAllocs			+= s_lastFrameNumAllocsList[i];
+		frame.m_numBytes			+= s_lastFrameNumBytesList[i];
+		if ( s_lastFrameNumAllocsList[i] > s_lastFrameNumAllocsList[ busiestTagIndex ] )
+		{
+			busiestTagIndex = i;
+		}
+	}
+	frame.m_liveBytes		= s_liveBytes.load( std::memory_order_relaxed );
+	frame.m_peakLiveBytes	= s_peakLiveBytes.load( std::memory_order_relaxed );
+
+	if ( s_numWarmupFramesLeft > 0 )
+	{
+		s_numWarmupFramesLeft--;
+	}
+	else
+	{
+		frame.m_isSteadyState = true;
+		if ( frame.m_numAllocs > 0 )
+		{
+			s_numFlaggedFrames++;
+
+			// Once a second at most, a leaky loop would otherwise flood the output
+			double currentSeconds = GetCurrentTimeSeconds();
+			if ( s_lastFlagLogSeconds < 0.0 || ( currentSeconds - s_lastFlagLogSeconds ) >= 1.0 )
+			{
+				s_lastFlagLogSeconds = currentSeconds;
+				char const* busiestTagName = s_allocTagSlotList[ busiestTagIndex ].m_name.load( std::memory_order_acquire );
+				DebuggerPrintf( "AllocTracker: frame %lld allocated %lld times (%lld bytes) in steady state, most in \"%s\" (%lld)\n",
+								frame.m_frameIndex, frame.m_numAllocs, frame.m_numBytes, busiestTagName ? busiestTagName : "Untagged", s_lastFrameNumAllocsList[ busiestTagIndex ] );
+			}
+		}
+	}
+	frame.m_numFlaggedFrames	= s_numFlaggedFrames;
+	s_lastFrame					= frame;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AllocTrackerResetSteadyState( int numWarmupFrames )
+{
+	s_numWarmupFramesLeft	= numWarmupFrames;
+	s_numFlaggedFrames		= 0;
+	s_lastFlagLogSeconds	= -1.0;
+	s_peakLiveBytes.store( s_liveBytes.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+	for ( int i = 0; i < MAX_ALLOC_TAGS; i++ )
+	{
+		s_allocTagSlotList[i].m_peakLiveBytes.store( s_allocTagSlotList[i].m_liveBytes.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+AllocFrameStats AllocTrackerGetLastFrame()
+{
+	return s_lastFrame;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AllocTrackerGetTagStats( std::vector<AllocTagStats>& out_tagStatsList )
+{
+	out_tagStatsList.clear();
+	for ( int i = 0; i < MAX_ALLOC_TAGS; i++ )
+	{
+		AllocTagSlot const& slot = s_allocTagSlotList[i];
+		char const* slotName = slot.m_name.load( std::memory_order_acquire );
+		if ( i != 0 && slotName == nullptr )
+		{
+			break;
+		}
+		AllocTagStats tagStats;
+		tagStats.m_name				= ( i == 0 ) ? "Untagged" : slotName;
+		tagStats.m_frameNumAllocs	= s_lastFrameNumAllocsList[i];
+		tagStats.m_frameNumBytes	= s_lastFrameNumBytesList[i];
+		tagStats.m_liveBytes		= slot.m_liveBytes.load( std::memory_order_relaxed );
+		tagStats.m_peakLiveBytes	= slot.m_peakLiveBytes.load( std::memory_order_relaxed );
+		tagStats.m_totalNumAllocs	= slot.m_totalNumAllocs.load( std::memory_order_relaxed );
+		out_tagStatsList.push_back( tagStats );
+	}
+	std::sort( out_tagStatsList.begin(), out_tagStatsList.end(), []( AllocTagStats const& a, AllocTagStats const& b )
+	{
+		if ( a.m_frameNumAllocs != b.m_frameNumAllocs )
+		{
+			return a.m_frameNumAllocs > b.m_frameNumAllocs;
+		}
+		return a.m_liveBytes > b.m_liveBytes;
+	} );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_AllocStats( NamedStrings& args )
+{
+	if ( !AllocTrackerIsEnabled() )
+	{
+		g_theDevConsole->AddLine( Rgba8::RED, "Allocation tracking is compiled out, #define ENGINE_TRACK_ALLOCATIONS in EngineBuildPreferences.hpp" );
+		return true;
+	}
+
+	if ( args.GetValue( "reset", false ) )
+	{
+		AllocTrackerResetSteadyState();
+		g_theDevConsole->AddLine( Rgba8::GREEN, "Allocation tracker warmup and peaks reset" );
+		return true;
+	}
+
+	AllocFrameStats frame = AllocTrackerGetLastFrame();
+	Rgba8 frameColor = ( frame.m_isSteadyState && frame.m_numAllocs > 0 ) ? Rgba8::YELLOW : Rgba8::GREEN;
+	g_theDevConsole->AddLine( frameColor, Stringf( "Frame %lld: %lld allocs, %.1f KB  live %.1f KB  peak %.1f KB  flagged frames %lld%s",
+												   frame.m_frameIndex, frame.m_numAllocs, float( frame.m_numBytes ) / 1024.0f, float( frame.m_liveBytes ) / 1024.0f,
+												   float( frame.m_peakLiveBytes ) / 1024.0f, frame.m_numFlaggedFrames, frame.m_isSteadyState ? "" : " (warming up)" ) );
+
+	std::vector<AllocTagStats> tagStatsList;
+	AllocTrackerGetTagStats( tagStatsList );
+	for ( int i = 0; i < tagStatsList.size(); i++ )
+	{
+		AllocTagStats const& tagStats = tagStatsList[i];
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %-24s %6lld allocs %10.1f KB/frame  live %10.1f KB  peak %10.1f KB",
+														 tagStats.m_name, tagStats.m_frameNumAllocs, float( tagStats.m_frameNumBytes ) / 1024.0f,
+														 float( tagStats.m_liveBytes ) / 1024.0f, float( tagStats.m_peakLiveBytes ) / 1024.0f ) );
+	}
+	return true;
+}
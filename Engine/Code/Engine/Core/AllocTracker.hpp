@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// #define ENGINE_TRACK_ALLOCATIONS in Game/EngineBuildPreferences.hpp to replace the global operator new/delete with
+// counting versions. Every allocation is charged to the innermost ALLOC_TAG( "IK" ) on its thread ("Untagged" outside
+// of any), and AllocTrackerBeginFrame rolls the per-frame counts over. Once the game has warmed up, a frame that still
+// allocates is flagged: steady state should not touch the heap.
+// Tag names must be string literals (only the pointer is kept) and there are at most MAX_ALLOC_TAGS of them.
+// Without the define ALLOC_TAG compiles to nothing and the functions below report nothing.
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( ENGINE_TRACK_ALLOCATIONS )
+#define ALLOC_TAG_JOIN_INNER( a, b )	a##b
+#define ALLOC_TAG_JOIN( a, b )			ALLOC_TAG_JOIN_INNER( a, b )
+#define ALLOC_TAG( tagName )			static int const ALLOC_TAG_JOIN( allocTagIndex_, __LINE__ ) = AllocTrackerGetTagIndex( tagName ); \
+										AllocTagScope ALLOC_TAG_JOIN( allocTagScope_, __LINE__ )( ALLOC_TAG_JOIN( allocTagIndex_, __LINE__ ) )
+#else
+#define ALLOC_TAG( tagName )
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int MAX_ALLOC_TAGS = 64;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct AllocTagStats
+{
+	char const*		m_name				= nullptr;
+	int64_t			m_frameNumAllocs	= 0;		// Last finished frame
+	int64_t			m_frameNumBytes		= 0;
+	int64_t			m_liveBytes			= 0;
+	int64_t			m_peakLiveBytes		= 0;
+	int64_t			m_totalNumAllocs	= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct AllocFrameStats
+{
+	int64_t			m_frameIndex		= -1;
+	int64_t			m_numAllocs			= 0;
+	int64_t			m_numBytes			= 0;
+	int64_t			m_liveBytes			= 0;
+	int64_t			m_peakLiveBytes		= 0;
+	bool			m_isSteadyState		= false;	// Past the warmup frames
+	int64_t			m_numFlaggedFrames	= 0;		// Steady state frames that allocated, since the last reset
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+bool			AllocTrackerIsEnabled();
+void			AllocTrackerBeginFrame();								// Main thread, closes the previous frame
+void			AllocTrackerResetSteadyState( int numWarmupFrames = 60 );	// e.g. after loading, also resets peaks
+AllocFrameStats	AllocTrackerGetLastFrame();
+void			AllocTrackerGetTagStats( std::vector<AllocTagStats>& out_tagStatsList );	// Tags in use, busiest first
+
+//----------------------------------------------------------------------------------------------------------------------
+// Used by ALLOC_TAG
+int				AllocTrackerGetTagIndex( char const* tagName );
+int				AllocTrackerSetCurrentTag( int tagIndex );				// Returns the previous tag
+
+//----------------------------------------------------------------------------------------------------------------------
+class AllocTagScope
+{
+public:
+	explicit AllocTagScope( int tagIndex )
+		: m_previousTagIndex( AllocTrackerSetCurrentTag( tagIndex ) )
+	{
+	}
+
+	~AllocTagScope()
+	{
+		AllocTrackerSetCurrentTag( m_previousTagIndex );
+	}
+
+	AllocTagScope( AllocTagScope const& copy ) = delete;
+	AllocTagScope& operator=( AllocTagScope const& copy ) = delete;
+
+private:
+	int		m_previousTagIndex	= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// "allocstats" prints the last frame per tag; "allocstats reset=true" restarts the warmup and peaks
+bool Command_AllocStats( NamedStrings& args );
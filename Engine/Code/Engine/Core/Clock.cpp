@@ -1,8 +1,10 @@
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/FrameStats.hpp"
 #include "Engine/Core/Time.hpp"
 
 //----------------------------------------------------------------------------------------------------------------------
-static Clock g_theSystemClock;
+static FrameStats	s_systemFrameStats;
+static Clock		g_theSystemClock;
  
 //----------------------------------------------------------------------------------------------------------------------
 Clock::Clock()
@@ -42,14 +44,25 @@ Clock::~Clock()
 //----------------------------------------------------------------------------------------------------------------------
 void Clock::Reset()
 {
-	m_lastUpdateTimeInSeconds	= 0.0f;
-	m_totalSeconds				= 0.0f;
-	m_deltaSeconds				= 0.0f;
+	m_totalNanoseconds			= 0;
+	m_deltaNanoseconds			= 0;
+	m_unclampedDeltaNanoseconds	= 0;
 	m_frameCount				= 0;
 
 	// get current time as last updated time
-	float currentTime			= static_cast<float>( GetCurrentTimeSeconds() );
-	m_lastUpdateTimeInSeconds	= currentTime;
+	m_lastUpdateTimeNanoseconds	= GetCurrentTimeNanoseconds();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double Clock::GetLastUpdateTimeSeconds() const
+{
+	return NanosecondsToSeconds( m_lastUpdateTimeNanoseconds );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+float Clock::GetUnclampedDeltaSeconds() const
+{
+	return static_cast<float>( NanosecondsToSeconds( m_unclampedDeltaNanoseconds ) );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -98,13 +111,37 @@ float Clock::GetTimeScale() const
 //----------------------------------------------------------------------------------------------------------------------
 float Clock::GetDeltaSeconds() const
 {
-	return m_deltaSeconds;
+	return static_cast<float>( NanosecondsToSeconds( m_deltaNanoseconds ) );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 float Clock::GetTotalSeconds() const
 {
-	return m_totalSeconds;
+	return static_cast<float>( NanosecondsToSeconds( m_totalNanoseconds ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t Clock::GetDeltaNanoseconds() const
+{
+	return m_deltaNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t Clock::GetTotalNanoseconds() const
+{
+	return m_totalNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t Clock::GetLastUpdateTimeNanoseconds() const
+{
+	return m_lastUpdateTimeNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t Clock::GetUnclampedDeltaNanoseconds() const
+{
+	return m_unclampedDeltaNanoseconds;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -122,46 +159,77 @@ Clock& Clock::GetSystemClock()
 //----------------------------------------------------------------------------------------------------------------------
 void Clock::TickSystemClock()
 {
+	// The first tick measures from time zero rather than from a previous frame, so it is not a real frame
+	static bool s_hasTickedSystemClock = false;
 	g_theSystemClock.Tick(); 
+	if ( s_hasTickedSystemClock )
+	{
+		s_systemFrameStats.AddFrame( NanosecondsToSeconds( g_theSystemClock.m_unclampedDeltaNanoseconds ), g_theSystemClock.m_frameCount );
+	}
+	s_hasTickedSystemClock = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameStats& Clock::GetSystemFrameStats()
+{
+	return s_systemFrameStats;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Clock::SetSystemClockFixedStep( int64_t fixedDeltaNanoseconds )
+{
+	g_theSystemClock.m_fixedDeltaNanoseconds = fixedDeltaNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t Clock::GetSystemClockFixedStep()
+{
+	return g_theSystemClock.m_fixedDeltaNanoseconds;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void Clock::Tick()
 {
-	// Calculate current delta seconds
-	float currentTime	= static_cast<float>( GetCurrentTimeSeconds() ); 
-	float deltaSeconds	= ( currentTime - m_lastUpdateTimeInSeconds );
+	// Calculate current delta nanoseconds
+	int64_t currentTime			= GetCurrentTimeNanoseconds();
+	int64_t deltaNanoseconds	= ( currentTime - m_lastUpdateTimeNanoseconds );
+	m_unclampedDeltaNanoseconds = deltaNanoseconds;
 
-	if ( deltaSeconds > m_maxDeltaSeconds )
+	if ( m_fixedDeltaNanoseconds > 0 )
+	{
+		// Unclamped delta stays the real frame time, so FrameStats still measures the work done
+		deltaNanoseconds = m_fixedDeltaNanoseconds;
+	}
+	else if ( deltaNanoseconds > m_maxDeltaNanoseconds )
 	{
-		deltaSeconds = m_maxDeltaSeconds;
+		deltaNanoseconds = m_maxDeltaNanoseconds;
 	}
 
-	Advance( deltaSeconds );
-	m_lastUpdateTimeInSeconds = currentTime;
+	Advance( deltaNanoseconds );
+	m_lastUpdateTimeNanoseconds = currentTime;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void Clock::Advance( float deltaTimeSeconds )
+void Clock::Advance( int64_t deltaNanoseconds )
 {
 	if ( IsPaused() )
 	{
-		m_deltaSeconds = 0;
+		m_deltaNanoseconds = 0;
 		for ( int i = 0; i < m_children.size(); i++ )
 		{
-			m_children[i]->Advance( m_deltaSeconds );
+			m_children[i]->Advance( m_deltaNanoseconds );
 		}
 	}
 	else
 	{
-		m_deltaSeconds				= m_timeScale * deltaTimeSeconds;
-		m_lastUpdateTimeInSeconds	= static_cast<float>( GetCurrentTimeSeconds() );
-		m_totalSeconds				= m_totalSeconds + m_deltaSeconds;
+		m_deltaNanoseconds			= static_cast<int64_t>( double( m_timeScale ) * double( deltaNanoseconds ) );
+		m_lastUpdateTimeNanoseconds	= GetCurrentTimeNanoseconds();
+		m_totalNanoseconds			= m_totalNanoseconds + m_deltaNanoseconds;
 		m_frameCount++;
 	
 		for ( int i = 0; i < m_children.size(); i++ )
 		{
-			m_children[i]->Advance( m_deltaSeconds );
+			m_children[i]->Advance( m_deltaNanoseconds );
 		}
 	}
 
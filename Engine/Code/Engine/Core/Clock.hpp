@@ -1,7 +1,11 @@
 #pragma once
 
+#include <stdint.h>
 #include <vector>
 
+//----------------------------------------------------------------------------------------------------------------------
+class FrameStats;
+
 //----------------------------------------------------------------------------------------------------------------------
 class Clock
 {
@@ -24,14 +28,25 @@ public:
 	float	GetDeltaSeconds()	const;
 	float	GetTotalSeconds()	const;
 	size_t	GetFrameCount()		const;
+	double	GetLastUpdateTimeSeconds() const;		// Real time of the last tick, i.e. when this frame started
+	float	GetUnclampedDeltaSeconds() const;		// Real time between the last two ticks, before m_maxDeltaNanoseconds
+
+	// Exact forms of the above, time is kept in nanoseconds so it doesn't lose precision as it grows
+	int64_t	GetDeltaNanoseconds()				const;
+	int64_t	GetTotalNanoseconds()				const;
+	int64_t	GetLastUpdateTimeNanoseconds()		const;
+	int64_t	GetUnclampedDeltaNanoseconds()		const;
 
 public:
 	static Clock&	GetSystemClock();
 	static void		TickSystemClock();
+	static FrameStats&	GetSystemFrameStats();
+	static void		SetSystemClockFixedStep( int64_t fixedDeltaNanoseconds );	// Every tick advances exactly this much, 0 goes back to real time
+	static int64_t	GetSystemClockFixedStep();
 
 protected:
 	void Tick();
-	void Advance	( float	 deltaTimeSeconds );
+	void Advance	( int64_t deltaNanoseconds );
 	void AddChild	( Clock* childClock		  );
 	void RemoveChild( Clock* childClock		  );
 
@@ -39,13 +54,15 @@ protected:
 	Clock*					m_parent						= nullptr;
 	std::vector<Clock*>		m_children;
 
-	float					m_lastUpdateTimeInSeconds		= 0.0f;			// last time tick was called
-	float					m_totalSeconds					= 0.0f;			// currentTime
-	float					m_deltaSeconds					= 0.0f;
+	int64_t					m_lastUpdateTimeNanoseconds		= 0;			// last time tick was called
+	int64_t					m_totalNanoseconds				= 0;			// currentTime
+	int64_t					m_deltaNanoseconds				= 0;
+	int64_t					m_unclampedDeltaNanoseconds		= 0;
 	size_t					m_frameCount					= 0;
 		
 	float					m_timeScale						= 1.0f;
 	bool					m_isPaused						= false;
 	bool					m_stepSingleFrame				= false;
-	float					m_maxDeltaSeconds				= 0.1f;
+	int64_t					m_maxDeltaNanoseconds			= 100'000'000;	// 0.1s
+	int64_t					m_fixedDeltaNanoseconds			= 0;			// Replaces the measured delta when > 0, for deterministic runs
 };
\ No newline at end of file
@@ -11,9 +11,11 @@ DevConsole* g_theDevConsole = nullptr;
 
 //----------------------------------------------------------------------------------------------------------------------
 DevConsole::DevConsole( DevConsoleConfig const& config )
+	: m_pendingLineQueue( config.m_pendingLineCapacity )
 {
 	m_config		 = config;
 	m_caretStopwatch = new Stopwatch( 0.5f );
+	m_ownerThreadID	 = std::this_thread::get_id();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -48,6 +50,8 @@ void DevConsole::Shutdown()
 //----------------------------------------------------------------------------------------------------------------------
 void DevConsole::BeginFrame()
 {
+	AddPendingLinesFromOtherThreads();
+
 	if ( !m_isOpen )
 	{
 		return;
@@ -69,6 +73,7 @@ void DevConsole::BeginFrame()
 //----------------------------------------------------------------------------------------------------------------------
 void DevConsole::EndFrame()
 {
+	m_overlayLines.clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -199,24 +204,29 @@ void DevConsole::Execute( std::string const& consoleCommandText )
 //----------------------------------------------------------------------------------------------------------------------
 void DevConsole::AddLine( Rgba8 const& color, std::string const& text )
 {
-	m_devConsoleMutex.lock();
+	if ( std::this_thread::get_id() != m_ownerThreadID )
+	{
+		AddPendingLine( color, text, false );
+		return;
+	}
+
 	DevConsoleLine devConsoleLine;
 	devConsoleLine.m_color	= color;
 	devConsoleLine.m_text	= text;
 
 	m_lines.push_back( devConsoleLine );
-	m_devConsoleMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void DevConsole::Render( AABB2 const& bounds )
 {
+	AddPendingLinesFromOtherThreads();
+	RenderOverlay( bounds );
 	if ( !m_isOpen )
 	{
 		return;
 	}
 
-	m_devConsoleMutex.lock();
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Begin DevConsole Camera
@@ -301,8 +311,99 @@ void DevConsole::Render( AABB2 const& bounds )
 	//----------------------------------------------------------------------------------------------------------------------
 	// Begin DevConsole Camera
 	m_config.m_renderer->EndCamera( *m_config.m_camera );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DevConsole::AddOverlayLine( Rgba8 const& color, std::string const& text )
+{
+	if ( std::this_thread::get_id() != m_ownerThreadID )
+	{
+		AddPendingLine( color, text, true );
+		return;
+	}
+
+	DevConsoleLine overlayLine;
+	overlayLine.m_color	= color;
+	overlayLine.m_text	= text;
+	m_overlayLines.push_back( overlayLine );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DevConsole::AddPendingLine( Rgba8 const& color, std::string const& text, bool isOverlayLine )
+{
+	PendingLine pendingLine;
+	pendingLine.m_line.m_color		= color;
+	pendingLine.m_line.m_text		= text;
+	pendingLine.m_isOverlayLine		= isOverlayLine;
+	if ( !m_pendingLineQueue.TryPush( std::move( pendingLine ) ) )
+	{
+		// Never block the caller on the main thread catching up
+		m_numDroppedPendingLines++;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DevConsole::AddPendingLinesFromOtherThreads()
+{
+	PendingLine pendingLine;
+	while ( m_pendingLineQueue.TryPop( pendingLine ) )
+	{
+		if ( pendingLine.m_isOverlayLine )
+		{
+			m_overlayLines.push_back( pendingLine.m_line );
+		}
+		else
+		{
+			m_lines.push_back( pendingLine.m_line );
+		}
+	}
 
-	m_devConsoleMutex.unlock();
+	int numDroppedLines = m_numDroppedPendingLines.exchange( 0 );
+	if ( numDroppedLines > 0 )
+	{
+		AddLine( Rgba8::YELLOW, Stringf( "(%d lines from other threads dropped)", numDroppedLines ) );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DevConsole::RenderOverlay( AABB2 const& bounds )
+{
+	if ( m_overlayLines.empty() )
+	{
+		return;
+	}
+
+	m_config.m_renderer->BeginCamera( *m_config.m_camera );
+
+	// Background behind the lines, anchored to the top-left corner
+	float overlayHeight		= m_config.m_cellHeight * float( m_overlayLines.size() );
+	float overlayWidth		= bounds.m_maxs.x - bounds.m_mins.x;
+	AABB2 overlayBounds		= AABB2( bounds.m_mins.x, bounds.m_maxs.y - overlayHeight, bounds.m_mins.x + overlayWidth, bounds.m_maxs.y );
+	std::vector<Vertex_PCU> verts;
+	AddVertsForAABB2D( verts, overlayBounds, Rgba8::TRANSLUCENT_BLACK );
+	m_config.m_renderer->SetBlendMode( BlendMode::ALPHA );
+	m_config.m_renderer->SetModelConstants();
+	m_config.m_renderer->BindTexture( nullptr );
+	m_config.m_renderer->BindShader( nullptr );
+	m_config.m_renderer->DrawVertexArray( static_cast<int>( verts.size() ), verts.data() );
+
+	BitmapFont* bitmapFont = m_config.m_renderer->CreateOrGetBitmapFontFromFile( std::string( "Data/Fonts/" + m_config.m_fontName ).c_str() );
+	std::vector<Vertex_PCU> stringVerts;
+	AABB2 textBounds = AABB2( overlayBounds.m_mins.x, overlayBounds.m_maxs.y - m_config.m_cellHeight, overlayBounds.m_maxs.x, overlayBounds.m_maxs.y );
+	for ( int i = 0; i < m_overlayLines.size(); i++ )
+	{
+		bitmapFont->AddVertsForTextInBox2D( stringVerts, textBounds, m_config.m_cellHeight, m_overlayLines[i].m_text, m_overlayLines[i].m_color, m_config.m_fontAspect, Vec2( 0.0f, 0.0f ) );
+		textBounds.m_mins.y -= m_config.m_cellHeight;
+		textBounds.m_maxs.y -= m_config.m_cellHeight;
+	}
+	m_config.m_renderer->SetBlendMode( BlendMode::ALPHA );
+	m_config.m_renderer->SetModelConstants();
+	m_config.m_renderer->BindShader( nullptr );
+	m_config.m_renderer->BindTexture( &bitmapFont->GetTexture() );
+	m_config.m_renderer->DrawVertexArray( static_cast<int>( stringVerts.size() ), stringVerts.data() );
+	m_config.m_renderer->BindTexture( nullptr );
+
+	m_config.m_renderer->EndCamera( *m_config.m_camera );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
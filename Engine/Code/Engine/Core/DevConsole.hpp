@@ -2,12 +2,14 @@
 
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/MPMCQueue.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/Vec2.hpp"
 
 #include <string>
 #include <vector>
 #include <mutex>
+#include <thread>
 
 //----------------------------------------------------------------------------------------------------------------------
 class	Renderer;
@@ -38,8 +40,12 @@ struct DevConsoleConfig
 	float			m_cellHeight						=  3.0f;
 	float			m_cellWidth							= m_cellHeight * m_fontAspect;
 	int				m_maxCommandHistory					= 128;
+	int				m_pendingLineCapacity				= 1024;					// Lines added off the main thread wait here for the next frame
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+// Lines are owned by the thread that created the DevConsole (the main thread). Other threads hand theirs over through a
+// lock-free queue drained in BeginFrame and Render; if it fills up the extra lines are dropped and counted.
 //----------------------------------------------------------------------------------------------------------------------
 class DevConsole
 {
@@ -54,9 +60,17 @@ public:
 
 	void Execute( std::string const& consoleCommandText );
 	void AddLine( Rgba8 const& color, std::string const& text );
+	void AddOverlayLine( Rgba8 const& color, std::string const& text );		// Top-left of the screen for this frame only, open or not
 	void Render ( AABB2 const& bounds );
 	void ToggleOpen();
 
+protected:
+	void RenderOverlay( AABB2 const& bounds );
+	void AddPendingLine( Rgba8 const& color, std::string const& text, bool isOverlayLine );
+	void AddPendingLinesFromOtherThreads();
+
+public:
+
 //----------------------------------------------------------------------------------------------------------------------
 // 	UNUSED
 //	static const Rgba8 ERROR;
@@ -74,8 +88,18 @@ public:
 	static bool Command_Echo			( EventArgs& args );
 
 protected:
+	struct PendingLine
+	{
+		DevConsoleLine	m_line;
+		bool			m_isOverlayLine = false;
+	};
+
 	DevConsoleConfig				m_config;
 	std::vector<DevConsoleLine>		m_lines;
+	std::vector<DevConsoleLine>		m_overlayLines;
+	std::thread::id					m_ownerThreadID;
+	MPMCQueue<PendingLine>			m_pendingLineQueue;
+	std::atomic<int>				m_numDroppedPendingLines	= 0;
 	std::string						m_inputText;
 	int								m_caretPosition			= 0;
 	bool							m_caretIsVisible		= true;
@@ -85,5 +109,4 @@ protected:
 
 public:
 	std::atomic<bool>				m_isOpen				= false;
-	std::mutex						m_devConsoleMutex;
 };
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Engine/Core/AllocTracker.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Profiler.hpp"
 
 #define UNUSED(x) (void)(x);
 
@@ -1,9 +1,12 @@
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
 EventSystem* g_theEventSystem = nullptr;
 
 //----------------------------------------------------------------------------------------------------------------------
 EventSystem::EventSystem()
+	: m_ownerThreadID( std::this_thread::get_id() )
+	, m_queuedEventQueue( QUEUED_EVENT_CAPACITY )
 {
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -21,6 +24,7 @@ void EventSystem::Shutdown()
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::BeginFrame()
 {
+	FireQueuedEvents();
 }
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::EndFrame()
@@ -30,16 +34,15 @@ void EventSystem::EndFrame()
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::SubscribeToEvent( std::string const& eventName, EventCallbackFuncPtr functionPtr )
 {
-	m_eventSystemMutex.lock();
+	GUARANTEE_OR_DIE( IsOwnerThread(), "EventSystem subscriptions must be made on the main thread" );
 	EventSubscriberList& subscribersForThisEvent = m_subscribersForEventNames[ eventName ];
 	subscribersForThisEvent.push_back( functionPtr );
-	m_eventSystemMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::UnsubscribeFromEvent( std::string const& eventName, EventCallbackFuncPtr functionPtr )
 {
-	m_eventSystemMutex.lock();
+	GUARANTEE_OR_DIE( IsOwnerThread(), "EventSystem subscriptions must be made on the main thread" );
 	EventSubscriberList& subscribersForThisEvent = m_subscribersForEventNames[eventName];
 	for ( int i = 0; i < static_cast<int>( subscribersForThisEvent.size() ); ++i )
 	{
@@ -48,43 +51,40 @@ void EventSystem::UnsubscribeFromEvent( std::string const& eventName, EventCallb
 			subscribersForThisEvent[i] = nullptr;
 		}
 	}
-	m_eventSystemMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::UnsubscribeFromAllEvents( EventCallbackFuncPtr callbackFunc )
 {
-	m_eventSystemMutex.lock();
 	for ( auto eventIter = m_subscribersForEventNames.begin(); eventIter != m_subscribersForEventNames.end(); ++ eventIter)
 	{
 		std::string const& eventName = eventIter->first;
-		m_eventSystemMutex.unlock();
 		UnsubscribeFromEvent( eventName, callbackFunc );
-		m_eventSystemMutex.lock();
 	}
-	m_eventSystemMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::FireEvent( std::string const& eventName, EventArgs& args )
 {
-	m_eventSystemMutex.lock();
+	if ( !IsOwnerThread() )
+	{
+		QueueEvent( eventName, args );
+		return;
+	}
+
 	EventSubscriberList& subscribersForThisEvent = m_subscribersForEventNames[ eventName ];
 	for ( int i = 0; i < subscribersForThisEvent.size(); ++i )
 	{
 		EventCallbackFuncPtr callbackFuncPtr = subscribersForThisEvent[i];
 		if ( callbackFuncPtr != nullptr )
 		{
-			m_eventSystemMutex.unlock();
 			bool wasConsumed = callbackFuncPtr( args );		// Call the subscriber's callback function
-			m_eventSystemMutex.lock();
 			if ( wasConsumed )
 			{
 				break;		// Event was consumed by this subscriber; Don't tell remaining subscribers about the event firing
 			}
 		}
 	}
-	m_eventSystemMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -97,13 +97,66 @@ void EventSystem::FireEvent( std::string const& eventName )
 //----------------------------------------------------------------------------------------------------------------------
 void EventSystem::GetNameOfRegisteredCommands( std::vector<std::string>& out_eventNames )
 {
-	m_eventSystemMutex.lock();
+	GUARANTEE_OR_DIE( IsOwnerThread(), "EventSystem subscriptions must be read on the main thread" );
 	for ( auto eventIter = m_subscribersForEventNames.begin(); eventIter != m_subscribersForEventNames.end(); ++eventIter )
 	{
 		std::string const& eventString = eventIter->first;
 		out_eventNames.push_back( eventString );
 	}
-	m_eventSystemMutex.unlock();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool EventSystem::IsOwnerThread() const
+{
+	return std::this_thread::get_id() == m_ownerThreadID;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventSystem::QueueEvent( std::string const& eventName, EventArgs const& args )
+{
+	QueuedEvent queuedEvent;
+	queuedEvent.m_eventName = eventName;
+	queuedEvent.m_args		= args;
+	if ( m_queuedEventQueue.TryPush( std::move( queuedEvent ) ) )
+	{
+		return;
+	}
+
+	// The main thread hasn't drained a whole ring's worth yet, spill rather than wait on it
+	m_queuedEventOverflowListMutex.lock();
+	m_queuedEventOverflowList.push( queuedEvent );
+	m_numOverflowedQueuedEvents++;
+	m_queuedEventOverflowListMutex.unlock();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventSystem::FireQueuedEvents()
+{
+	// Only what is queued now; events queued by these callbacks wait for next frame
+	int numEventsToFire = m_queuedEventQueue.GetApproxSize();
+	QueuedEvent queuedEvent;
+	for ( int i = 0; i < numEventsToFire; i++ )
+	{
+		if ( !m_queuedEventQueue.TryPop( queuedEvent ) )
+		{
+			break;
+		}
+		FireEvent( queuedEvent.m_eventName, queuedEvent.m_args );
+	}
+
+	if ( m_numOverflowedQueuedEvents > 0 )
+	{
+		m_queuedEventOverflowListMutex.lock();
+		std::queue<QueuedEvent> overflowList;
+		overflowList.swap( m_queuedEventOverflowList );
+		m_numOverflowedQueuedEvents = 0;
+		m_queuedEventOverflowListMutex.unlock();
+		while ( !overflowList.empty() )
+		{
+			FireEvent( overflowList.front().m_eventName, overflowList.front().m_args );
+			overflowList.pop();
+		}
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/MPMCQueue.hpp"
 
 #include <vector>
 #include <string>
 #include <map>
 #include <mutex>
+#include <queue>
+#include <thread>
 
 //----------------------------------------------------------------------------------------------------------------------
 typedef NamedStrings EventArgs;
@@ -16,6 +19,10 @@ typedef std::vector<EventCallbackFuncPtr> EventSubscriberList;
 // typedef std::vector<bool(*)(EventArgs&)> EventSubscriberList;
 // std::function<EventArgs&e>
 //----------------------------------------------------------------------------------------------------------------------
+// Subscribers are only touched by the thread that created the EventSystem (the main thread). Events fired from any
+// other thread are copied into a lock-free queue and fired on the main thread in BeginFrame, so they can't hand back
+// results through their args.
+//----------------------------------------------------------------------------------------------------------------------
 class EventSystem
 {
 public:
@@ -35,11 +42,26 @@ public:
 
 	void GetNameOfRegisteredCommands( std::vector<std::string>& out_eventNames );
 
-	std::mutex m_eventSystemMutex;
+private:
+	bool IsOwnerThread() const;
+	void QueueEvent( std::string const& eventName, EventArgs const& args );
+	void FireQueuedEvents();
 
 private:
+	struct QueuedEvent
+	{
+		std::string		m_eventName;
+		EventArgs		m_args;
+	};
+	static constexpr int QUEUED_EVENT_CAPACITY = 1024;
+
 //	EventSystemConfig								m_config;
 	std::map< std::string, EventSubscriberList >	m_subscribersForEventNames;
+	std::thread::id									m_ownerThreadID;
+	MPMCQueue<QueuedEvent>							m_queuedEventQueue;
+	std::queue<QueuedEvent>							m_queuedEventOverflowList;		// Only used while m_queuedEventQueue is full
+	std::mutex										m_queuedEventOverflowListMutex;
+	std::atomic<int>								m_numOverflowedQueuedEvents = 0;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,188 @@
+#include "Engine/Core/FrameStats.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameStats::FrameStats()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameStats::~FrameStats()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameStats::AddFrame( double frameSeconds, size_t frameCount )
+{
+	double frameMs = frameSeconds * 1000.0;
+	if ( int( m_frameMsList.size() ) < m_windowSize )
+	{
+		m_frameMsList.push_back( frameMs );
+		m_nextFrameIndex = int( m_frameMsList.size() ) % m_windowSize;
+	}
+	else
+	{
+		m_frameMsList[ m_nextFrameIndex ]	= frameMs;
+		m_nextFrameIndex					= ( m_nextFrameIndex + 1 ) % m_windowSize;
+	}
+
+	if ( frameMs > m_hitchThresholdMs && m_maxHitchesKept > 0 )
+	{
+		// The profiler closed its frame just before the clock ticked, so its last tree is this frame's
+		FrameHitch hitch;
+		hitch.m_frameCount		= frameCount;
+		hitch.m_frameMs			= frameMs;
+		hitch.m_profilerFrame	= ProfilerGetLastFrame();
+		if ( int( m_hitchList.size() ) < m_maxHitchesKept )
+		{
+			m_hitchList.push_back( hitch );
+			m_nextHitchIndex = int( m_hitchList.size() ) % m_maxHitchesKept;
+		}
+		else
+		{
+			m_hitchList[ m_nextHitchIndex ]	= hitch;
+			m_nextHitchIndex				= ( m_nextHitchIndex + 1 ) % m_maxHitchesKept;
+		}
+	}
+
+	m_secondsSinceLastLog += frameSeconds;
+	if ( m_logIntervalSeconds > 0.0 && m_secondsSinceLastLog >= m_logIntervalSeconds )
+	{
+		m_secondsSinceLastLog = 0.0;
+		DebuggerPrintf( "%s\n", GetSummaryText().c_str() );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameStats::Clear()
+{
+	m_frameMsList.clear();
+	m_nextFrameIndex		= 0;
+	m_hitchList.clear();
+	m_nextHitchIndex		= 0;
+	m_secondsSinceLastLog	= 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameStatsSummary FrameStats::GetSummary() const
+{
+	FrameStatsSummary summary;
+	summary.m_numFrames = int( m_frameMsList.size() );
+	if ( summary.m_numFrames == 0 )
+	{
+		return summary;
+	}
+
+	m_sortedFrameMsList = m_frameMsList;
+	std::sort( m_sortedFrameMsList.begin(), m_sortedFrameMsList.end() );
+	double totalMs = 0.0;
+	for ( int i = 0; i < m_sortedFrameMsList.size(); i++ )
+	{
+		totalMs += m_sortedFrameMsList[i];
+		if ( m_sortedFrameMsList[i] > m_hitchThresholdMs )
+		{
+			summary.m_numHitches++;
+		}
+	}
+
+	// Nearest rank
+	auto getPercentileMs = [ this ]( double percentile )
+	{
+		int rank = int( ceil( percentile * double( m_sortedFrameMsList.size() ) ) ) - 1;
+		rank	 = std::max( 0, std::min( rank, int( m_sortedFrameMsList.size() ) - 1 ) );
+		return m_sortedFrameMsList[ rank ];
+	};
+	summary.m_avgMs	= totalMs / double( summary.m_numFrames );
+	summary.m_p50Ms	= getPercentileMs( 0.50 );
+	summary.m_p95Ms	= getPercentileMs( 0.95 );
+	summary.m_p99Ms	= getPercentileMs( 0.99 );
+	summary.m_maxMs	= m_sortedFrameMsList.back();
+	return summary;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string FrameStats::GetSummaryText() const
+{
+	FrameStatsSummary summary = GetSummary();
+	return Stringf( "Frames %d  avg %.2f ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms  hitches %d (> %.1f ms)",
+					summary.m_numFrames, summary.m_avgMs, summary.m_p50Ms, summary.m_p95Ms, summary.m_p99Ms, summary.m_maxMs, summary.m_numHitches, m_hitchThresholdMs );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int FrameStats::GetNumHitches() const
+{
+	return int( m_hitchList.size() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameHitch const& FrameStats::GetHitch( int hitchesAgo ) const
+{
+	GUARANTEE_OR_DIE( hitchesAgo >= 0 && hitchesAgo < m_hitchList.size(), "FrameStats::GetHitch index out of range" );
+	int numHitches	= int( m_hitchList.size() );
+	int hitchIndex	= ( m_nextHitchIndex - 1 - hitchesAgo + ( 2 * numHitches ) ) % numHitches;
+	return m_hitchList[ hitchIndex ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int FrameStats::GetNumFrames() const
+{
+	return int( m_frameMsList.size() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double FrameStats::GetFrameMs( int framesAgo ) const
+{
+	GUARANTEE_OR_DIE( framesAgo >= 0 && framesAgo < m_frameMsList.size(), "FrameStats::GetFrameMs index out of range" );
+	int numFrames	= int( m_frameMsList.size() );
+	int frameIndex	= ( m_nextFrameIndex - 1 - framesAgo + ( 2 * numFrames ) ) % numFrames;
+	return m_frameMsList[ frameIndex ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_FrameStats( NamedStrings& args )
+{
+	FrameStats& frameStats = Clock::GetSystemFrameStats();
+
+	float thresholdMs = args.GetValue( "threshold", -1.0f );
+	if ( thresholdMs > 0.0f )
+	{
+		frameStats.m_hitchThresholdMs = thresholdMs;
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Hitch threshold set to %.1f ms", thresholdMs ) );
+		return true;
+	}
+
+	int hitchNumber = args.GetValue( "hitch", 0 );
+	if ( hitchNumber > 0 )
+	{
+		if ( hitchNumber > frameStats.GetNumHitches() )
+		{
+			g_theDevConsole->AddLine( Rgba8::RED, Stringf( "Only %d hitches recorded", frameStats.GetNumHitches() ) );
+			return true;
+		}
+		FrameHitch const& hitch = frameStats.GetHitch( hitchNumber - 1 );
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Hitch at frame %d: %.2f ms", int( hitch.m_frameCount ), hitch.m_frameMs ) );
+		ProfilerFrame const& profilerFrame = hitch.m_profilerFrame;
+		for ( int i = 0; i < profilerFrame.m_nodeList.size(); i++ )
+		{
+			ProfilerNode const& node	= profilerFrame.m_nodeList[i];
+			std::string indentedName	= std::string( node.m_depth * 2, ' ' ) + node.m_name;
+			g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %-48s %8.3f ms  self %8.3f ms  x%d", indentedName.c_str(), node.m_totalMs, node.m_selfMs, node.m_numCalls ) );
+		}
+		return true;
+	}
+
+	g_theDevConsole->AddLine( Rgba8::GREEN, frameStats.GetSummaryText() );
+	for ( int i = 0; i < frameStats.GetNumHitches(); i++ )
+	{
+		FrameHitch const& hitch = frameStats.GetHitch( i );
+		g_theDevConsole->AddLine( Rgba8::YELLOW, Stringf( "  hitch=%d  frame %d  %.2f ms", i + 1, int( hitch.m_frameCount ), hitch.m_frameMs ) );
+	}
+	return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Engine/Core/Profiler.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct FrameStatsSummary
+{
+	int		m_numFrames		= 0;		// In the window
+	double	m_avgMs			= 0.0;
+	double	m_p50Ms			= 0.0;
+	double	m_p95Ms			= 0.0;
+	double	m_p99Ms			= 0.0;
+	double	m_maxMs			= 0.0;
+	int		m_numHitches	= 0;		// In the window
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct FrameHitch
+{
+	size_t			m_frameCount	= 0;		// Clock frame count when it was flagged
+	double			m_frameMs		= 0.0;
+	ProfilerFrame	m_profilerFrame;			// Scope tree of the hitch frame, empty if the profiler is off
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rolling window of real frame durations, before Clock clamps them to m_maxDeltaNanoseconds. The system clock feeds one
+// of these every tick (Clock::GetSystemFrameStats). Frames over the hitch threshold keep a copy of the profiler's
+// tree for that frame, and a summary line goes to the debugger output every m_logIntervalSeconds.
+//----------------------------------------------------------------------------------------------------------------------
+class FrameStats
+{
+public:
+	FrameStats();
+	~FrameStats();
+
+	void				AddFrame( double frameSeconds, size_t frameCount );
+	void				Clear();
+	FrameStatsSummary	GetSummary() const;
+	std::string			GetSummaryText() const;
+	int					GetNumHitches() const;
+	FrameHitch const&	GetHitch( int hitchesAgo ) const;		// 0 is the most recent
+	int					GetNumFrames() const;
+	double				GetFrameMs( int framesAgo ) const;		// 0 is the most recent
+
+public:
+	int					m_windowSize			= 600;				// Frames
+	double				m_hitchThresholdMs		= 1000.0 / 30.0;
+	int					m_maxHitchesKept		= 16;
+	double				m_logIntervalSeconds	= 10.0;				// 0 or less turns the periodic log off
+
+private:
+	std::vector<double>		m_frameMsList;						// Ring, m_windowSize long once full
+	int						m_nextFrameIndex			= 0;
+	std::vector<FrameHitch>	m_hitchList;						// Ring, m_maxHitchesKept long once full
+	int						m_nextHitchIndex			= 0;
+	double					m_secondsSinceLastLog		= 0.0;
+	mutable std::vector<double>	m_sortedFrameMsList;				// Scratch for GetSummary
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// "framestats" prints the summary and recent hitches; "framestats hitch=1" prints the newest hitch's scope tree;
+// "framestats threshold=50" sets the hitch threshold in ms
+bool Command_FrameStats( NamedStrings& args );
@@ -0,0 +1,92 @@
+#include "Engine/Core/JobDeque.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobDeque::JobDeque()
+{
+	for ( int i = 0; i < CAPACITY; i++ )
+	{
+		m_slotList[i].store( nullptr, std::memory_order_relaxed );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobDeque::~JobDeque()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobDeque::Push( Job* job )
+{
+	int64_t bottom	= m_bottom.load( std::memory_order_relaxed );
+	int64_t top		= m_top.load( std::memory_order_acquire );
+	if ( ( bottom - top ) >= CAPACITY )
+	{
+		return false;
+	}
+	m_slotList[ bottom & ( CAPACITY - 1 ) ].store( job, std::memory_order_relaxed );
+	// Publish the slot before the new bottom makes it visible to thieves
+	std::atomic_thread_fence( std::memory_order_release );
+	m_bottom.store( bottom + 1, std::memory_order_relaxed );
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Job* JobDeque::Pop()
+{
+	int64_t bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+	m_bottom.store( bottom, std::memory_order_relaxed );
+	// Thieves must see the reserved bottom before we read top
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	int64_t top = m_top.load( std::memory_order_relaxed );
+	if ( top > bottom )
+	{
+		// Empty, undo the reservation
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	Job* job = m_slotList[ bottom & ( CAPACITY - 1 ) ].load( std::memory_order_relaxed );
+	if ( top == bottom )
+	{
+		// Last job, race the thieves for it
+		if ( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		{
+			job = nullptr;
+		}
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+	}
+	return job;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Job* JobDeque::Steal()
+{
+	int64_t top = m_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	int64_t bottom = m_bottom.load( std::memory_order_acquire );
+	if ( top >= bottom )
+	{
+		return nullptr;
+	}
+
+	Job* job = m_slotList[ top & ( CAPACITY - 1 ) ].load( std::memory_order_relaxed );
+	if ( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+	{
+		// Lost to the owner or another thief
+		return nullptr;
+	}
+	return job;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+int JobDeque::GetApproxNumJobs() const
+{
+	int64_t numJobs = m_bottom.load( std::memory_order_relaxed ) - m_top.load( std::memory_order_relaxed );
+	return ( numJobs > 0 ) ? int( numJobs ) : 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+class Job;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed-size Chase-Lev work-stealing deque (Le et al. 2013, "Correct and Efficient Work-Stealing for Weak Memory Models").
+// Only the owning thread may Push/Pop, at the bottom (LIFO, cache-warm); any thread may Steal from the top (FIFO).
+// Push fails when full; the caller falls back to the shared queue rather than the deque growing.
+//----------------------------------------------------------------------------------------------------------------------
+class JobDeque
+{
+public:
+	JobDeque();
+	~JobDeque();
+
+	bool Push( Job* job );					// Owner only
+	Job* Pop();								// Owner only
+	Job* Steal();							// Any thread
+	int	 GetApproxNumJobs() const;
+
+public:
+	static constexpr int64_t CAPACITY	= 4096;	// Power of two
+	unsigned int			 m_victimSeed	= 0;	// Owner only, picks who to steal from next
+
+private:
+	alignas( 64 ) std::atomic<int64_t>	m_top		= 0;
+	alignas( 64 ) std::atomic<int64_t>	m_bottom	= 0;
+	alignas( 64 ) std::atomic<Job*>		m_slotList[ CAPACITY ];
+};
@@ -0,0 +1,78 @@
+#include "Engine/Core/JobGraph.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobGraph::JobGraph()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobGraph::~JobGraph()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobGraph::AddJob( Job* job )
+{
+	GUARANTEE_OR_DIE( IsDone(), "JobGraph::AddJob called while the graph is running" );
+	m_jobList.push_back( job );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobGraph::AddDependency( Job* job, Job* dependsOnJob )
+{
+	GUARANTEE_OR_DIE( IsDone(), "JobGraph::AddDependency called while the graph is running" );
+	dependsOnJob->AddContinuation( job );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobGraph::Run( JobSystem* jobSystem )
+{
+	GUARANTEE_OR_DIE( IsDone(), "JobGraph::Run called while the graph is still running" );
+
+	// Count every job up front, otherwise the first jobs to finish could drain the counter before the rest are posted
+	m_counter.m_numJobsRemaining += int( m_jobList.size() );
+	for ( int i = 0; i < m_jobList.size(); i++ )
+	{
+		m_jobList[i]->m_signalCounter = &m_counter;
+	}
+	for ( int i = 0; i < m_jobList.size(); i++ )
+	{
+		jobSystem->SubmitJob( m_jobList[i] );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobGraph::Wait( JobSystem* jobSystem )
+{
+	jobSystem->WaitFor( m_counter );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobGraph::IsDone() const
+{
+	return m_counter.IsDone();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobGraph::Clear()
+{
+	GUARANTEE_OR_DIE( IsDone(), "JobGraph::Clear called while the graph is running" );
+	for ( int i = 0; i < m_jobList.size(); i++ )
+	{
+		Job* job						= m_jobList[i];
+		job->m_signalCounter			= nullptr;
+		job->m_numDependencies			= 0;
+		job->m_numPendingDependencies	= 1;
+		job->m_continuationList.clear();
+	}
+	m_jobList.clear();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// A set of jobs with "run B after A" links, posted together and waited on through one counter.
+// The graph does not own its jobs. Links persist between runs, so a frame's stages can be built once and re-run
+// every frame; Clear() before relinking. Links must not form a cycle.
+//----------------------------------------------------------------------------------------------------------------------
+class JobGraph
+{
+public:
+	JobGraph();
+	~JobGraph();
+
+	void AddJob( Job* job );
+	void AddDependency( Job* job, Job* dependsOnJob );		// Both must already be in the graph
+	void Run( JobSystem* jobSystem );						// Jobs start as soon as their dependencies finish
+	void Wait( JobSystem* jobSystem );						// Caller helps out with queued jobs until the whole graph is done
+	bool IsDone() const;
+	void Clear();											// Forgets the jobs and their links, does not delete them
+
+public:
+	std::vector<Job*>	m_jobList;
+	JobCounter			m_counter;
+};
@@ -1,45 +1,710 @@
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <immintrin.h>
+#include <math.h>
 
 //----------------------------------------------------------------------------------------------------------------------
 JobSystem* g_theJobSystem = nullptr;
 
+//----------------------------------------------------------------------------------------------------------------------
+// Set once by each worker thread; the main thread is recognised by its thread id instead, since it may drive
+// more than one JobSystem (the benchmark spins up its own)
+//----------------------------------------------------------------------------------------------------------------------
+static thread_local JobSystem*	t_workerJobSystem	= nullptr;
+static thread_local int			t_workerDequeIndex	= -1;
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobCounter::IsDone() const
+{
+	return ( m_numJobsRemaining == 0 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Job::AddContinuation( Job* continuation )
+{
+	m_continuationList.push_back( continuation );
+	continuation->m_numDependencies++;
+	continuation->m_numPendingDependencies++;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameJob::FrameJob()
+{
+	m_isFrameJob	= true;
+	m_name			= "FrameJob";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameJob::Execute()
+{
+	m_invokeAndDestroy( m_callableStorage );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::Startup()
 {
+	BuildWorkerCpuSlots();
 	int numWorkers = m_config.m_preferredNumberOfWorkers;
 	if ( numWorkers < 0 )
 	{
-		int numCpuCores = std::thread::hardware_concurrency();
-		numWorkers = numCpuCores - 1;
+		numWorkers = int( m_workerCpuSlotList.size() );
+		if ( numWorkers == 0 )
+		{
+			// Topology unreadable, fall back to counting logical CPUs
+			int numCpuCores = std::thread::hardware_concurrency();
+			numWorkers = numCpuCores - m_config.m_numReservedCores;
+		}
+		numWorkers = ( numWorkers > 1 ) ? numWorkers : 1;
+	}
+	if ( m_config.m_pinMainThread )
+	{
+		PinCurrentThreadToReservedCore( 0 );
+	}
+
+	// Deques must exist before any worker starts stealing from them
+	for ( int priority = 0; priority < NUM_JOB_PRIORITIES; priority++ )
+	{
+		for ( int i = 0; i < numWorkers + 1; i++ )
+		{
+			JobDeque* deque		= new JobDeque();
+			deque->m_victimSeed	= 0x9E3779B9u * ( ( i * NUM_JOB_PRIORITIES ) + priority + 1 );
+			m_dequeList[ priority ].push_back( deque );
+		}
+		m_numUnclaimedJobs[ priority ] = 0;
 	}
+	m_maxConcurrentBackgroundJobs = m_config.m_maxConcurrentBackgroundJobs;
+	if ( m_maxConcurrentBackgroundJobs < 0 )
+	{
+		m_maxConcurrentBackgroundJobs = ( numWorkers > 1 ) ? ( numWorkers - 1 ) : 1;
+	}
+	if ( m_config.m_frameClock == nullptr )
+	{
+		m_config.m_frameClock = &Clock::GetSystemClock();
+	}
+	if ( m_config.m_taskClock == nullptr )
+	{
+		m_config.m_taskClock = &Clock::GetSystemClock();
+	}
+	for ( int i = 0; i < numWorkers + 1; i++ )
+	{
+		JobThreadTelemetry* telemetry	= new JobThreadTelemetry();
+		telemetry->m_threadName			= ( i == numWorkers ) ? std::string( "Main" ) : Stringf( "%s %d", m_config.m_workerThreadNamePrefix.c_str(), i );
+		m_telemetryList.push_back( telemetry );
+	}
+	m_prevTelemetrySnapshotList.resize( numWorkers + 1 );
+	m_lastFrameStatsSeconds = GetCurrentTimeSeconds();
+
+	m_mainThreadID		= std::this_thread::get_id();
+	m_mainDequeIndex	= numWorkers;
+	m_frameJobPool		= new FrameJob[ m_config.m_maxFrameJobsPerFrame ];
 	CreateNewWorkers( numWorkers );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::BeginFrame()
 {
+	// Background jobs held back near the end of last frame can go again
+	if ( HasQueuedJobs( JOB_PRIORITY_BACKGROUND ) )
+	{
+		WakeAllIdleWorkers();
+	}
+	ResumeReadyTasks();
+
+	if ( m_isOverlayVisible )
+	{
+		AddOverlayLines();
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::EndFrame()
 {
+	if ( m_isTelemetryEnabled )
+	{
+		UpdateFrameStats();
+	}
+
+	// Frame jobs still running would have their slots handed out again under them. Close the pool first so a
+	// post from a worker (a Task resume, background work) can't take a slot between the drain and the reset
+	m_isReclaimingFrameJobs = true;
+	while ( m_numFrameJobsInFlight > 0 )
+	{
+		if ( !ExecuteOneJob( true ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+	m_numFrameJobsAllocated = 0;
+	m_isReclaimingFrameJobs = false;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::Shutdown()
 {
 	m_isQuitting = true;
+	WakeAllIdleWorkers();
 	DestroyAllWorkers();
+	for ( int priority = 0; priority < NUM_JOB_PRIORITIES; priority++ )
+	{
+		for ( int i = 0; i < m_dequeList[ priority ].size(); i++ )
+		{
+			delete m_dequeList[ priority ][i];
+		}
+		m_dequeList[ priority ].clear();
+	}
+	m_mainDequeIndex = -1;
+
+	for ( int i = 0; i < m_telemetryList.size(); i++ )
+	{
+		delete m_telemetryList[i];
+	}
+	m_telemetryList.clear();
+
+	delete[] m_frameJobPool;
+	m_frameJobPool = nullptr;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void JobSystem::PostNewJob( Job* newJob )
+void JobSystem::PostNewJob( Job* newJob, JobCounter* counter )
 {
-	m_unclaimedJobsListMutex.lock();
-	m_unclaimedJobsList.push( newJob );
-	newJob->m_jobStatus = JOB_STATUS_QUEUED;
-	m_unclaimedJobsListMutex.unlock();
+	newJob->m_signalCounter = counter;
+	if ( counter != nullptr )
+	{
+		counter->m_numJobsRemaining++;
+	}
+	SubmitJob( newJob );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::SubmitJob( Job* job )
+{
+	// Whoever drops the last reference (this post or the last dependency to finish) queues the job
+	job->m_jobStatus = JOB_STATUS_BLOCKED;
+	if ( --job->m_numPendingDependencies == 0 )
+	{
+		EnqueueJob( job );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::EnqueueJob( Job* job )
+{
+	// Re-arm for the next post, so a graph can be run again every frame
+	job->m_numPendingDependencies = 1 + job->m_numDependencies;
+
+	// Status first, a thief may claim it the moment it is pushed
+	job->m_readySeconds	= m_isTelemetryEnabled ? GetCurrentTimeSeconds() : 0.0;
+	job->m_jobStatus	= JOB_STATUS_QUEUED;
+	int priority	 = job->m_priority;
+	int dequeIndex	 = GetLocalDequeIndex();
+	if ( dequeIndex < 0 || !m_dequeList[ priority ][ dequeIndex ]->Push( job ) )
+	{
+		m_unclaimedJobsListMutex.lock();
+		m_unclaimedJobsList[ priority ].push( job );
+		m_numUnclaimedJobs[ priority ]++;
+		m_unclaimedJobsListMutex.unlock();
+	}
+	WakeOneIdleWorker();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::ExecuteOneJob( bool isCallerBlocked )
+{
+	int	 dequeIndex	= GetLocalDequeIndex();
+	Job* jobToDo	= ClaimJobForWorkerThread( dequeIndex, isCallerBlocked );
+	if ( jobToDo == nullptr )
+	{
+		return false;
+	}
+	PROFILE_SCOPE( jobToDo->m_name );
+	if ( !m_isTelemetryEnabled || dequeIndex < 0 )
+	{
+		jobToDo->Execute();
+		FinishJob( jobToDo );
+		return true;
+	}
+
+	// Read everything up front, the job may be freed by its owner as soon as FinishJob signals it
+	char const* name		 = jobToDo->m_name;
+	int			priority	 = jobToDo->m_priority;
+	double		startSeconds = GetCurrentTimeSeconds();
+	double		readySeconds = ( jobToDo->m_readySeconds > 0.0 ) ? jobToDo->m_readySeconds : startSeconds;		// Queued before telemetry was on
+	jobToDo->Execute();
+	double		endSeconds	 = GetCurrentTimeSeconds();
+	m_telemetryList[ dequeIndex ]->RecordJob( name, priority, readySeconds, startSeconds, endSeconds, m_telemetryFrameIndex, m_isCapturingTrace );
+	FinishJob( jobToDo );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::FinishJob( Job* job )
+{
+	// Continuations first, the owner may free every job in the graph as soon as the counter reaches zero
+	for ( int i = 0; i < job->m_continuationList.size(); i++ )
+	{
+		Job* continuation = job->m_continuationList[i];
+		if ( --continuation->m_numPendingDependencies == 0 )
+		{
+			EnqueueJob( continuation );
+		}
+	}
+
+	if ( job->m_priority == JOB_PRIORITY_BACKGROUND )
+	{
+		// A slot under the cap just freed up; workers that parked on throttled background jobs won't look again
+		// until something else wakes them
+		m_numBackgroundJobsRunning--;
+		if ( HasQueuedJobs( JOB_PRIORITY_BACKGROUND ) && !IsNearFrameDeadline() )
+		{
+			WakeOneIdleWorker();
+		}
+	}
+
+	JobCounter* counter = job->m_signalCounter;
+	if ( counter == nullptr && !job->m_isFrameJob )
+	{
+		AddJobToCompletedList( job );
+		return;
+	}
+	bool isFrameJob		= job->m_isFrameJob;
+	job->m_jobStatus	= JOB_STATUS_COMPLETED;
+	if ( counter != nullptr )
+	{
+		counter->m_numJobsRemaining--;
+	}
+	if ( isFrameJob )
+	{
+		m_numFrameJobsInFlight--;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WaitUntilJobIsCompleted( Job* job )
+{
+	while ( job->m_jobStatus != JOB_STATUS_COMPLETED && job->m_jobStatus != JOB_STATUS_RETRIEVED )
+	{
+		if ( !ExecuteOneJob( true ) )
+		{
+			// Nothing left to help with, the job is running on a worker
+			std::this_thread::yield();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WaitFor( JobCounter const& counter )
+{
+	PROFILE_SCOPE( "JobSystem::WaitFor" );
+	while ( !counter.IsDone() )
+	{
+		if ( !ExecuteOneJob( true ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::HasQueuedJobs( JobPriority priority ) const
+{
+	if ( m_numUnclaimedJobs[ priority ] > 0 )
+	{
+		return true;
+	}
+	for ( int i = 0; i < m_dequeList[ priority ].size(); i++ )
+	{
+		if ( m_dequeList[ priority ][i]->GetApproxNumJobs() > 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::HasQueuedJobs() const
+{
+	if ( HasQueuedJobs( JOB_PRIORITY_FRAME_CRITICAL ) || HasQueuedJobs( JOB_PRIORITY_NORMAL ) )
+	{
+		return true;
+	}
+	// Throttled background jobs don't count, or idle workers would spin on them until the next frame
+	return CanStartBackgroundJob( GetLocalDequeIndex() ) && HasQueuedJobs( JOB_PRIORITY_BACKGROUND );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::IsNearFrameDeadline() const
+{
+	int64_t frameStartNanoseconds	= m_config.m_frameClock->GetLastUpdateTimeNanoseconds();
+	int64_t frameElapsedNanoseconds	= GetCurrentTimeNanoseconds() - frameStartNanoseconds;
+	return frameElapsedNanoseconds > SecondsToNanoseconds( m_config.m_targetFrameSeconds * m_config.m_backgroundCutoffFraction );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::CanStartBackgroundJob( int dequeIndex ) const
+{
+	// The main thread only ever helps with frame work
+	if ( dequeIndex < 0 || dequeIndex == m_mainDequeIndex )
+	{
+		return false;
+	}
+	if ( m_numBackgroundJobsRunning >= m_maxConcurrentBackgroundJobs )
+	{
+		return false;
+	}
+	return !IsNearFrameDeadline();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WaitForWork()
+{
+	// Spin first, most gaps between jobs are shorter than a trip through the scheduler
+	for ( int i = 0; i < m_config.m_numIdleSpins; i++ )
+	{
+		if ( HasQueuedJobs() || IsQuitting() )
+		{
+			return;
+		}
+		_mm_pause();
+	}
+	for ( int i = 0; i < m_config.m_numIdleYields; i++ )
+	{
+		if ( HasQueuedJobs() || IsQuitting() )
+		{
+			return;
+		}
+		std::this_thread::yield();
+	}
+
+	// Park. The sleeper count goes up before the final queue check, and posters bump the epoch under the same
+	// mutex after checking the count, so a job posted in between can't be missed
+	std::unique_lock<std::mutex> idleLock( m_idleMutex );
+	m_numSleepingWorkers++;
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	unsigned int wakeEpoch = m_wakeEpoch;
+	if ( !HasQueuedJobs() && !IsQuitting() )
+	{
+		int dequeIndex = GetLocalDequeIndex();
+		if ( m_isTelemetryEnabled && dequeIndex >= 0 )
+		{
+			m_telemetryList[ dequeIndex ]->RecordPark();
+		}
+		m_idleCondition.wait( idleLock, [this, wakeEpoch]() { return m_wakeEpoch != wakeEpoch || IsQuitting(); } );
+	}
+	m_numSleepingWorkers--;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WakeOneIdleWorker()
+{
+	// Cheap when everyone is busy; only posts that find a sleeper touch the mutex
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( m_numSleepingWorkers == 0 )
+	{
+		return;
+	}
+	m_idleMutex.lock();
+	m_wakeEpoch++;
+	m_idleMutex.unlock();
+	m_idleCondition.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WakeAllIdleWorkers()
+{
+	m_idleMutex.lock();
+	m_wakeEpoch++;
+	m_idleMutex.unlock();
+	m_idleCondition.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int JobSystem::GetNumWorkers() const
+{
+	return int( m_workerList.size() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::ResumeTaskOnWorker( std::coroutine_handle<> task )
+{
+	PostFrameJob( [task]() { task.resume(); } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::ResumeTaskOnMainThread( std::coroutine_handle<> task, double resumeTimeSeconds, JobCounter const* counter )
+{
+	SuspendedTask suspendedTask;
+	suspendedTask.m_handle				= task;
+	suspendedTask.m_resumeTimeSeconds	= resumeTimeSeconds;
+	suspendedTask.m_counter				= counter;
+	m_suspendedTaskListMutex.lock();
+	m_suspendedTaskList.push_back( suspendedTask );
+	m_suspendedTaskListMutex.unlock();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::ResumeReadyTasks()
+{
+	// Pull the ready ones out first, resumed tasks may suspend again and push back onto the list
+	double currentTimeSeconds = GetTaskClockSeconds();
+	m_readyTaskList.clear();
+	m_suspendedTaskListMutex.lock();
+	int numStillSuspended = 0;
+	for ( int i = 0; i < m_suspendedTaskList.size(); i++ )
+	{
+		SuspendedTask const& suspendedTask	= m_suspendedTaskList[i];
+		bool isTimeUp						= suspendedTask.m_resumeTimeSeconds <= currentTimeSeconds;
+		bool isCounterDone					= ( suspendedTask.m_counter == nullptr ) || suspendedTask.m_counter->IsDone();
+		if ( isTimeUp && isCounterDone )
+		{
+			m_readyTaskList.push_back( suspendedTask );
+		}
+		else
+		{
+			// Compact in place, tasks keep resuming in the order they suspended
+			m_suspendedTaskList[ numStillSuspended ] = suspendedTask;
+			numStillSuspended++;
+		}
+	}
+	m_suspendedTaskList.resize( numStillSuspended );
+	m_suspendedTaskListMutex.unlock();
+
+	for ( int i = 0; i < m_readyTaskList.size(); i++ )
+	{
+		m_readyTaskList[i].m_handle.resume();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double JobSystem::GetTaskClockSeconds() const
+{
+	return NanosecondsToSeconds( m_config.m_taskClock->GetTotalNanoseconds() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::SetOverlayVisible( bool isVisible )
+{
+	m_isOverlayVisible = isVisible;
+	UpdateTelemetryEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::IsOverlayVisible() const
+{
+	return m_isOverlayVisible;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::SetTelemetryRequested( bool isRequested )
+{
+	m_isTelemetryRequested = isRequested;
+	UpdateTelemetryEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::StartTraceCapture( int numFrames, std::string const& filePath )
+{
+	m_numTraceFramesLeft	= ( numFrames > 0 ) ? numFrames : 1;
+	m_traceFilePath			= filePath;
+	m_traceFrameEndList.clear();
+	m_traceFrameEndList.push_back( GetCurrentTimeSeconds() );
+	m_traceFirstEventIndexList.clear();
+	for ( int i = 0; i < m_telemetryList.size(); i++ )
+	{
+		m_traceFirstEventIndexList.push_back( m_telemetryList[i]->m_numTraceEvents.load( std::memory_order_acquire ) );
+	}
+	m_isCapturingTrace = true;
+	UpdateTelemetryEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+JobSystemFrameStats const& JobSystem::GetLastFrameStats() const
+{
+	return m_lastFrameStats;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::UpdateTelemetryEnabled()
+{
+	bool wasEnabled			= m_isTelemetryEnabled;
+	m_isTelemetryEnabled	= m_isOverlayVisible || m_isCapturingTrace || m_isTelemetryRequested;
+	if ( !wasEnabled && m_isTelemetryEnabled )
+	{
+		// Counters kept running while off would otherwise land in the first frame
+		m_lastFrameStatsSeconds = GetCurrentTimeSeconds();
+		for ( int i = 0; i < m_telemetryList.size(); i++ )
+		{
+			JobThreadTelemetry const& telemetry		= *m_telemetryList[i];
+			ThreadTelemetrySnapshot& snapshot		= m_prevTelemetrySnapshotList[i];
+			snapshot.m_numJobsRun					= telemetry.m_numJobsRun;
+			snapshot.m_numStealAttempts				= telemetry.m_numStealAttempts;
+			snapshot.m_numSteals					= telemetry.m_numSteals;
+			snapshot.m_numParks						= telemetry.m_numParks;
+			snapshot.m_busySeconds					= telemetry.m_busySeconds;
+			snapshot.m_queueSeconds					= telemetry.m_queueSeconds;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int JobSystem::GetApproxNumQueuedJobs( JobPriority priority ) const
+{
+	int numQueuedJobs = m_numUnclaimedJobs[ priority ];
+	for ( int i = 0; i < m_dequeList[ priority ].size(); i++ )
+	{
+		numQueuedJobs += m_dequeList[ priority ][i]->GetApproxNumJobs();
+	}
+	return numQueuedJobs;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::UpdateFrameStats()
+{
+	double currentSeconds	= GetCurrentTimeSeconds();
+	double frameSeconds		= currentSeconds - m_lastFrameStatsSeconds;
+	m_lastFrameStatsSeconds	= currentSeconds;
+	int frameIndex			= m_telemetryFrameIndex;
+
+	JobSystemFrameStats& stats	= m_lastFrameStats;
+	stats						= JobSystemFrameStats();
+	stats.m_frameSeconds		= float( frameSeconds );
+	for ( int priority = 0; priority < NUM_JOB_PRIORITIES; priority++ )
+	{
+		stats.m_queueDepthList.push_back( GetApproxNumQueuedJobs( JobPriority( priority ) ) );
+	}
+
+	double totalQueueSeconds	= 0.0;
+	double totalBusySeconds		= 0.0;
+	for ( int i = 0; i < m_telemetryList.size(); i++ )
+	{
+		JobThreadTelemetry const& telemetry	= *m_telemetryList[i];
+		ThreadTelemetrySnapshot current;
+		current.m_numJobsRun		= telemetry.m_numJobsRun;
+		current.m_numStealAttempts	= telemetry.m_numStealAttempts;
+		current.m_numSteals			= telemetry.m_numSteals;
+		current.m_numParks			= telemetry.m_numParks;
+		current.m_busySeconds		= telemetry.m_busySeconds;
+		current.m_queueSeconds		= telemetry.m_queueSeconds;
+		ThreadTelemetrySnapshot& prev = m_prevTelemetrySnapshotList[i];
+
+		JobThreadFrameStats threadStats;
+		threadStats.m_numJobsRun		= current.m_numJobsRun		 - prev.m_numJobsRun;
+		threadStats.m_numStealAttempts	= current.m_numStealAttempts - prev.m_numStealAttempts;
+		threadStats.m_numSteals			= current.m_numSteals		 - prev.m_numSteals;
+		threadStats.m_numParks			= current.m_numParks		 - prev.m_numParks;
+		threadStats.m_utilization		= ( frameSeconds > 0.0 ) ? float( ( current.m_busySeconds - prev.m_busySeconds ) / frameSeconds ) : 0.0f;
+		stats.m_threadStatsList.push_back( threadStats );
+
+		stats.m_numJobsRun += threadStats.m_numJobsRun;
+		totalBusySeconds   += current.m_busySeconds  - prev.m_busySeconds;
+		totalQueueSeconds  += current.m_queueSeconds - prev.m_queueSeconds;
+		if ( telemetry.m_maxFrameIndex == frameIndex )
+		{
+			float maxQueueMs = float( telemetry.m_maxQueueSeconds * 1000.0 );
+			float maxRunMs	 = float( telemetry.m_maxRunSeconds	  * 1000.0 );
+			stats.m_maxQueueMs = ( maxQueueMs > stats.m_maxQueueMs ) ? maxQueueMs : stats.m_maxQueueMs;
+			stats.m_maxRunMs   = ( maxRunMs	  > stats.m_maxRunMs   ) ? maxRunMs	  : stats.m_maxRunMs;
+		}
+		prev = current;
+	}
+	if ( stats.m_numJobsRun > 0 )
+	{
+		stats.m_avgQueueMs	= float( totalQueueSeconds * 1000.0 / stats.m_numJobsRun );
+		stats.m_avgRunMs	= float( totalBusySeconds  * 1000.0 / stats.m_numJobsRun );
+	}
+	m_telemetryFrameIndex++;
+
+	if ( m_isCapturingTrace )
+	{
+		m_traceFrameEndList.push_back( currentSeconds );
+		m_numTraceFramesLeft--;
+		if ( m_numTraceFramesLeft <= 0 )
+		{
+			m_isCapturingTrace = false;
+			UpdateTelemetryEnabled();
+			WriteTraceCapture();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::AddOverlayLines() const
+{
+	if ( g_theDevConsole == nullptr )
+	{
+		return;
+	}
+	JobSystemFrameStats const& stats = m_lastFrameStats;
+	g_theDevConsole->AddOverlayLine( Rgba8::WHITE, Stringf( "JobSystem  frame %.2f ms  jobs %d", stats.m_frameSeconds * 1000.0f, stats.m_numJobsRun ) );
+	g_theDevConsole->AddOverlayLine( Rgba8::WHITE, Stringf( "  queue avg %.3f ms max %.3f ms   run avg %.3f ms max %.3f ms", stats.m_avgQueueMs, stats.m_maxQueueMs, stats.m_avgRunMs, stats.m_maxRunMs ) );
+	if ( stats.m_queueDepthList.size() == NUM_JOB_PRIORITIES )
+	{
+		g_theDevConsole->AddOverlayLine( Rgba8::WHITE, Stringf( "  queued  critical %d  normal %d  background %d", stats.m_queueDepthList[ JOB_PRIORITY_FRAME_CRITICAL ], stats.m_queueDepthList[ JOB_PRIORITY_NORMAL ], stats.m_queueDepthList[ JOB_PRIORITY_BACKGROUND ] ) );
+	}
+	for ( int i = 0; i < stats.m_threadStatsList.size() && i < m_telemetryList.size(); i++ )
+	{
+		JobThreadFrameStats const& threadStats = stats.m_threadStatsList[i];
+		Rgba8 color = ( threadStats.m_utilization > 0.9f ) ? Rgba8::RED : Rgba8::GREEN;
+		g_theDevConsole->AddOverlayLine( color, Stringf( "  %-9s busy %3d%%  jobs %4d  steals %d/%d  parks %d", m_telemetryList[i]->m_threadName.c_str(),
+														  int( threadStats.m_utilization * 100.0f ), threadStats.m_numJobsRun, threadStats.m_numSteals, threadStats.m_numStealAttempts, threadStats.m_numParks ) );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::WriteTraceCapture()
+{
+	// Chrome trace format, load in chrome://tracing or ui.perfetto.dev. Times are in microseconds
+	double		traceStartSeconds = m_traceFrameEndList.empty() ? 0.0 : m_traceFrameEndList[0];
+	std::string json = "{\"traceEvents\":[\n";
+	for ( int i = 0; i < m_telemetryList.size(); i++ )
+	{
+		json += Stringf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n", i, m_telemetryList[i]->m_threadName.c_str() );
+	}
+	int mainTid = int( m_telemetryList.size() ) - 1;
+	for ( int i = 0; i + 1 < m_traceFrameEndList.size(); i++ )
+	{
+		double frameStartUs = ( m_traceFrameEndList[i]	   - traceStartSeconds ) * 1000000.0;
+		double frameEndUs	= ( m_traceFrameEndList[i + 1] - traceStartSeconds ) * 1000000.0;
+		json += Stringf( "{\"name\":\"Frame %d\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f},\n", i, mainTid, frameStartUs, frameEndUs - frameStartUs );
+	}
+
+	static char const* s_priorityNameList[ NUM_JOB_PRIORITIES ] = { "critical", "normal", "background" };
+	for ( int i = 0; i < m_telemetryList.size(); i++ )
+	{
+		JobThreadTelemetry const& telemetry = *m_telemetryList[i];
+		int lastEventIndex	= telemetry.m_numTraceEvents.load( std::memory_order_acquire );
+		int firstEventIndex	= ( i < m_traceFirstEventIndexList.size() ) ? m_traceFirstEventIndexList[i] : 0;
+		if ( lastEventIndex - firstEventIndex > JOB_TRACE_EVENTS_PER_THREAD )
+		{
+			// The ring wrapped, only the newest events survived
+			firstEventIndex = lastEventIndex - JOB_TRACE_EVENTS_PER_THREAD;
+		}
+		for ( int eventIndex = firstEventIndex; eventIndex < lastEventIndex; eventIndex++ )
+		{
+			JobTraceEvent const& traceEvent = telemetry.m_traceEventList[ eventIndex % JOB_TRACE_EVENTS_PER_THREAD ];
+			double startUs	= ( traceEvent.m_startSeconds - traceStartSeconds ) * 1000000.0;
+			double durUs	= ( traceEvent.m_endSeconds	  - traceEvent.m_startSeconds ) * 1000000.0;
+			double queueUs	= ( traceEvent.m_startSeconds - traceEvent.m_readySeconds ) * 1000000.0;
+			json += Stringf( "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"queueUs\":%.3f}},\n",
+							 traceEvent.m_name, s_priorityNameList[ traceEvent.m_priority ], i, startUs, durUs, queueUs );
+		}
+	}
+	json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Frames\"}}\n]}\n";
+
+	std::vector<char> buffer( json.begin(), json.end() );
+	WriteBinaryBufferToFile( buffer, m_traceFilePath );
+	if ( g_theDevConsole != nullptr )
+	{
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Job trace of %d frames written to %s", int( m_traceFrameEndList.size() ) - 1, m_traceFilePath.c_str() ) );
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -48,6 +713,82 @@ bool JobSystem::IsQuitting() const
 	return m_isQuitting;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::BuildWorkerCpuSlots()
+{
+	m_reservedCoreList.clear();
+	m_workerCpuSlotList.clear();
+	std::vector<CpuCore> coreList = GetAllowedCpuCores();
+	if ( coreList.empty() )
+	{
+		return;
+	}
+
+	// Always leave at least one core for the workers
+	int numReservedCores = m_config.m_numReservedCores;
+	if ( numReservedCores > int( coreList.size() ) - 1 )
+	{
+		numReservedCores = int( coreList.size() ) - 1;
+	}
+	for ( int coreIndex = 0; coreIndex < coreList.size(); coreIndex++ )
+	{
+		CpuCore const& core = coreList[ coreIndex ];
+		if ( coreIndex < numReservedCores )
+		{
+			m_reservedCoreList.push_back( core );
+			continue;
+		}
+
+		std::vector<int> workerCpuList;
+		for ( int i = 0; i < core.m_logicalCpuList.size(); i++ )
+		{
+			int cpu = core.m_logicalCpuList[i];
+			if ( m_config.m_workerCpuList.empty() || std::find( m_config.m_workerCpuList.begin(), m_config.m_workerCpuList.end(), cpu ) != m_config.m_workerCpuList.end() )
+			{
+				workerCpuList.push_back( cpu );
+			}
+		}
+		if ( workerCpuList.empty() )
+		{
+			continue;
+		}
+		if ( m_config.m_usePhysicalCoresOnly )
+		{
+			m_workerCpuSlotList.push_back( workerCpuList );
+		}
+		else
+		{
+			for ( int i = 0; i < workerCpuList.size(); i++ )
+			{
+				m_workerCpuSlotList.push_back( std::vector<int>( 1, workerCpuList[i] ) );
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool JobSystem::PinCurrentThreadToReservedCore( int reservedCoreIndex ) const
+{
+	if ( reservedCoreIndex < 0 || reservedCoreIndex >= m_reservedCoreList.size() )
+	{
+		return false;
+	}
+	return SetCurrentThreadAffinity( m_reservedCoreList[ reservedCoreIndex ].m_logicalCpuList );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobSystem::InitializeWorkerThread( int workerIndex )
+{
+	std::string threadName = Stringf( "%s %d", m_config.m_workerThreadNamePrefix.c_str(), workerIndex );
+	SetCurrentThreadName( threadName );
+	ProfilerSetCurrentThreadName( threadName );
+	LoggerSetCurrentThreadName( threadName );
+	if ( m_config.m_pinWorkerThreads && !m_workerCpuSlotList.empty() )
+	{
+		SetCurrentThreadAffinity( m_workerCpuSlotList[ workerIndex % m_workerCpuSlotList.size() ] );
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::CreateNewWorkers( int numWorkerThreads )
 {
@@ -69,49 +810,181 @@ void JobSystem::DestroyAllWorkers()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-Job* JobSystem::ClaimJobForWorkerThread()
+Job* JobSystem::ClaimJobForWorkerThread( int dequeIndex, bool isCallerBlocked )
+{
+	Job* jobToDo = ClaimJobOfPriority( dequeIndex, JOB_PRIORITY_FRAME_CRITICAL );
+	if ( jobToDo == nullptr )
+	{
+		jobToDo = ClaimJobOfPriority( dequeIndex, JOB_PRIORITY_NORMAL );
+	}
+	if ( jobToDo == nullptr && ( isCallerBlocked || CanStartBackgroundJob( dequeIndex ) ) )
+	{
+		// Reserve the slot before claiming so concurrent claimers can't overshoot the cap. A blocked caller ignores
+		// the cap and the frame cutoff: the job it waits on may be background, and with no workers nobody else runs it
+		if ( ++m_numBackgroundJobsRunning <= m_maxConcurrentBackgroundJobs || isCallerBlocked )
+		{
+			jobToDo = ClaimJobOfPriority( dequeIndex, JOB_PRIORITY_BACKGROUND );
+		}
+		if ( jobToDo == nullptr )
+		{
+			m_numBackgroundJobsRunning--;
+		}
+	}
+
+	if ( jobToDo != nullptr )
+	{
+		jobToDo->m_jobStatus = JOB_STATUS_WORKING;			// Change this job's status to "in-progress" (being worked on by the thread)
+	}
+	return jobToDo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Job* JobSystem::ClaimJobOfPriority( int dequeIndex, JobPriority priority )
 {
 	Job* jobToDo = nullptr;
-	m_unclaimedJobsListMutex.lock();
-	if ( !m_unclaimedJobsList.empty() )
+	if ( dequeIndex >= 0 )
 	{
-		jobToDo = m_unclaimedJobsList.front();				// Get Front
-		m_unclaimedJobsList.pop();							// Pop "front"
-		jobToDo->m_jobStatus = JOB_STATUS_WORKING;		// Change this job's status to "in-progress" (being worked on by the thread)
+		jobToDo = m_dequeList[ priority ][ dequeIndex ]->Pop();
+	}
 
-//		m_claimedJobsListMutex.lock();
-//		m_claimedJobsList.push_back( jobToDo );
-//		m_claimedJobsListMutex.unlock();
+	if ( jobToDo == nullptr && m_numUnclaimedJobs[ priority ] > 0 )
+	{
+		m_unclaimedJobsListMutex.lock();
+		std::queue<Job*>& unclaimedJobsList = m_unclaimedJobsList[ priority ];
+		if ( !unclaimedJobsList.empty() )
+		{
+			jobToDo = unclaimedJobsList.front();				// Get Front
+			unclaimedJobsList.pop();							// Pop "front"
+			m_numUnclaimedJobs[ priority ]--;
+		}
+		m_unclaimedJobsListMutex.unlock();
 	}
-	m_unclaimedJobsListMutex.unlock();
 
+	if ( jobToDo == nullptr )
+	{
+		jobToDo = StealJob( dequeIndex, priority );
+	}
 	return jobToDo;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+Job* JobSystem::StealJob( int thiefDequeIndex, JobPriority priority )
+{
+	std::vector<JobDeque*> const& dequeList = m_dequeList[ priority ];
+	int numDeques = int( dequeList.size() );
+	if ( numDeques == 0 )
+	{
+		return nullptr;
+	}
+
+	// Start at a random victim and try each deque once, so thieves spread out instead of piling onto deque 0
+	unsigned int victimSeed = 0;
+	if ( thiefDequeIndex >= 0 )
+	{
+		unsigned int& seed	= dequeList[ thiefDequeIndex ]->m_victimSeed;
+		seed			   ^= seed << 13;
+		seed			   ^= seed >> 17;
+		seed			   ^= seed << 5;
+		victimSeed			= seed;
+	}
+	int firstVictim = int( victimSeed % static_cast<unsigned int>( numDeques ) );
+	for ( int i = 0; i < numDeques; i++ )
+	{
+		int victimIndex = ( firstVictim + i ) % numDeques;
+		if ( victimIndex == thiefDequeIndex )
+		{
+			continue;
+		}
+		Job* stolenJob = dequeList[ victimIndex ]->Steal();
+		if ( stolenJob != nullptr )
+		{
+			if ( m_isTelemetryEnabled && thiefDequeIndex >= 0 )
+			{
+				m_telemetryList[ thiefDequeIndex ]->RecordStealAttempt( true );
+			}
+			return stolenJob;
+		}
+	}
+	if ( m_isTelemetryEnabled && thiefDequeIndex >= 0 )
+	{
+		m_telemetryList[ thiefDequeIndex ]->RecordStealAttempt( false );
+	}
+	return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int JobSystem::GetLocalDequeIndex() const
+{
+	if ( t_workerJobSystem == this )
+	{
+		return t_workerDequeIndex;
+	}
+	if ( m_mainDequeIndex >= 0 && std::this_thread::get_id() == m_mainThreadID )
+	{
+		return m_mainDequeIndex;
+	}
+	return -1;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::AddJobToCompletedList( Job* jobToDo )
 {
-	m_completedJobsListMutex.lock();
-	m_completedJobsList.push( jobToDo );
+	// Status first, the main thread may retrieve it the moment it is pushed
 	jobToDo->m_jobStatus = JOB_STATUS_COMPLETED;
-	m_completedJobsListMutex.unlock();
+	if ( m_completedJobQueue.TryPush( jobToDo ) )
+	{
+		return;
+	}
+
+	// The main thread has fallen a whole ring behind, spill rather than wait on it
+	m_completedJobsOverflowListMutex.lock();
+	m_completedJobsOverflowList.push( jobToDo );
+	m_numOverflowedCompletedJobs++;
+	m_completedJobsOverflowListMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Job* JobSystem::RetrieveCompletedJob()
 {
 	Job* completedJob = nullptr;
-	m_completedJobsListMutex.lock();
-	if ( !m_completedJobsList.empty() )
+	if ( !m_completedJobQueue.TryPop( completedJob ) && m_numOverflowedCompletedJobs > 0 )
+	{
+		m_completedJobsOverflowListMutex.lock();
+		if ( !m_completedJobsOverflowList.empty() )
+		{
+			completedJob = m_completedJobsOverflowList.front();
+			m_completedJobsOverflowList.pop();
+			m_numOverflowedCompletedJobs--;
+		}
+		m_completedJobsOverflowListMutex.unlock();
+	}
+	if ( completedJob != nullptr )
 	{
-		completedJob = m_completedJobsList.front();
-		m_completedJobsList.pop();
 		completedJob->m_jobStatus = JOB_STATUS_RETRIEVED;			// No longer owned by the job system, ownership has been given BACK to the main thread
 	}
-	m_completedJobsListMutex.unlock();
 	return completedJob;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+FrameJob* JobSystem::AllocateFrameJob()
+{
+	// Count ourselves in flight before checking whether the pool is closed, EndFrame sets the flag before it checks
+	// the count, so one of the two always sees the other (both are seq_cst)
+	m_numFrameJobsInFlight++;
+	if ( m_frameJobPool == nullptr || m_isReclaimingFrameJobs )
+	{
+		m_numFrameJobsInFlight--;
+		return nullptr;
+	}
+	int slotIndex = m_numFrameJobsAllocated++;
+	if ( slotIndex >= m_config.m_maxFrameJobsPerFrame )
+	{
+		m_numFrameJobsInFlight--;
+		return nullptr;
+	}
+	return &m_frameJobPool[ slotIndex ];
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::ClearAllJobListsAndJoinAllWorkers()
 {
@@ -125,11 +998,26 @@ void JobSystem::ClearAllJobListsAndJoinAllWorkers()
 void JobSystem::ClearUnclaimedJobslist()
 {
 	m_unclaimedJobsListMutex.lock();
-	for ( int i = 0; i < m_unclaimedJobsList.size(); i++ )
+	for ( int priority = 0; priority < NUM_JOB_PRIORITIES; priority++ )
 	{
-		m_unclaimedJobsList.pop();
+		while ( !m_unclaimedJobsList[ priority ].empty() )
+		{
+			m_unclaimedJobsList[ priority ].pop();
+		}
+		m_numUnclaimedJobs[ priority ] = 0;
 	}
 	m_unclaimedJobsListMutex.unlock();
+
+	// Deques can only be drained from the outside by stealing
+	for ( int priority = 0; priority < NUM_JOB_PRIORITIES; priority++ )
+	{
+		for ( int i = 0; i < m_dequeList[ priority ].size(); i++ )
+		{
+			while ( m_dequeList[ priority ][i]->Steal() != nullptr )
+			{
+			}
+		}
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -143,12 +1031,17 @@ void JobSystem::ClearClaimedJobslist()
 //----------------------------------------------------------------------------------------------------------------------
 void JobSystem::ClearCompletedJobslist()
 {
-	m_completedJobsListMutex.lock();
-	while ( m_completedJobsList.size() != 0 )
+	Job* completedJob = nullptr;
+	while ( m_completedJobQueue.TryPop( completedJob ) )
+	{
+	}
+	m_completedJobsOverflowListMutex.lock();
+	while ( !m_completedJobsOverflowList.empty() )
 	{
-		m_completedJobsList.pop();
+		m_completedJobsOverflowList.pop();
 	}
-	m_completedJobsListMutex.unlock();
+	m_numOverflowedCompletedJobs = 0;
+	m_completedJobsOverflowListMutex.unlock();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -182,19 +1075,15 @@ JobWorker::~JobWorker()
 //----------------------------------------------------------------------------------------------------------------------
 void JobWorker::ThreadMain( JobWorker* jobWorker, int m_threadID )
 {
-	UNUSED( m_threadID );
+	t_workerJobSystem	= jobWorker->m_jobSystem;
+	t_workerDequeIndex	= m_threadID;
+	jobWorker->m_jobSystem->InitializeWorkerThread( m_threadID );
 
 	while ( !jobWorker->m_jobSystem->IsQuitting() )
 	{
-		Job* jobToDo = jobWorker->m_jobSystem->ClaimJobForWorkerThread();
-		if ( jobToDo != nullptr )
-		{
-			jobToDo->Execute();													// Actually chunk::Generate();
-			jobWorker->m_jobSystem->AddJobToCompletedList( jobToDo );
-		}
-		else
+		if ( !jobWorker->m_jobSystem->ExecuteOneJob() )
 		{
-			std::this_thread::sleep_for( std::chrono::microseconds(1) );		// Don't hog the CPU just checking for work
+			jobWorker->m_jobSystem->WaitForWork();		// Spin, then yield, then park until a job is posted
 		}
 	}
 }
@@ -216,3 +1105,131 @@ void JobWorker::ThreadMain( JobWorker* jobWorker, int m_threadID )
 // 
 // 	}
 // }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------------------------------------------------
+class BenchmarkChildJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		float result = 0.0f;
+		for ( int i = 0; i < 64; i++ )
+		{
+			result += sinf( float( i ) * 0.01f );
+		}
+		m_result = result;
+		(*m_numJobsDone)++;
+	}
+
+	std::atomic<int>*	m_numJobsDone	= nullptr;
+	float				m_result		= 0.0f;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+class BenchmarkSpawnerJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		// Posted from inside a job, so the children land in this worker's deque for others to steal
+		for ( int i = 0; i < m_numChildJobs; i++ )
+		{
+			m_jobSystem->PostNewJob( m_childJobList + i );
+		}
+		(*m_numJobsDone)++;
+	}
+
+	JobSystem*			m_jobSystem		= nullptr;
+	BenchmarkChildJob*	m_childJobList	= nullptr;
+	int					m_numChildJobs	= 0;
+	std::atomic<int>*	m_numJobsDone	= nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_JobSystemBenchmark( NamedStrings& args )
+{
+	int const numJobsPerSpawner = 1024;
+	int numChildJobs			= args.GetValue( "numJobs", 65536 );
+	if ( numChildJobs < numJobsPerSpawner )
+	{
+		numChildJobs = numJobsPerSpawner;
+	}
+	int numSpawnerJobs	= ( numChildJobs + numJobsPerSpawner - 1 ) / numJobsPerSpawner;
+	numChildJobs		= numSpawnerJobs * numJobsPerSpawner;
+
+	std::vector<BenchmarkChildJob>		childJobList( numChildJobs );
+	std::vector<BenchmarkSpawnerJob>	spawnerJobList( numSpawnerJobs );
+
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "JobSystem benchmark: %d jobs, %d hardware threads", numChildJobs, int( std::thread::hardware_concurrency() ) ) );
+	double baselineJobsPerSecond = 0.0;
+	int const workerCountList[] = { 1, 2, 4, 8, 16 };
+	for ( int workerCount : workerCountList )
+	{
+		JobSystemConfig config;
+		config.m_preferredNumberOfWorkers = workerCount;
+		JobSystem* jobSystem = new JobSystem( config );
+		jobSystem->Startup();
+
+		std::atomic<int> numJobsDone = 0;
+		for ( int i = 0; i < numChildJobs; i++ )
+		{
+			childJobList[i].m_jobStatus		= JOB_STATUS_NEW;
+			childJobList[i].m_numJobsDone	= &numJobsDone;
+		}
+
+		double startTime = GetCurrentTimeSeconds();
+		for ( int i = 0; i < numSpawnerJobs; i++ )
+		{
+			BenchmarkSpawnerJob& spawnerJob	= spawnerJobList[i];
+			spawnerJob.m_jobStatus			= JOB_STATUS_NEW;
+			spawnerJob.m_jobSystem			= jobSystem;
+			spawnerJob.m_childJobList		= childJobList.data() + ( i * numJobsPerSpawner );
+			spawnerJob.m_numChildJobs		= numJobsPerSpawner;
+			spawnerJob.m_numJobsDone		= &numJobsDone;
+			jobSystem->PostNewJob( &spawnerJob );
+		}
+		int numJobsTotal = numChildJobs + numSpawnerJobs;
+		while ( numJobsDone < numJobsTotal )
+		{
+			if ( !jobSystem->ExecuteOneJob() )
+			{
+				std::this_thread::yield();
+			}
+		}
+		double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+		while ( jobSystem->RetrieveCompletedJob() != nullptr )
+		{
+		}
+		jobSystem->Shutdown();
+		delete jobSystem;
+
+		double jobsPerSecond = double( numJobsTotal ) / elapsedSeconds;
+		if ( baselineJobsPerSecond == 0.0 )
+		{
+			baselineJobsPerSecond = jobsPerSecond;
+		}
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %2d workers: %8.2f ms, %10.0f jobs/sec, %5.2fx", workerCount, elapsedSeconds * 1000.0, jobsPerSecond, jobsPerSecond / baselineJobsPerSecond ) );
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_JobStats( NamedStrings& args )
+{
+	UNUSED( args );
+	g_theJobSystem->SetOverlayVisible( !g_theJobSystem->IsOverlayVisible() );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_JobTrace( NamedStrings& args )
+{
+	int			numFrames	= args.GetValue( "frames", 120 );
+	std::string filePath	= args.GetValue( "file", "JobTrace.json" );
+	g_theJobSystem->StartTraceCapture( numFrames, filePath );
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Capturing %d frames of jobs to %s", numFrames, filePath.c_str() ) );
+	return true;
+}
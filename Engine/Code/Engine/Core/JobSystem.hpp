@@ -1,22 +1,58 @@
 #pragma once
 
+#include "Engine/Core/JobDeque.hpp"
+#include "Engine/Core/JobTelemetry.hpp"
+#include "Engine/Core/MPMCQueue.hpp"
+#include "Engine/Core/ThreadUtils.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
 #include <queue>
+#include <string>
 #include <vector>
 #include <mutex>
+#include <new>
+#include <thread>
 
 //----------------------------------------------------------------------------------------------------------------------
+class Clock;
+class Job;
 class JobWorker;
+class NamedStrings;
 
 //----------------------------------------------------------------------------------------------------------------------
 enum JobStatus
 {
 	JOB_STATUS_NEW,				// Constructed but not queued for work yet
+	JOB_STATUS_BLOCKED,			// Posted, waiting on its dependencies to finish
 	JOB_STATUS_QUEUED,			// Queued, waiting to be claimed by a worker thread
 	JOB_STATUS_WORKING,			// Claimed by a worker thread who is currently executing it
-	JOB_STATUS_COMPLETED,		// Completed, placed into the completed list for the main thread
+	JOB_STATUS_COMPLETED,		// Completed, placed into the completed list for the main thread (or its counter signalled)
 	JOB_STATUS_RETRIEVED,		// Retrieved by the main thread, retired from the Job system
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+enum JobPriority
+{
+	JOB_PRIORITY_FRAME_CRITICAL,	// Something this frame is waiting on (IK solves, picks, ParallelFor chunks)
+	JOB_PRIORITY_NORMAL,
+	JOB_PRIORITY_BACKGROUND,		// Can take several frames (decoding, regeneration); throttled near the frame deadline
+	NUM_JOB_PRIORITIES,
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Counts jobs still in flight. Jobs posted with a counter skip the completed list; the owner waits on the counter
+// (JobSystem::WaitFor) and keeps ownership of the jobs throughout
+//----------------------------------------------------------------------------------------------------------------------
+class JobCounter
+{
+public:
+	bool IsDone() const;
+
+	std::atomic<int> m_numJobsRemaining = 0;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 class Job
 {
@@ -25,13 +61,68 @@ public:
 	virtual ~Job() {};
 	virtual void Execute() = 0;
 
+	void AddContinuation( Job* continuation );		// continuation runs once this job finishes; link both before posting either
+
 	std::atomic<JobStatus>	m_jobStatus = JOB_STATUS_NEW;
+	JobPriority				m_priority	= JOB_PRIORITY_NORMAL;
+	char const*				m_name		= "Job";			// Shown in job traces; must outlive the capture
+	double					m_readySeconds	= 0.0;			// When it was queued, only stamped while telemetry is on
+
+	// Dependencies
+	JobCounter*				m_signalCounter				= nullptr;
+	std::vector<Job*>		m_continuationList;
+	int						m_numDependencies			= 0;
+	std::atomic<int>		m_numPendingDependencies	= 1;		// Unfinished dependencies, plus one for the post itself
+
+	bool					m_isFrameJob				= false;	// Lives in the JobSystem's per-frame pool, see PostFrameJob
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int FRAME_JOB_CALLABLE_SIZE = 64;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Pool slot for JobSystem::PostFrameJob. The callable is copied into inline storage and destroyed right after it
+// runs; the slot itself is handed out again after JobSystem::EndFrame
+//----------------------------------------------------------------------------------------------------------------------
+class FrameJob : public Job
+{
+public:
+	FrameJob();
+	virtual void Execute() override;
+
+	alignas( 16 ) unsigned char	m_callableStorage[ FRAME_JOB_CALLABLE_SIZE ];
+	void						(*m_invokeAndDestroy)( void* callable ) = nullptr;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 struct JobSystemConfig
 {
-	int m_preferredNumberOfWorkers = -1;		// -1 means "one fewer than number of CPU cores"
+	int m_preferredNumberOfWorkers	= -1;		// -1 means "one fewer than number of CPU cores"
+	int m_numIdleSpins				= 256;		// Idle workers poll this many times with a pause instruction,
+	int m_numIdleYields				= 16;		// then this many times giving up their timeslice, before parking
+	int m_maxFrameJobsPerFrame		= 4096;		// Pool size for PostFrameJob; jobs past this run on the posting thread
+	int m_completedJobQueueCapacity	= 4096;		// Lock-free ring for finished jobs; past this they spill into a locked list
+
+	// Background jobs only start while the frame (timed from frameClock's last tick) is inside this fraction of the
+	// target frame time, and never on the main thread, so they can't hold up the frame. A thread blocked in WaitFor or
+	// EndFrame is the exception: it takes them regardless, since it may be waiting on one
+	Clock*	m_frameClock					= nullptr;			// nullptr means the system clock
+	float	m_targetFrameSeconds			= 1.0f / 60.0f;
+	float	m_backgroundCutoffFraction		= 0.75f;
+	int		m_maxConcurrentBackgroundJobs	= -1;				// -1 means "all workers but one"
+
+	// WaitForSeconds counts this clock's total time, so task waits pause and scale with it (and step exactly in
+	// fixed-step runs); nullptr means the system clock
+	Clock*	m_taskClock						= nullptr;
+
+	// Topology. Reserved cores are the first allowed physical cores, left to the main (and render) thread; workers are
+	// sized to the CPUs left over. Pinning stops the OS migrating threads between cores mid-frame
+	int					m_numReservedCores			= 1;
+	bool				m_usePhysicalCoresOnly		= false;		// One worker per physical core, SMT siblings left idle
+	bool				m_pinWorkerThreads			= false;		// Each worker sticks to its own CPU (its whole core if physical only)
+	bool				m_pinMainThread				= false;		// Startup's calling thread sticks to the first reserved core
+	std::vector<int>	m_workerCpuList;							// Logical CPUs workers may use, empty means all allowed ones
+	std::string			m_workerThreadNamePrefix	= "JobWorker";	// "JobWorker 3" in top -H, perf and debuggers
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -40,6 +131,7 @@ class JobSystem
 public:
 	JobSystem( JobSystemConfig const& config )
 		: m_config( config )
+		, m_completedJobQueue( config.m_completedJobQueueCapacity )
 	{}
 
 	void Startup();
@@ -47,14 +139,62 @@ public:
 	void EndFrame();
 	void Shutdown();
 
-	void PostNewJob( Job* newJob );						// called by Main thread to add Job to ToDo list
+	void PostNewJob( Job* newJob, JobCounter* counter = nullptr );	// Goes to the caller's own deque if it has one (workers, main thread), else the shared queue
+	bool ExecuteOneJob( bool isCallerBlocked = false );	// Runs one queued job on the calling thread; false if there was nothing to run
+	void WaitUntilJobIsCompleted( Job* job );			// Main thread helps out with queued jobs while it waits
+	void WaitFor( JobCounter const& counter );			// Same, until every job on the counter has finished
+
+	// Fire-and-forget callable from the per-frame pool, no heap allocation. Completion is only reported through
+	// counter, and EndFrame waits for every frame job still running before reclaiming the pool.
+	// Safe from any thread; a post that lands while EndFrame is reclaiming the pool runs on the posting thread
+	template< typename T_Func >
+	void PostFrameJob( T_Func const& func, JobCounter* counter = nullptr, JobPriority priority = JOB_PRIORITY_NORMAL );
+	int	 GetNumWorkers() const;
+
+	// Suspended Tasks (see Task.hpp). Worker resumes run as frame jobs; frame resumes run on the main thread in
+	// BeginFrame, once the task clock reaches resumeTimeSeconds and counter (if any) is done
+	void ResumeTaskOnWorker( std::coroutine_handle<> task );
+	void ResumeTaskOnMainThread( std::coroutine_handle<> task, double resumeTimeSeconds = 0.0, JobCounter const* counter = nullptr );
+	void ResumeReadyTasks();
+	double GetTaskClockSeconds() const;
+
+	// Telemetry, only gathered while the overlay is up, a trace is being captured or another tool asked for it
+	void SetOverlayVisible( bool isVisible );
+	bool IsOverlayVisible() const;
+	void SetTelemetryRequested( bool isRequested );		// e.g. the perf HUD, which draws the stats itself
+	void StartTraceCapture( int numFrames, std::string const& filePath );		// Written out as Chrome trace JSON
+	JobSystemFrameStats const& GetLastFrameStats() const;
+
+	// For threads outside the job system, e.g. a render thread; false if there is no such reserved core
+	bool PinCurrentThreadToReservedCore( int reservedCoreIndex ) const;
 
 //private:
 	bool IsQuitting() const;
+	void BuildWorkerCpuSlots();							// Splits the allowed cores into reserved cores and worker CPU slots
 	void CreateNewWorkers( int numWorkerThreads );
+	void InitializeWorkerThread( int workerIndex );		// Called on the worker thread itself, names and pins it
 	void DestroyAllWorkers();
-	Job* ClaimJobForWorkerThread();						// Called by the main thread to put INTO the system AND (give up ownership)		//Claim Job
+	Job* ClaimJobForWorkerThread( int dequeIndex, bool isCallerBlocked );	// Highest priority first; background only if CanStartBackgroundJob() or the caller is blocked
+	Job* ClaimJobOfPriority( int dequeIndex, JobPriority priority );	// Own deque first, then the shared queue, then steal from a random victim
+	Job* StealJob( int thiefDequeIndex, JobPriority priority );
+	int	 GetLocalDequeIndex() const;					// -1 for threads without a deque
+	bool IsNearFrameDeadline() const;
+	bool CanStartBackgroundJob( int dequeIndex ) const;
+	bool HasQueuedJobs( JobPriority priority ) const;
+	bool HasQueuedJobs() const;							// Only counts background jobs the calling worker may start
+	int	 GetApproxNumQueuedJobs( JobPriority priority ) const;
+	void UpdateFrameStats();
+	void AddOverlayLines() const;
+	void WriteTraceCapture();
+	void UpdateTelemetryEnabled();
+	void WaitForWork();									// Called by idle workers, returns once there may be work or on quit
+	void WakeOneIdleWorker();
+	void WakeAllIdleWorkers();
+	void SubmitJob( Job* job );							// Queues the job once its dependencies are done
+	void EnqueueJob( Job* job );
+	void FinishJob( Job* job );							// Releases continuations, then signals the counter or fills the completed list
 	void AddJobToCompletedList( Job* jobToDo );
+	FrameJob* AllocateFrameJob();						// nullptr once this frame's pool is used up
 	Job* RetrieveCompletedJob();						// Called by the main thread to get a Job back OUT of the system AND (retake ownership)
 
 	void ClearAllJobListsAndJoinAllWorkers();
@@ -68,17 +208,97 @@ private:
 	std::atomic<bool>		m_isQuitting = false;
 
 	std::vector<JobWorker*> m_workerList;
+	std::vector<CpuCore>			m_reservedCoreList;
+	std::vector<std::vector<int>>	m_workerCpuSlotList;	// Logical CPUs for each worker, worker i takes slot i % size
 
-	std::queue<Job*>		m_unclaimedJobsList;		// List of jobs posted but not claimed by any worker (Work that needs to be done)
+	std::vector<JobDeque*>	m_dequeList[ NUM_JOB_PRIORITIES ];			// One per worker, plus one for the main thread at the back
+	std::thread::id			m_mainThreadID;
+	int						m_mainDequeIndex = -1;
+
+	std::queue<Job*>		m_unclaimedJobsList[ NUM_JOB_PRIORITIES ];	// Jobs posted from threads without a deque, or that overflowed one
 	std::mutex				m_unclaimedJobsListMutex;
+	std::atomic<int>		m_numUnclaimedJobs[ NUM_JOB_PRIORITIES ];	// Lets claimers skip the mutex when a shared queue is empty
+	std::atomic<int>		m_numBackgroundJobsRunning = 0;
+	int						m_maxConcurrentBackgroundJobs = 1;
+
+	std::mutex				m_idleMutex;
+	std::condition_variable	m_idleCondition;
+	std::atomic<int>		m_numSleepingWorkers = 0;
+	std::atomic<unsigned int>	m_wakeEpoch = 0;		// Bumped on every wake-up so parked workers can tell a real one from a spurious one
+
+	struct SuspendedTask
+	{
+		std::coroutine_handle<>	m_handle;
+		double					m_resumeTimeSeconds	= 0.0;
+		JobCounter const*		m_counter			= nullptr;
+	};
+	std::vector<SuspendedTask>	m_suspendedTaskList;
+	std::vector<SuspendedTask>	m_readyTaskList;		// Scratch for ResumeReadyTasks
+	std::mutex					m_suspendedTaskListMutex;
+
+	// Telemetry, one per deque index
+	struct ThreadTelemetrySnapshot
+	{
+		int		m_numJobsRun		= 0;
+		int		m_numStealAttempts	= 0;
+		int		m_numSteals			= 0;
+		int		m_numParks			= 0;
+		double	m_busySeconds		= 0.0;
+		double	m_queueSeconds		= 0.0;
+	};
+	std::vector<JobThreadTelemetry*>		m_telemetryList;
+	std::vector<ThreadTelemetrySnapshot>	m_prevTelemetrySnapshotList;
+	std::atomic<bool>						m_isTelemetryEnabled		= false;
+	std::atomic<bool>						m_isCapturingTrace			= false;
+	std::atomic<int>						m_telemetryFrameIndex		= 0;
+	bool									m_isOverlayVisible			= false;
+	bool									m_isTelemetryRequested		= false;
+	double									m_lastFrameStatsSeconds		= 0.0;
+	JobSystemFrameStats						m_lastFrameStats;
+	int										m_numTraceFramesLeft		= 0;
+	std::string								m_traceFilePath;
+	std::vector<int>						m_traceFirstEventIndexList;
+	std::vector<double>						m_traceFrameEndList;
+
+	FrameJob*				m_frameJobPool = nullptr;
+	std::atomic<int>		m_numFrameJobsAllocated = 0;	// Bump allocator into m_frameJobPool, reset at EndFrame
+	std::atomic<int>		m_numFrameJobsInFlight = 0;
+	std::atomic<bool>		m_isReclaimingFrameJobs = false;	// Set by EndFrame while it drains and resets the pool
 
 	std::vector<Job*>		m_claimedJobsList;			// list of jobs currently claimed by workers (Work in progress)
 	std::mutex				m_claimedJobsListMutex;
 
-	std::queue<Job*>		m_completedJobsList;		// List of jobs finished, ready to be retrieved (Work completed)
-	std::mutex				m_completedJobsListMutex;
+	MPMCQueue<Job*>			m_completedJobQueue;		// Jobs finished, ready to be retrieved (Work completed)
+	std::queue<Job*>		m_completedJobsOverflowList;	// Only used while m_completedJobQueue is full
+	std::mutex				m_completedJobsOverflowListMutex;
+	std::atomic<int>		m_numOverflowedCompletedJobs = 0;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T_Func >
+void JobSystem::PostFrameJob( T_Func const& func, JobCounter* counter, JobPriority priority )
+{
+	static_assert( sizeof( T_Func ) <= FRAME_JOB_CALLABLE_SIZE, "Callable too big for a FrameJob, capture by pointer instead" );
+	static_assert( alignof( T_Func ) <= 16, "Callable alignment too strict for a FrameJob" );
+
+	FrameJob* frameJob = AllocateFrameJob();
+	if ( frameJob == nullptr )
+	{
+		// Pool is used up this frame or EndFrame is reclaiming it, running it here is slower but still correct
+		func();
+		return;
+	}
+	new ( frameJob->m_callableStorage ) T_Func( func );
+	frameJob->m_invokeAndDestroy = []( void* callable )
+	{
+		T_Func* storedFunc = static_cast<T_Func*>( callable );
+		(*storedFunc)();
+		storedFunc->~T_Func();
+	};
+	frameJob->m_priority = priority;
+	PostNewJob( frameJob, counter );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 class JobWorker
 {
@@ -92,3 +312,13 @@ public:
 	int				m_threadID		= -1;				// Worker ID
 	std::thread*	m_thread		= nullptr;			// This pointer will point to a thread created by the main thread
 };
+
+//----------------------------------------------------------------------------------------------------------------------
+// Posts lots of tiny jobs (from inside jobs, so they land in the local deques) at 1/2/4/8/16 workers and prints
+// throughput to the DevConsole. Args: numJobs=65536
+bool Command_JobSystemBenchmark( NamedStrings& args );
+
+//----------------------------------------------------------------------------------------------------------------------
+// "jobstats" toggles the telemetry overlay; "jobtrace frames=120 file=JobTrace.json" captures a Chrome trace
+bool Command_JobStats( NamedStrings& args );
+bool Command_JobTrace( NamedStrings& args );
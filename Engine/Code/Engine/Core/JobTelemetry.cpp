@@ -0,0 +1,71 @@
+#include "Engine/Core/JobTelemetry.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobThreadTelemetry::JobThreadTelemetry()
+{
+	m_traceEventList.resize( JOB_TRACE_EVENTS_PER_THREAD );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+JobThreadTelemetry::~JobThreadTelemetry()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobThreadTelemetry::RecordJob( char const* name, int priority, double readySeconds, double startSeconds, double endSeconds, int frameIndex, bool isCapturingTrace )
+{
+	// Single writer, so plain load/store pairs are enough
+	double queueSeconds	= startSeconds - readySeconds;
+	double runSeconds	= endSeconds - startSeconds;
+	m_numJobsRun.store( m_numJobsRun.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+	m_busySeconds.store( m_busySeconds.load( std::memory_order_relaxed ) + runSeconds, std::memory_order_relaxed );
+	m_queueSeconds.store( m_queueSeconds.load( std::memory_order_relaxed ) + queueSeconds, std::memory_order_relaxed );
+
+	if ( m_maxFrameIndex.load( std::memory_order_relaxed ) != frameIndex )
+	{
+		m_maxQueueSeconds.store( 0.0, std::memory_order_relaxed );
+		m_maxRunSeconds.store( 0.0, std::memory_order_relaxed );
+		m_maxFrameIndex.store( frameIndex, std::memory_order_relaxed );
+	}
+	if ( queueSeconds > m_maxQueueSeconds.load( std::memory_order_relaxed ) )
+	{
+		m_maxQueueSeconds.store( queueSeconds, std::memory_order_relaxed );
+	}
+	if ( runSeconds > m_maxRunSeconds.load( std::memory_order_relaxed ) )
+	{
+		m_maxRunSeconds.store( runSeconds, std::memory_order_relaxed );
+	}
+
+	if ( isCapturingTrace )
+	{
+		int eventIndex					= m_numTraceEvents.load( std::memory_order_relaxed );
+		JobTraceEvent& traceEvent		= m_traceEventList[ eventIndex % JOB_TRACE_EVENTS_PER_THREAD ];
+		traceEvent.m_name				= name;
+		traceEvent.m_readySeconds		= readySeconds;
+		traceEvent.m_startSeconds		= startSeconds;
+		traceEvent.m_endSeconds			= endSeconds;
+		traceEvent.m_priority			= priority;
+		m_numTraceEvents.store( eventIndex + 1, std::memory_order_release );		// Publishes the event to the exporter
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobThreadTelemetry::RecordStealAttempt( bool didSteal )
+{
+	m_numStealAttempts.store( m_numStealAttempts.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+	if ( didSteal )
+	{
+		m_numSteals.store( m_numSteals.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void JobThreadTelemetry::RecordPark()
+{
+	m_numParks.store( m_numParks.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+}
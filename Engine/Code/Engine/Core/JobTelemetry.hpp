@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int JOB_TRACE_EVENTS_PER_THREAD = 16384;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct JobTraceEvent
+{
+	char const*	m_name				= nullptr;
+	double		m_readySeconds		= 0.0;		// Queued with all dependencies done
+	double		m_startSeconds		= 0.0;		// Claimed
+	double		m_endSeconds		= 0.0;
+	int			m_priority			= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Counters for one thread with a deque, written only by that thread. Everything is cumulative so the main thread can
+// diff snapshots without resetting anything under the writer; only the maxima restart, when the frame index moves on
+//----------------------------------------------------------------------------------------------------------------------
+class JobThreadTelemetry
+{
+public:
+	JobThreadTelemetry();
+	~JobThreadTelemetry();
+
+	void RecordJob( char const* name, int priority, double readySeconds, double startSeconds, double endSeconds, int frameIndex, bool isCapturingTrace );
+	void RecordStealAttempt( bool didSteal );
+	void RecordPark();
+
+public:
+	std::string					m_threadName;
+	std::atomic<int>			m_numJobsRun			= 0;
+	std::atomic<int>			m_numStealAttempts		= 0;
+	std::atomic<int>			m_numSteals				= 0;
+	std::atomic<int>			m_numParks				= 0;
+	std::atomic<double>			m_busySeconds			= 0.0;
+	std::atomic<double>			m_queueSeconds			= 0.0;
+	std::atomic<double>			m_maxQueueSeconds		= 0.0;
+	std::atomic<double>			m_maxRunSeconds			= 0.0;
+	std::atomic<int>			m_maxFrameIndex			= -1;
+
+	// Ring of trace events, only filled while a capture is running
+	std::vector<JobTraceEvent>	m_traceEventList;
+	std::atomic<int>			m_numTraceEvents		= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct JobThreadFrameStats
+{
+	int		m_numJobsRun		= 0;
+	int		m_numStealAttempts	= 0;
+	int		m_numSteals			= 0;
+	int		m_numParks			= 0;
+	float	m_utilization		= 0.0f;		// Fraction of the frame spent running jobs
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct JobSystemFrameStats
+{
+	float								m_frameSeconds		= 0.0f;
+	int									m_numJobsRun		= 0;
+	float								m_avgQueueMs		= 0.0f;		// Ready to claimed
+	float								m_maxQueueMs		= 0.0f;
+	float								m_avgRunMs			= 0.0f;
+	float								m_maxRunMs			= 0.0f;
+	std::vector<int>					m_queueDepthList;				// Per priority, sampled at EndFrame
+	std::vector<JobThreadFrameStats>	m_threadStatsList;				// Per deque index, main thread last
+};
@@ -0,0 +1,524 @@
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/ThreadUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+std::atomic<int>		g_loggerMinSeverity		= int( LOG_SEVERITY_INFO );
+std::atomic<uint32_t>	g_loggerCategoryMask	= ( 1u << NUM_LOG_CATEGORIES ) - 1;
+
+//----------------------------------------------------------------------------------------------------------------------
+static char const* const s_logSeverityNameList[ NUM_LOG_SEVERITIES ] = { "Verbose", "Info", "Warning", "Error" };
+static char const* const s_logCategoryNameList[ NUM_LOG_CATEGORIES ] = { "General", "Core", "Renderer", "Input", "Audio", "Jobs", "Animation", "Gameplay" };
+
+//----------------------------------------------------------------------------------------------------------------------
+// Single producer (the owning thread), single consumer (whoever holds m_drainMutex)
+struct LoggerThreadBuffer
+{
+	std::string				m_threadName;
+	int						m_threadIndex			= 0;
+	LogRecord*				m_recordList			= nullptr;
+	std::atomic<int64_t>	m_writeIndex			= 0;
+	std::atomic<int64_t>	m_readIndex				= 0;
+	std::atomic<int64_t>	m_numDropped			= 0;		// Records that found the ring full
+	int64_t					m_numDroppedReported	= 0;		// Drain only
+	int64_t					m_pendingWriteIndex		= 0;		// Owning thread, between BeginRecord and CommitRecord
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct LoggerDrainedRecord
+{
+	LogRecord				m_record;
+	int						m_threadIndex		= 0;
+	int64_t					m_numDropped		= 0;		// Non-zero for a "ring full" notice, only m_record's time is set
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+class LoggerSystem
+{
+public:
+	LoggerSystem( LoggerConfig const& config );
+	~LoggerSystem();
+
+	LoggerThreadBuffer*	RegisterCurrentThread();
+	void				FlushThreadMain();
+	void				Drain();
+	void				FormatRecord( LogRecord const& record, std::string const& threadName, std::string& out_line ) const;
+
+public:
+	LoggerConfig						m_config;
+	int									m_generation			= 0;
+	int64_t								m_recordIndexMask		= 0;
+	std::thread::id						m_mainThreadID;
+	int64_t								m_startTimeNanoseconds	= 0;
+	FILE*								m_file					= nullptr;
+
+	std::vector<LoggerThreadBuffer*>	m_threadBufferList;
+	std::mutex							m_threadBufferListMutex;
+
+	std::thread							m_flushThread;
+	std::mutex							m_flushThreadMutex;
+	std::condition_variable				m_flushThreadCondition;
+	bool								m_isQuitting			= false;
+
+	std::mutex							m_drainMutex;
+	std::vector<LoggerDrainedRecord>	m_drainedRecordList;	// Scratch for Drain
+	std::vector<std::string>			m_drainThreadNameList;	// Copied with the records so formatting runs unlocked
+	std::string							m_drainText;
+	std::string							m_line;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<LoggerSystem*>				s_theLogger				= nullptr;
+static int										s_lastGeneration		= 0;
+static thread_local LoggerThreadBuffer*			t_loggerThreadBuffer	= nullptr;
+static thread_local int							t_loggerGeneration		= 0;
+static thread_local std::string					t_loggerThreadName;
+
+//----------------------------------------------------------------------------------------------------------------------
+// LoggerSystem class methods
+//----------------------------------------------------------------------------------------------------------------------
+LoggerSystem::LoggerSystem( LoggerConfig const& config )
+	: m_config( config )
+{
+	int64_t numRecordsPerThread = 2;
+	while ( numRecordsPerThread < m_config.m_numRecordsPerThread )
+	{
+		numRecordsPerThread <<= 1;
+	}
+	m_config.m_numRecordsPerThread	= int( numRecordsPerThread );
+	m_recordIndexMask				= numRecordsPerThread - 1;
+	m_generation					= ++s_lastGeneration;
+	m_mainThreadID					= std::this_thread::get_id();
+	m_startTimeNanoseconds			= GetCurrentTimeNanosecondsFast();
+
+	fopen_s( &m_file, m_config.m_filePath.c_str(), "wb" );
+	if ( m_file == nullptr )
+	{
+		DebuggerPrintf( "Logger could not open %s, lines only go to the debugger\n", m_config.m_filePath.c_str() );
+	}
+
+	m_flushThread = std::thread( &LoggerSystem::FlushThreadMain, this );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LoggerSystem::~LoggerSystem()
+{
+	m_flushThreadMutex.lock();
+	m_isQuitting = true;
+	m_flushThreadMutex.unlock();
+	m_flushThreadCondition.notify_one();
+	m_flushThread.join();
+
+	// The flush thread is gone and nothing new gets in, so this catches everything committed before shutdown
+	Drain();
+	if ( m_file != nullptr )
+	{
+		fclose( m_file );
+		m_file = nullptr;
+	}
+
+	for ( int i = 0; i < m_threadBufferList.size(); i++ )
+	{
+		delete[] m_threadBufferList[i]->m_recordList;
+		delete m_threadBufferList[i];
+	}
+	m_threadBufferList.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LoggerThreadBuffer* LoggerSystem::RegisterCurrentThread()
+{
+	LoggerThreadBuffer* buffer	= new LoggerThreadBuffer();
+	buffer->m_recordList		= new LogRecord[ m_config.m_numRecordsPerThread ];
+
+	m_threadBufferListMutex.lock();
+	buffer->m_threadIndex = int( m_threadBufferList.size() );
+	if ( std::this_thread::get_id() == m_mainThreadID )
+	{
+		buffer->m_threadName = "Main";
+	}
+	else
+	{
+		buffer->m_threadName = t_loggerThreadName.empty() ? Stringf( "Thread %d", buffer->m_threadIndex ) : t_loggerThreadName;
+	}
+	m_threadBufferList.push_back( buffer );
+	m_threadBufferListMutex.unlock();
+
+	t_loggerThreadBuffer	= buffer;
+	t_loggerGeneration		= m_generation;
+	return buffer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerSystem::FlushThreadMain()
+{
+	SetCurrentThreadName( "Logger" );
+	std::unique_lock<std::mutex> lock( m_flushThreadMutex );
+	while ( !m_isQuitting )
+	{
+		m_flushThreadCondition.wait_for( lock, std::chrono::milliseconds( m_config.m_flushIntervalMs ) );
+		lock.unlock();
+		Drain();
+		lock.lock();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerSystem::Drain()
+{
+	std::lock_guard<std::mutex> drainLock( m_drainMutex );
+
+	m_drainedRecordList.clear();
+	m_drainText.clear();
+
+	// Only copy under the lock, a thread's first LOG waits on it in RegisterCurrentThread
+	m_threadBufferListMutex.lock();
+	m_drainThreadNameList.resize( m_threadBufferList.size() );
+	for ( int i = 0; i < m_threadBufferList.size(); i++ )
+	{
+		LoggerThreadBuffer& buffer	= *m_threadBufferList[i];
+		int64_t readIndex			= buffer.m_readIndex.load( std::memory_order_relaxed );
+		int64_t writeIndex			= buffer.m_writeIndex.load( std::memory_order_acquire );
+		int64_t lastRecordTime		= GetCurrentTimeNanosecondsFast();
+		for ( int64_t recordIndex = readIndex; recordIndex < writeIndex; recordIndex++ )
+		{
+			LoggerDrainedRecord drainedRecord;
+			drainedRecord.m_record		= buffer.m_recordList[ recordIndex & m_recordIndexMask ];
+			drainedRecord.m_threadIndex	= buffer.m_threadIndex;
+			m_drainedRecordList.push_back( drainedRecord );
+			lastRecordTime				= drainedRecord.m_record.m_timeNanoseconds;
+		}
+		// Slots are free for the owner once the copies are made
+		buffer.m_readIndex.store( writeIndex, std::memory_order_release );
+
+		// Records are only dropped while the ring is full, i.e. after the newest record in it
+		int64_t numDropped = buffer.m_numDropped.load( std::memory_order_relaxed );
+		if ( numDropped != buffer.m_numDroppedReported )
+		{
+			LoggerDrainedRecord droppedNotice;
+			droppedNotice.m_record.m_timeNanoseconds	= lastRecordTime;
+			droppedNotice.m_threadIndex					= buffer.m_threadIndex;
+			droppedNotice.m_numDropped					= numDropped - buffer.m_numDroppedReported;
+			m_drainedRecordList.push_back( droppedNotice );
+			buffer.m_numDroppedReported = numDropped;
+		}
+		m_drainThreadNameList[i] = buffer.m_threadName;
+	}
+	m_threadBufferListMutex.unlock();
+
+	// Each ring is in order already, merging them by time keeps cross-thread sequences readable. Stable, so a
+	// "ring full" notice stays after the record it shares a time with
+	std::stable_sort( m_drainedRecordList.begin(), m_drainedRecordList.end(), []( LoggerDrainedRecord const& a, LoggerDrainedRecord const& b )
+	{
+		return a.m_record.m_timeNanoseconds < b.m_record.m_timeNanoseconds;
+	} );
+	for ( int i = 0; i < m_drainedRecordList.size(); i++ )
+	{
+		LoggerDrainedRecord const& drainedRecord = m_drainedRecordList[i];
+		std::string const&		   threadName	 = m_drainThreadNameList[ drainedRecord.m_threadIndex ];
+		if ( drainedRecord.m_numDropped > 0 )
+		{
+			m_drainText += Stringf( "[%12.6f] Warning   Core      %-10s Logger ring full, dropped %lld records\n", NanosecondsToSeconds( drainedRecord.m_record.m_timeNanoseconds - m_startTimeNanoseconds ),
+									threadName.c_str(), drainedRecord.m_numDropped );
+			continue;
+		}
+		FormatRecord( drainedRecord.m_record, threadName, m_line );
+		m_drainText += m_line;
+	}
+
+	if ( m_drainText.empty() )
+	{
+		return;
+	}
+	if ( m_file != nullptr )
+	{
+		fwrite( m_drainText.data(), 1, m_drainText.size(), m_file );
+		fflush( m_file );
+	}
+	if ( m_config.m_echoToDebugger )
+	{
+		// A line at a time, DebuggerPrintf truncates long messages
+		size_t lineStart = 0;
+		while ( lineStart < m_drainText.size() )
+		{
+			size_t lineEnd = m_drainText.find( '\n', lineStart );
+			lineEnd = ( lineEnd == std::string::npos ) ? m_drainText.size() : lineEnd + 1;
+			DebuggerPrintf( "%.*s", int( lineEnd - lineStart ), m_drainText.c_str() + lineStart );
+			lineStart = lineEnd;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Applies the printf format one conversion at a time, each with the argument type that was captured for it
+void LoggerSystem::FormatRecord( LogRecord const& record, std::string const& threadName, std::string& out_line ) const
+{
+	out_line = Stringf( "[%12.6f] %-9s %-9s %-10s ", NanosecondsToSeconds( record.m_timeNanoseconds - m_startTimeNanoseconds ),
+						GetLogSeverityName( record.m_severity ), GetLogCategoryName( record.m_category ), threadName.c_str() );
+
+	char const*	format		= record.m_format;
+	int			argIndex	= 0;
+	char		specifier[ 32 ];
+	char		formatted[ 256 ];
+	while ( *format != '\0' )
+	{
+		if ( *format != '%' )
+		{
+			out_line += *format++;
+			continue;
+		}
+		if ( format[1] == '%' )
+		{
+			out_line += '%';
+			format += 2;
+			continue;
+		}
+
+		// Copy flags, width and precision; drop length modifiers, the captured type decides those
+		int specifierLength			= 0;
+		specifier[ specifierLength++ ]	= *format++;
+		while ( *format != '\0' && strchr( "-+ #0123456789.", *format ) != nullptr && specifierLength < 24 )
+		{
+			specifier[ specifierLength++ ] = *format++;
+		}
+		while ( *format != '\0' && strchr( "hlLjzt", *format ) != nullptr )
+		{
+			format++;
+		}
+		char conversion = *format;
+		if ( conversion == '\0' )
+		{
+			break;
+		}
+		format++;
+
+		if ( argIndex >= record.m_numArgs )
+		{
+			out_line += "<missing>";
+			continue;
+		}
+		LogArgType	argType		= record.m_argTypeList[ argIndex ];
+		uint64_t	argValue	= record.m_argValueList[ argIndex ];
+		argIndex++;
+
+		bool isFloatConversion	= strchr( "fFeEgGaA", conversion ) != nullptr;
+		bool isIntConversion	= strchr( "diouxXc", conversion ) != nullptr;
+		if ( argType == LOG_ARG_STRING || conversion == 's' )
+		{
+			specifier[ specifierLength++ ]	= 's';
+			specifier[ specifierLength ]	= '\0';
+			char const* text = ( argType == LOG_ARG_STRING ) ? &record.m_text[ argValue ] : "<not a string>";
+			snprintf( formatted, sizeof( formatted ), specifier, text );
+		}
+		else if ( argType == LOG_ARG_POINTER || conversion == 'p' )
+		{
+			specifier[ specifierLength++ ]	= 'p';
+			specifier[ specifierLength ]	= '\0';
+			snprintf( formatted, sizeof( formatted ), specifier, reinterpret_cast<void*>( uintptr_t( argValue ) ) );
+		}
+		else if ( argType == LOG_ARG_DOUBLE )
+		{
+			double doubleValue = 0.0;
+			memcpy( &doubleValue, &argValue, sizeof( double ) );
+			specifier[ specifierLength++ ]	= isFloatConversion ? conversion : 'g';
+			specifier[ specifierLength ]	= '\0';
+			snprintf( formatted, sizeof( formatted ), specifier, doubleValue );
+		}
+		else if ( isFloatConversion )
+		{
+			// An integer passed to %f prints its value rather than garbage
+			double doubleValue = ( argType == LOG_ARG_INT ) ? double( int64_t( argValue ) ) : double( argValue );
+			specifier[ specifierLength++ ]	= conversion;
+			specifier[ specifierLength ]	= '\0';
+			snprintf( formatted, sizeof( formatted ), specifier, doubleValue );
+		}
+		else
+		{
+			specifier[ specifierLength++ ]	= 'l';
+			specifier[ specifierLength++ ]	= 'l';
+			specifier[ specifierLength++ ]	= isIntConversion ? conversion : 'd';
+			specifier[ specifierLength ]	= '\0';
+			if ( argType == LOG_ARG_INT )
+			{
+				snprintf( formatted, sizeof( formatted ), specifier, (long long)int64_t( argValue ) );
+			}
+			else
+			{
+				snprintf( formatted, sizeof( formatted ), specifier, (unsigned long long)argValue );
+			}
+		}
+		out_line += formatted;
+	}
+	out_line += '\n';
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Standalone functions
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerStartup( LoggerConfig const& config )
+{
+	LoggerSetMinSeverity( config.m_minSeverity );
+	s_theLogger.store( new LoggerSystem( config ), std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerShutdown()
+{
+	// Threads still logging would write into freed rings, so this goes after the JobSystem shuts down
+	LoggerSystem* logger = s_theLogger.exchange( nullptr );
+	delete logger;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerFlush()
+{
+	LoggerSystem* logger = s_theLogger.load( std::memory_order_acquire );
+	if ( logger != nullptr )
+	{
+		logger->Drain();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerSetCurrentThreadName( std::string const& threadName )
+{
+	t_loggerThreadName = threadName;
+	LoggerSystem* logger = s_theLogger.load( std::memory_order_acquire );
+	if ( logger != nullptr && t_loggerGeneration == logger->m_generation )
+	{
+		logger->m_threadBufferListMutex.lock();
+		t_loggerThreadBuffer->m_threadName = threadName;
+		logger->m_threadBufferListMutex.unlock();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerSetMinSeverity( LogSeverity minSeverity )
+{
+	g_loggerMinSeverity.store( int( minSeverity ), std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerSetCategoryEnabled( LogCategory category, bool isEnabled )
+{
+	if ( isEnabled )
+	{
+		g_loggerCategoryMask.fetch_or( 1u << category, std::memory_order_relaxed );
+	}
+	else
+	{
+		g_loggerCategoryMask.fetch_and( ~( 1u << category ), std::memory_order_relaxed );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+char const* GetLogSeverityName( LogSeverity severity )
+{
+	return ( severity < NUM_LOG_SEVERITIES ) ? s_logSeverityNameList[ severity ] : "Unknown";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+char const* GetLogCategoryName( LogCategory category )
+{
+	return ( category < NUM_LOG_CATEGORIES ) ? s_logCategoryNameList[ category ] : "Unknown";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LogRecord* LoggerBeginRecord( LogSeverity severity, LogCategory category, char const* format )
+{
+	LoggerThreadBuffer* buffer = t_loggerThreadBuffer;
+	LoggerSystem* logger = s_theLogger.load( std::memory_order_acquire );
+	if ( logger == nullptr )
+	{
+		return nullptr;
+	}
+	if ( t_loggerGeneration != logger->m_generation )
+	{
+		buffer = logger->RegisterCurrentThread();
+	}
+
+	int64_t writeIndex	= buffer->m_writeIndex.load( std::memory_order_relaxed );
+	int64_t readIndex	= buffer->m_readIndex.load( std::memory_order_acquire );
+	if ( writeIndex - readIndex >= int64_t( logger->m_config.m_numRecordsPerThread ) )
+	{
+		buffer->m_numDropped.store( buffer->m_numDropped.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	LogRecord& record			= buffer->m_recordList[ writeIndex & logger->m_recordIndexMask ];
+	record.m_timeNanoseconds	= GetCurrentTimeNanosecondsFast();
+	record.m_format				= format;
+	record.m_severity			= severity;
+	record.m_category			= category;
+	record.m_numArgs			= 0;
+	record.m_numTextBytes		= 0;
+	buffer->m_pendingWriteIndex	= writeIndex + 1;
+	return &record;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LoggerCommitRecord()
+{
+	LoggerThreadBuffer* buffer = t_loggerThreadBuffer;
+	buffer->m_writeIndex.store( buffer->m_pendingWriteIndex, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_Log( NamedStrings& args )
+{
+	std::string severityName = args.GetValue( "severity", "" );
+	if ( !severityName.empty() )
+	{
+		for ( int i = 0; i < NUM_LOG_SEVERITIES; i++ )
+		{
+			if ( _stricmp( severityName.c_str(), s_logSeverityNameList[i] ) == 0 )
+			{
+				LoggerSetMinSeverity( LogSeverity( i ) );
+			}
+		}
+	}
+
+	std::string categoryName = args.GetValue( "category", "" );
+	if ( !categoryName.empty() )
+	{
+		bool isEnabled = args.GetValue( "enable", true );
+		for ( int i = 0; i < NUM_LOG_CATEGORIES; i++ )
+		{
+			if ( _stricmp( categoryName.c_str(), s_logCategoryNameList[i] ) == 0 )
+			{
+				LoggerSetCategoryEnabled( LogCategory( i ), isEnabled );
+			}
+		}
+	}
+
+	if ( args.GetValue( "flush", false ) )
+	{
+		LoggerFlush();
+	}
+
+	std::string enabledCategoryList;
+	uint32_t categoryMask = g_loggerCategoryMask.load( std::memory_order_relaxed );
+	for ( int i = 0; i < NUM_LOG_CATEGORIES; i++ )
+	{
+		if ( categoryMask & ( 1u << i ) )
+		{
+			enabledCategoryList += std::string( enabledCategoryList.empty() ? "" : ", " ) + s_logCategoryNameList[i];
+		}
+	}
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Log: %s and up, categories: %s", GetLogSeverityName( LogSeverity( g_loggerMinSeverity.load() ) ), enabledCategoryList.c_str() ) );
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Compiled in: %s and up", GetLogSeverityName( LogSeverity( ENGINE_LOG_MIN_SEVERITY ) ) ) );
+	return true;
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+enum LogSeverity : uint8_t
+{
+	LOG_SEVERITY_VERBOSE,
+	LOG_SEVERITY_INFO,
+	LOG_SEVERITY_WARNING,
+	LOG_SEVERITY_ERROR,
+	NUM_LOG_SEVERITIES
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+enum LogCategory : uint8_t
+{
+	LOG_CATEGORY_GENERAL,
+	LOG_CATEGORY_CORE,
+	LOG_CATEGORY_RENDERER,
+	LOG_CATEGORY_INPUT,
+	LOG_CATEGORY_AUDIO,
+	LOG_CATEGORY_JOBS,
+	LOG_CATEGORY_ANIMATION,
+	LOG_CATEGORY_GAMEPLAY,
+	NUM_LOG_CATEGORIES
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// LOG( LOG_SEVERITY_VERBOSE, LOG_CATEGORY_ANIMATION, "LA: %0.2f, RA: %0.2f", leftArmDist, rightArmDist ) copies the
+// format pointer and the raw argument values into this thread's ring and returns; nothing is formatted or written on
+// the calling thread. A background thread drains every ring, formats the lines in time order and appends them to the
+// log file. The format must be a string literal (only the pointer is kept), strings are copied, up to
+// LOG_RECORD_TEXT_BYTES per record. When a ring is full the record is dropped and counted rather than waiting.
+// Calls below ENGINE_LOG_MIN_SEVERITY (Game/EngineBuildPreferences.hpp) compile to nothing; the rest are filtered at
+// runtime by severity and category, see "log".
+//----------------------------------------------------------------------------------------------------------------------
+#if !defined( ENGINE_LOG_MIN_SEVERITY )
+#define ENGINE_LOG_MIN_SEVERITY 0
+#endif
+
+#define LOG( severity, category, format, ... )																	\
+	do																											\
+	{																											\
+		if constexpr ( int( severity ) >= ENGINE_LOG_MIN_SEVERITY )											\
+		{																										\
+			if ( LoggerIsEnabled( severity, category ) )														\
+			{																									\
+				LoggerWrite( severity, category, format, ##__VA_ARGS__ );										\
+			}																									\
+		}																										\
+	} while ( 0 )
+
+//----------------------------------------------------------------------------------------------------------------------
+struct LoggerConfig
+{
+	std::string		m_filePath					= "Log.txt";			// Truncated at startup
+	int				m_numRecordsPerThread		= 4096;					// Ring size per thread, rounded up to a power of two
+	int				m_flushIntervalMs			= 10;
+	LogSeverity		m_minSeverity				= LOG_SEVERITY_INFO;	// Runtime filter, "log severity=verbose" lowers it
+	bool			m_echoToDebugger			= true;					// Also DebuggerPrintf each line, from the flush thread
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int LOG_RECORD_MAX_ARGS		= 8;
+constexpr int LOG_RECORD_TEXT_BYTES		= 32;
+
+//----------------------------------------------------------------------------------------------------------------------
+enum LogArgType : uint8_t
+{
+	LOG_ARG_INT,
+	LOG_ARG_UINT,
+	LOG_ARG_DOUBLE,
+	LOG_ARG_STRING,		// Value is the offset into m_text
+	LOG_ARG_POINTER
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// One LOG call as it sits in the ring, two cache lines
+struct LogRecord
+{
+	int64_t			m_timeNanoseconds						= 0;
+	char const*		m_format								= nullptr;
+	LogSeverity		m_severity								= LOG_SEVERITY_INFO;
+	LogCategory		m_category								= LOG_CATEGORY_GENERAL;
+	uint8_t			m_numArgs								= 0;
+	uint8_t			m_numTextBytes							= 0;
+	LogArgType		m_argTypeList[ LOG_RECORD_MAX_ARGS ]	= {};
+	uint64_t		m_argValueList[ LOG_RECORD_MAX_ARGS ]	= {};
+	char			m_text[ LOG_RECORD_TEXT_BYTES ]			= {};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Setup, call from the main thread
+void LoggerStartup( LoggerConfig const& config );
+void LoggerShutdown();												// Writes out everything still in the rings
+void LoggerFlush();													// Blocks until every committed record is in the file
+void LoggerSetCurrentThreadName( std::string const& threadName );
+
+//----------------------------------------------------------------------------------------------------------------------
+// Runtime filter
+extern std::atomic<int>			g_loggerMinSeverity;
+extern std::atomic<uint32_t>	g_loggerCategoryMask;
+
+void		LoggerSetMinSeverity( LogSeverity minSeverity );
+void		LoggerSetCategoryEnabled( LogCategory category, bool isEnabled );
+char const*	GetLogSeverityName( LogSeverity severity );
+char const*	GetLogCategoryName( LogCategory category );
+
+inline bool LoggerIsEnabled( LogSeverity severity, LogCategory category )
+{
+	return int( severity ) >= g_loggerMinSeverity.load( std::memory_order_relaxed ) &&
+		   ( g_loggerCategoryMask.load( std::memory_order_relaxed ) & ( 1u << category ) ) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Recording, used by LOG. BeginRecord returns this thread's next free slot, or nullptr if the logger isn't running
+// or the ring is full; CommitRecord publishes it to the flush thread
+LogRecord*	LoggerBeginRecord( LogSeverity severity, LogCategory category, char const* format );
+void		LoggerCommitRecord();
+
+//----------------------------------------------------------------------------------------------------------------------
+inline void LogAppendStringArg( LogRecord& record, char const* text )
+{
+	if ( text == nullptr )
+	{
+		text = "(null)";
+	}
+
+	// The last byte of m_text is only ever a terminator, so once it's full the remaining strings read as empty
+	int textOffset						= record.m_numTextBytes < LOG_RECORD_TEXT_BYTES - 1 ? record.m_numTextBytes : LOG_RECORD_TEXT_BYTES - 1;
+	int numCopied						= int( strnlen( text, size_t( LOG_RECORD_TEXT_BYTES - 1 - textOffset ) ) );
+	int argIndex						= record.m_numArgs++;
+	record.m_argTypeList[ argIndex ]	= LOG_ARG_STRING;
+	record.m_argValueList[ argIndex ]	= uint64_t( textOffset );
+	memcpy( &record.m_text[ textOffset ], text, size_t( numCopied ) );
+	record.m_text[ textOffset + numCopied ]	= '\0';
+	record.m_numTextBytes					= uint8_t( textOffset + numCopied + 1 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+inline void LogAppendArg( LogRecord& record, T const& value )
+{
+	if ( record.m_numArgs >= LOG_RECORD_MAX_ARGS )
+	{
+		return;
+	}
+
+	using ValueType = std::decay_t<T>;
+	if constexpr ( std::is_same_v<ValueType, std::string> )
+	{
+		LogAppendStringArg( record, value.c_str() );
+	}
+	else if constexpr ( std::is_same_v<ValueType, char*> || std::is_same_v<ValueType, char const*> )
+	{
+		LogAppendStringArg( record, value );
+	}
+	else
+	{
+		int argIndex = record.m_numArgs++;
+		if constexpr ( std::is_floating_point_v<ValueType> )
+		{
+			double doubleValue = double( value );
+			record.m_argTypeList[ argIndex ] = LOG_ARG_DOUBLE;
+			memcpy( &record.m_argValueList[ argIndex ], &doubleValue, sizeof( double ) );
+		}
+		else if constexpr ( std::is_enum_v<ValueType> || std::is_signed_v<ValueType> )
+		{
+			record.m_argTypeList[ argIndex ]	= LOG_ARG_INT;
+			record.m_argValueList[ argIndex ]	= uint64_t( int64_t( value ) );
+		}
+		else if constexpr ( std::is_integral_v<ValueType> )
+		{
+			record.m_argTypeList[ argIndex ]	= LOG_ARG_UINT;
+			record.m_argValueList[ argIndex ]	= uint64_t( value );
+		}
+		else
+		{
+			static_assert( std::is_pointer_v<ValueType>, "LOG arguments must be numbers, enums, strings or pointers" );
+			record.m_argTypeList[ argIndex ]	= LOG_ARG_POINTER;
+			record.m_argValueList[ argIndex ]	= uint64_t( uintptr_t( value ) );
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename... Args>
+inline void LoggerWrite( LogSeverity severity, LogCategory category, char const* format, Args const&... args )
+{
+	LogRecord* record = LoggerBeginRecord( severity, category, format );
+	if ( record == nullptr )
+	{
+		return;
+	}
+	( LogAppendArg( *record, args ), ... );
+	LoggerCommitRecord();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// "log" prints the filter; "log severity=verbose" changes the minimum, "log category=Animation enable=false" turns one
+// category off, "log flush=true" writes out what's buffered now
+bool Command_Log( NamedStrings& args );
@@ -0,0 +1,148 @@
+#include "Engine/Core/MPMCQueue.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------------------------------------------------
+// Same bounded try-semantics as MPMCQueue, so the two only differ in how they synchronize
+class BenchmarkMutexQueue
+{
+public:
+	explicit BenchmarkMutexQueue( int capacity ) : m_capacity( capacity ) {}
+
+	bool TryPush( int value )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if ( int( m_queue.size() ) >= m_capacity )
+		{
+			return false;
+		}
+		m_queue.push( value );
+		return true;
+	}
+
+	bool TryPop( int& out_value )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if ( m_queue.empty() )
+		{
+			return false;
+		}
+		out_value = m_queue.front();
+		m_queue.pop();
+		return true;
+	}
+
+private:
+	int				m_capacity = 0;
+	std::mutex		m_mutex;
+	std::queue<int> m_queue;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Returns the elapsed seconds, or a negative number if any item went missing
+template< typename T_Queue >
+double RunQueueBenchmark( T_Queue& queue, int numThreadsPerSide, int numItemsPerProducer )
+{
+	int const numItems = numThreadsPerSide * numItemsPerProducer;
+	std::atomic<int>		numItemsPopped	= 0;
+	std::atomic<int64_t>	poppedSum		= 0;
+	std::atomic<bool>		isStarted		= false;
+
+	std::vector<std::thread> threadList;
+	for ( int producerIndex = 0; producerIndex < numThreadsPerSide; producerIndex++ )
+	{
+		threadList.emplace_back( [ &queue, &isStarted, producerIndex, numItemsPerProducer ]()
+		{
+			while ( !isStarted )
+			{
+				std::this_thread::yield();
+			}
+			int firstValue = producerIndex * numItemsPerProducer;
+			for ( int i = 0; i < numItemsPerProducer; i++ )
+			{
+				while ( !queue.TryPush( firstValue + i ) )
+				{
+					std::this_thread::yield();
+				}
+			}
+		} );
+	}
+	for ( int consumerIndex = 0; consumerIndex < numThreadsPerSide; consumerIndex++ )
+	{
+		threadList.emplace_back( [ &queue, &isStarted, &numItemsPopped, &poppedSum, numItems ]()
+		{
+			while ( !isStarted )
+			{
+				std::this_thread::yield();
+			}
+			int64_t localSum = 0;
+			int value = 0;
+			while ( numItemsPopped.load( std::memory_order_relaxed ) < numItems )
+			{
+				if ( queue.TryPop( value ) )
+				{
+					localSum += value;
+					numItemsPopped++;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+			poppedSum += localSum;
+		} );
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	isStarted = true;
+	for ( int i = 0; i < threadList.size(); i++ )
+	{
+		threadList[i].join();
+	}
+	double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int64_t expectedSum = ( int64_t( numItems ) * int64_t( numItems - 1 ) ) / 2;
+	if ( poppedSum != expectedSum )
+	{
+		return -1.0;
+	}
+	return elapsedSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_MPMCQueueBenchmark( NamedStrings& args )
+{
+	int numItems = args.GetValue( "numItems", 1000000 );
+	int capacity = args.GetValue( "capacity", 1024 );
+
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "MPMCQueue benchmark: %d items, capacity %d, %d hardware threads", numItems, capacity, int( std::thread::hardware_concurrency() ) ) );
+	int const threadCountList[] = { 1, 2, 4, 8 };
+	for ( int numThreadsPerSide : threadCountList )
+	{
+		int numItemsPerProducer = numItems / numThreadsPerSide;
+
+		MPMCQueue<int>		lockFreeQueue( capacity );
+		BenchmarkMutexQueue mutexQueue( capacity );
+		double lockFreeSeconds	= RunQueueBenchmark( lockFreeQueue, numThreadsPerSide, numItemsPerProducer );
+		double mutexSeconds		= RunQueueBenchmark( mutexQueue,	numThreadsPerSide, numItemsPerProducer );
+		if ( lockFreeSeconds < 0.0 || mutexSeconds < 0.0 )
+		{
+			g_theDevConsole->AddLine( Rgba8::RED, Stringf( "  %dP/%dC: items went missing", numThreadsPerSide, numThreadsPerSide ) );
+			continue;
+		}
+
+		double numItemsRun = double( numItemsPerProducer * numThreadsPerSide );
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %dP/%dC: lock-free %10.0f items/sec, mutex %10.0f items/sec, %5.2fx",
+			numThreadsPerSide, numThreadsPerSide, numItemsRun / lockFreeSeconds, numItemsRun / mutexSeconds, mutexSeconds / lockFreeSeconds ) );
+	}
+	return true;
+}
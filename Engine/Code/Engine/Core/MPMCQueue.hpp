@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <utility>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Bounded lock-free multi-producer multi-consumer ring queue (Vyukov). Every slot carries a sequence number that says
+// whether it is free for the producer on that lap or filled for the consumer, so pushes and pops only ever contend on
+// one CAS each and never take a lock. FIFO per producer.
+// TryPush fails when full (leaving the value untouched) and TryPop when empty; the queue never grows, callers decide
+// what a full queue means.
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+class MPMCQueue
+{
+public:
+	explicit MPMCQueue( int capacity );			// Rounded up to a power of two
+	~MPMCQueue();
+	MPMCQueue( MPMCQueue const& copy ) = delete;
+	MPMCQueue& operator=( MPMCQueue const& copy ) = delete;
+
+	bool TryPush( T const& value );
+	bool TryPush( T&& value );
+	bool TryPop( T& out_value );
+	int	 GetCapacity() const;
+	int	 GetApproxSize() const;					// Exact only while no other thread is pushing or popping
+
+private:
+	template< typename T_Value >
+	bool Emplace( T_Value&& value );
+
+private:
+	struct Cell
+	{
+		std::atomic<uint64_t>	m_sequence = 0;
+		T						m_value;
+	};
+
+	Cell*							m_cellList	= nullptr;
+	uint64_t						m_mask		= 0;
+	alignas( 64 ) std::atomic<uint64_t>	m_pushPos	= 0;
+	alignas( 64 ) std::atomic<uint64_t>	m_popPos	= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+MPMCQueue<T>::MPMCQueue( int capacity )
+{
+	uint64_t numCells = 2;
+	while ( numCells < uint64_t( capacity ) )
+	{
+		numCells <<= 1;
+	}
+	m_mask		= numCells - 1;
+	m_cellList	= new Cell[ numCells ];
+	for ( uint64_t i = 0; i < numCells; i++ )
+	{
+		m_cellList[i].m_sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+MPMCQueue<T>::~MPMCQueue()
+{
+	delete[] m_cellList;
+	m_cellList = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+bool MPMCQueue<T>::TryPush( T const& value )
+{
+	return Emplace( value );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+bool MPMCQueue<T>::TryPush( T&& value )
+{
+	return Emplace( std::move( value ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+template< typename T_Value >
+bool MPMCQueue<T>::Emplace( T_Value&& value )
+{
+	uint64_t pos = m_pushPos.load( std::memory_order_relaxed );
+	for ( ;; )
+	{
+		Cell& cell			= m_cellList[ pos & m_mask ];
+		uint64_t sequence	= cell.m_sequence.load( std::memory_order_acquire );
+		int64_t lapDelta	= int64_t( sequence ) - int64_t( pos );
+		if ( lapDelta == 0 )
+		{
+			// Slot is free on this lap, claim it
+			if ( m_pushPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+			{
+				cell.m_value = std::forward<T_Value>( value );
+				cell.m_sequence.store( pos + 1, std::memory_order_release );
+				return true;
+			}
+		}
+		else if ( lapDelta < 0 )
+		{
+			// Slot still holds last lap's value, the queue is full
+			return false;
+		}
+		else
+		{
+			// Another producer got here first
+			pos = m_pushPos.load( std::memory_order_relaxed );
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+bool MPMCQueue<T>::TryPop( T& out_value )
+{
+	uint64_t pos = m_popPos.load( std::memory_order_relaxed );
+	for ( ;; )
+	{
+		Cell& cell			= m_cellList[ pos & m_mask ];
+		uint64_t sequence	= cell.m_sequence.load( std::memory_order_acquire );
+		int64_t lapDelta	= int64_t( sequence ) - int64_t( pos + 1 );
+		if ( lapDelta == 0 )
+		{
+			// Slot is filled on this lap, claim it
+			if ( m_popPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+			{
+				out_value = std::move( cell.m_value );
+				// Hand the slot back to producers for the next lap
+				cell.m_sequence.store( pos + m_mask + 1, std::memory_order_release );
+				return true;
+			}
+		}
+		else if ( lapDelta < 0 )
+		{
+			// Nothing published here yet, the queue is empty
+			return false;
+		}
+		else
+		{
+			// Another consumer got here first
+			pos = m_popPos.load( std::memory_order_relaxed );
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+int MPMCQueue<T>::GetCapacity() const
+{
+	return int( m_mask + 1 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+int MPMCQueue<T>::GetApproxSize() const
+{
+	uint64_t popPos		= m_popPos.load( std::memory_order_relaxed );
+	uint64_t pushPos	= m_pushPos.load( std::memory_order_relaxed );
+	if ( pushPos <= popPos )
+	{
+		return 0;
+	}
+	return int( pushPos - popPos );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Pushes and pops ints through an MPMCQueue and through a std::mutex + std::queue with 1/2/4/8 producer and consumer
+// threads each, and prints throughput to the DevConsole. Args: numItems=1000000 capacity=1024
+bool Command_MPMCQueueBenchmark( NamedStrings& args );
@@ -5,6 +5,7 @@
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Profiler.hpp"
 
 //----------------------------------------------------------------------------------------------------------------------
 OBJLoader::OBJLoader()
@@ -22,6 +23,7 @@ OBJLoader::~OBJLoader()
 //----------------------------------------------------------------------------------------------------------------------
 void OBJLoader::LoadOBJByFileName( const char* filename, Mat44 transformMat, std::vector<Vertex_PCUTBN>& outVertexes, std::vector<unsigned int>& outIndexes )
 {
+	PROFILE_SCOPE( "OBJLoader::LoadOBJByFileName" );
 	float startTime = (float)GetCurrentTimeSeconds();
 	std::string fileContent;
 	FileReadToString( fileContent, filename );
@@ -238,6 +240,7 @@ void OBJLoader::LoadOBJByFileName( const char* filename, Mat44 transformMat, std
 //----------------------------------------------------------------------------------------------------------------------
 void OBJLoader::LoadObjFile( std::string const& fileName, std::vector<Vertex_PCUTBN>& outVertsList, std::vector<unsigned int>& outIndexList, Mat44 transform )
 {
+	PROFILE_SCOPE( "OBJLoader::LoadObjFile" );
 	double timeBeforeLoading = GetCurrentTimeSeconds();
 
 	// Read the file
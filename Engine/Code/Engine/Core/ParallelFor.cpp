@@ -0,0 +1,85 @@
+#include "Engine/Core/ParallelFor.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void ParallelForJob::Execute()
+{
+	RunChunks( m_context, m_runChunk, *m_nextChunkIndex, m_numChunks );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void ParallelForJob::RunChunks( void const* context, ParallelChunkFunc runChunk, std::atomic<int>& nextChunkIndex, int numChunks )
+{
+	// Helpers that start late find nothing left and return straight away
+	int chunkIndex = nextChunkIndex++;
+	while ( chunkIndex < numChunks )
+	{
+		runChunk( context, chunkIndex );
+		chunkIndex = nextChunkIndex++;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+int GetParallelGrainSize( int numItems, int grainSize, int maxNumChunks )
+{
+	if ( grainSize <= 0 )
+	{
+		// A few chunks per thread, so a slow chunk doesn't leave everyone else waiting on it
+		int numThreads		= ( g_theJobSystem != nullptr ) ? ( g_theJobSystem->GetNumWorkers() + 1 ) : 1;
+		int numChunksWanted	= numThreads * 4;
+		grainSize			= ( numItems + numChunksWanted - 1 ) / numChunksWanted;
+	}
+	if ( maxNumChunks > 0 && ( ( numItems + grainSize - 1 ) / grainSize ) > maxNumChunks )
+	{
+		grainSize = ( numItems + maxNumChunks - 1 ) / maxNumChunks;
+	}
+	if ( grainSize < 1 )
+	{
+		grainSize = 1;
+	}
+	return grainSize;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void RunParallelChunks( int numChunks, void const* context, ParallelChunkFunc runChunk )
+{
+	JobSystem* jobSystem = g_theJobSystem;
+	int numHelperJobs	 = ( jobSystem != nullptr ) ? jobSystem->GetNumWorkers() : 0;
+	if ( numHelperJobs > numChunks - 1 )
+	{
+		numHelperJobs = numChunks - 1;
+	}
+	if ( numHelperJobs > PARALLEL_MAX_HELPER_JOBS )
+	{
+		numHelperJobs = PARALLEL_MAX_HELPER_JOBS;
+	}
+
+	std::atomic<int> nextChunkIndex = 0;
+	if ( numHelperJobs <= 0 )
+	{
+		ParallelForJob::RunChunks( context, runChunk, nextChunkIndex, numChunks );
+		return;
+	}
+
+	JobCounter		counter;
+	ParallelForJob	helperJobList[ PARALLEL_MAX_HELPER_JOBS ];
+	for ( int i = 0; i < numHelperJobs; i++ )
+	{
+		ParallelForJob& helperJob	= helperJobList[i];
+		helperJob.m_context			= context;
+		helperJob.m_runChunk		= runChunk;
+		helperJob.m_nextChunkIndex	= &nextChunkIndex;
+		helperJob.m_numChunks		= numChunks;
+		helperJob.m_priority		= JOB_PRIORITY_FRAME_CRITICAL;		// The caller is blocked on these
+		helperJob.m_name			= "ParallelFor";
+		jobSystem->PostNewJob( &helperJob, &counter );
+	}
+
+	// The caller takes chunks too, then helps with anything else queued until the helpers have returned
+	ParallelForJob::RunChunks( context, runChunk, nextChunkIndex, numChunks );
+	jobSystem->WaitFor( counter );
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------------------------
+// ParallelFor( begin, end, grainSize, []( int index ) { ... } );
+// float total = ParallelReduce( begin, end, grainSize, 0.0f, []( int index ) { return ...; }, []( float a, float b ) { return a + b; } );
+//
+// [begin, end) is split into chunks of grainSize indices (grainSize <= 0 picks one). Up to one helper job per worker
+// pulls chunks off a shared index while the calling thread does the same, and the call returns when every chunk is
+// done. The lambdas are only borrowed for the duration of the call, so nothing is copied or heap allocated.
+// ParallelReduce combines partial results in chunk order, so float results do not depend on thread timing.
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int PARALLEL_MAX_HELPER_JOBS		= 16;
+constexpr int PARALLEL_MAX_REDUCE_CHUNKS	= 64;		// Partial results live on the caller's stack
+
+typedef void (*ParallelChunkFunc)( void const* context, int chunkIndex );
+
+//----------------------------------------------------------------------------------------------------------------------
+class ParallelForJob : public Job
+{
+public:
+	virtual void Execute() override;
+	static void RunChunks( void const* context, ParallelChunkFunc runChunk, std::atomic<int>& nextChunkIndex, int numChunks );
+
+	void const*			m_context			= nullptr;
+	ParallelChunkFunc	m_runChunk			= nullptr;
+	std::atomic<int>*	m_nextChunkIndex	= nullptr;
+	int					m_numChunks			= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+int  GetParallelGrainSize( int numItems, int grainSize, int maxNumChunks );
+void RunParallelChunks( int numChunks, void const* context, ParallelChunkFunc runChunk );
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T_Func >
+struct ParallelForContext
+{
+	static void RunChunk( void const* context, int chunkIndex )
+	{
+		ParallelForContext const* forContext = static_cast<ParallelForContext const*>( context );
+		int chunkBegin	= forContext->m_begin + ( chunkIndex * forContext->m_grainSize );
+		int chunkEnd	= chunkBegin + forContext->m_grainSize;
+		if ( chunkEnd > forContext->m_end )
+		{
+			chunkEnd = forContext->m_end;
+		}
+		for ( int i = chunkBegin; i < chunkEnd; i++ )
+		{
+			(*forContext->m_func)( i );
+		}
+	}
+
+	T_Func const*	m_func		= nullptr;
+	int				m_begin		= 0;
+	int				m_end		= 0;
+	int				m_grainSize	= 1;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T, typename T_Func, typename T_CombineFunc >
+struct ParallelReduceContext
+{
+	static void RunChunk( void const* context, int chunkIndex )
+	{
+		ParallelReduceContext const* reduceContext = static_cast<ParallelReduceContext const*>( context );
+		int chunkBegin	= reduceContext->m_begin + ( chunkIndex * reduceContext->m_grainSize );
+		int chunkEnd	= chunkBegin + reduceContext->m_grainSize;
+		if ( chunkEnd > reduceContext->m_end )
+		{
+			chunkEnd = reduceContext->m_end;
+		}
+		T partialResult = *reduceContext->m_identity;
+		for ( int i = chunkBegin; i < chunkEnd; i++ )
+		{
+			partialResult = (*reduceContext->m_combineFunc)( partialResult, (*reduceContext->m_func)( i ) );
+		}
+		reduceContext->m_partialResultList[ chunkIndex ] = partialResult;
+	}
+
+	T_Func const*			m_func				= nullptr;
+	T_CombineFunc const*	m_combineFunc		= nullptr;
+	T const*				m_identity			= nullptr;
+	T*						m_partialResultList	= nullptr;
+	int						m_begin				= 0;
+	int						m_end				= 0;
+	int						m_grainSize			= 1;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T_Func >
+void ParallelFor( int begin, int end, int grainSize, T_Func const& func )
+{
+	if ( end <= begin )
+	{
+		return;
+	}
+	ParallelForContext<T_Func> context;
+	context.m_func		= &func;
+	context.m_begin		= begin;
+	context.m_end		= end;
+	context.m_grainSize	= GetParallelGrainSize( end - begin, grainSize, 0 );
+	int numChunks		= ( end - begin + context.m_grainSize - 1 ) / context.m_grainSize;
+	RunParallelChunks( numChunks, &context, &ParallelForContext<T_Func>::RunChunk );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// T must be default constructible and copyable; identity must leave any value unchanged under combineFunc
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T, typename T_Func, typename T_CombineFunc >
+T ParallelReduce( int begin, int end, int grainSize, T const& identity, T_Func const& func, T_CombineFunc const& combineFunc )
+{
+	if ( end <= begin )
+	{
+		return identity;
+	}
+	T partialResultList[ PARALLEL_MAX_REDUCE_CHUNKS ];
+	ParallelReduceContext<T, T_Func, T_CombineFunc> context;
+	context.m_func				= &func;
+	context.m_combineFunc		= &combineFunc;
+	context.m_identity			= &identity;
+	context.m_partialResultList	= partialResultList;
+	context.m_begin				= begin;
+	context.m_end				= end;
+	context.m_grainSize			= GetParallelGrainSize( end - begin, grainSize, PARALLEL_MAX_REDUCE_CHUNKS );
+	int numChunks				= ( end - begin + context.m_grainSize - 1 ) / context.m_grainSize;
+	RunParallelChunks( numChunks, &context, &ParallelReduceContext<T, T_Func, T_CombineFunc>::RunChunk );
+
+	T result = identity;
+	for ( int i = 0; i < numChunks; i++ )
+	{
+		result = combineFunc( result, partialResultList[i] );
+	}
+	return result;
+}
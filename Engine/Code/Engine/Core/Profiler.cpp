@@ -0,0 +1,478 @@
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------------------------
+struct ProfilerEvent
+{
+	char const*		m_name			= nullptr;
+	uint64_t		m_startTicks	= 0;
+	uint64_t		m_endTicks		= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Written only by its own thread. Readers trust events below m_numEvents, minus whatever the ring has overwritten
+struct ProfilerThreadBuffer
+{
+	std::string				m_threadName;
+	int						m_threadIndex				= 0;
+	ProfilerEvent*			m_eventList					= nullptr;
+	std::atomic<int64_t>	m_numEvents					= 0;
+	int64_t					m_captureFirstEventIndex	= 0;		// Main thread only
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+class ProfilerSystem
+{
+public:
+	ProfilerSystem( ProfilerConfig const& config );
+	~ProfilerSystem();
+
+	ProfilerThreadBuffer*	RegisterCurrentThread();
+	void					BeginFrame();
+	void					BuildFrameTree( uint64_t frameStartTicks, uint64_t frameEndTicks );
+	void					AppendSubtree( std::vector<ProfilerNode> const& unorderedNodeList, std::vector<std::vector<int>> const& childListList, int nodeIndex, int parentIndex, int depth );
+	void					WriteCapture();
+	void					Recalibrate();
+
+public:
+	ProfilerConfig						m_config;
+	int									m_generation				= 0;
+	int64_t								m_eventIndexMask			= 0;
+	std::thread::id						m_mainThreadID;
+	ProfilerThreadBuffer*				m_mainThreadBuffer			= nullptr;
+	std::vector<ProfilerThreadBuffer*>	m_threadBufferList;
+	std::mutex							m_threadBufferListMutex;
+
+	uint64_t							m_calibrationStartTicks		= 0;
+	double								m_calibrationStartSeconds	= 0.0;
+	double								m_secondsPerTick			= 0.0;
+
+	uint64_t							m_frameStartTicks			= 0;
+	ProfilerFrame						m_lastFrame;
+	std::vector<ProfilerEvent>			m_frameEventList;			// Scratch for BuildFrameTree
+
+	bool								m_isCaptureRequested		= false;
+	int									m_numCaptureFrames			= 0;
+	std::string							m_captureFilePath;
+	std::vector<uint64_t>				m_captureFrameStartTicksList;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<ProfilerSystem*>					s_theProfiler			= nullptr;
+static int											s_lastGeneration		= 0;
+static thread_local ProfilerThreadBuffer*			t_profilerThreadBuffer	= nullptr;
+static thread_local int								t_profilerGeneration	= 0;
+static thread_local std::string						t_profilerThreadName;
+
+//----------------------------------------------------------------------------------------------------------------------
+// ProfilerSystem class methods
+//----------------------------------------------------------------------------------------------------------------------
+ProfilerSystem::ProfilerSystem( ProfilerConfig const& config )
+	: m_config( config )
+{
+	int64_t numEventsPerThread = 2;
+	while ( numEventsPerThread < m_config.m_numEventsPerThread )
+	{
+		numEventsPerThread <<= 1;
+	}
+	m_config.m_numEventsPerThread	= int( numEventsPerThread );
+	m_eventIndexMask				= numEventsPerThread - 1;
+	m_generation					= ++s_lastGeneration;
+	m_mainThreadID					= std::this_thread::get_id();
+
+	// Start from the engine's TSC rate, Recalibrate() sharpens it every frame as the baseline grows
+	m_calibrationStartTicks		= __rdtsc();
+	m_calibrationStartSeconds	= GetCurrentTimeSeconds();
+	m_secondsPerTick			= GetSecondsPerTscTick();
+	if ( m_secondsPerTick == 0.0 )
+	{
+		// No invariant TSC, scopes will be rough but still comparable within a frame
+		while ( GetCurrentTimeSeconds() - m_calibrationStartSeconds < 0.01 )
+		{
+		}
+		Recalibrate();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ProfilerSystem::~ProfilerSystem()
+{
+	for ( int i = 0; i < m_threadBufferList.size(); i++ )
+	{
+		delete[] m_threadBufferList[i]->m_eventList;
+		delete m_threadBufferList[i];
+	}
+	m_threadBufferList.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ProfilerThreadBuffer* ProfilerSystem::RegisterCurrentThread()
+{
+	ProfilerThreadBuffer* buffer	= new ProfilerThreadBuffer();
+	buffer->m_eventList				= new ProfilerEvent[ m_config.m_numEventsPerThread ];
+
+	m_threadBufferListMutex.lock();
+	buffer->m_threadIndex = int( m_threadBufferList.size() );
+	if ( std::this_thread::get_id() == m_mainThreadID )
+	{
+		buffer->m_threadName	= "Main";
+		m_mainThreadBuffer		= buffer;
+	}
+	else
+	{
+		buffer->m_threadName = t_profilerThreadName.empty() ? Stringf( "Thread %d", buffer->m_threadIndex ) : t_profilerThreadName;
+	}
+	m_threadBufferList.push_back( buffer );
+	m_threadBufferListMutex.unlock();
+
+	t_profilerThreadBuffer	= buffer;
+	t_profilerGeneration	= m_generation;
+	return buffer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSystem::Recalibrate()
+{
+	uint64_t	nowTicks		= __rdtsc();
+	double		nowSeconds		= GetCurrentTimeSeconds();
+	// A baseline under 10 ms would be noisier than the rate we already have
+	if ( nowTicks > m_calibrationStartTicks && ( nowSeconds - m_calibrationStartSeconds ) >= 0.01 )
+	{
+		m_secondsPerTick = ( nowSeconds - m_calibrationStartSeconds ) / double( nowTicks - m_calibrationStartTicks );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSystem::BeginFrame()
+{
+	uint64_t nowTicks = __rdtsc();
+	Recalibrate();
+	if ( m_frameStartTicks != 0 )
+	{
+		BuildFrameTree( m_frameStartTicks, nowTicks );
+	}
+	m_frameStartTicks = nowTicks;
+
+	if ( m_isCaptureRequested )
+	{
+		m_isCaptureRequested = false;
+		m_captureFrameStartTicksList.clear();
+		m_threadBufferListMutex.lock();
+		for ( int i = 0; i < m_threadBufferList.size(); i++ )
+		{
+			m_threadBufferList[i]->m_captureFirstEventIndex = m_threadBufferList[i]->m_numEvents.load( std::memory_order_acquire );
+		}
+		m_threadBufferListMutex.unlock();
+		m_captureFrameStartTicksList.push_back( nowTicks );
+	}
+	else if ( !m_captureFrameStartTicksList.empty() )
+	{
+		m_captureFrameStartTicksList.push_back( nowTicks );
+		if ( int( m_captureFrameStartTicksList.size() ) > m_numCaptureFrames )
+		{
+			WriteCapture();
+			m_captureFrameStartTicksList.clear();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSystem::BuildFrameTree( uint64_t frameStartTicks, uint64_t frameEndTicks )
+{
+	m_lastFrame.m_frameIndex++;
+	m_lastFrame.m_frameMs = double( frameEndTicks - frameStartTicks ) * m_secondsPerTick * 1000.0;
+	m_lastFrame.m_nodeList.clear();
+	if ( m_mainThreadBuffer == nullptr )
+	{
+		return;
+	}
+
+	// Events land in completion order, so walk back from the newest until they finished before this frame began
+	m_frameEventList.clear();
+	int64_t lastEventIndex	= m_mainThreadBuffer->m_numEvents.load( std::memory_order_relaxed );
+	int64_t firstEventIndex = std::max( int64_t( 0 ), lastEventIndex - int64_t( m_config.m_numEventsPerThread ) );
+	for ( int64_t eventIndex = lastEventIndex - 1; eventIndex >= firstEventIndex; eventIndex-- )
+	{
+		ProfilerEvent const& event = m_mainThreadBuffer->m_eventList[ eventIndex & m_eventIndexMask ];
+		if ( event.m_endTicks < frameStartTicks )
+		{
+			break;
+		}
+		if ( event.m_startTicks >= frameStartTicks && event.m_endTicks <= frameEndTicks )
+		{
+			m_frameEventList.push_back( event );
+		}
+	}
+	std::sort( m_frameEventList.begin(), m_frameEventList.end(), []( ProfilerEvent const& a, ProfilerEvent const& b )
+	{
+		if ( a.m_startTicks != b.m_startTicks )
+		{
+			return a.m_startTicks < b.m_startTicks;
+		}
+		return a.m_endTicks > b.m_endTicks;		// Parents before the children that started on the same tick
+	} );
+
+	// Scopes on one thread nest properly, so each event's parent is the innermost open scope that contains it
+	struct OpenScope
+	{
+		int			m_nodeIndex	= -1;
+		uint64_t	m_endTicks	= 0;
+	};
+	std::vector<ProfilerNode>	unorderedNodeList;
+	std::vector<OpenScope>		openScopeList;
+	for ( int i = 0; i < m_frameEventList.size(); i++ )
+	{
+		ProfilerEvent const& event = m_frameEventList[i];
+		while ( !openScopeList.empty() && ( event.m_startTicks >= openScopeList.back().m_endTicks || event.m_endTicks > openScopeList.back().m_endTicks ) )
+		{
+			openScopeList.pop_back();
+		}
+		int parentIndex = openScopeList.empty() ? -1 : openScopeList.back().m_nodeIndex;
+
+		int nodeIndex = -1;
+		for ( int j = 0; j < unorderedNodeList.size(); j++ )
+		{
+			if ( unorderedNodeList[j].m_parentIndex == parentIndex && strcmp( unorderedNodeList[j].m_name, event.m_name ) == 0 )
+			{
+				nodeIndex = j;
+				break;
+			}
+		}
+		if ( nodeIndex < 0 )
+		{
+			ProfilerNode newNode;
+			newNode.m_name			= event.m_name;
+			newNode.m_parentIndex	= parentIndex;
+			nodeIndex				= int( unorderedNodeList.size() );
+			unorderedNodeList.push_back( newNode );
+		}
+		ProfilerNode& node = unorderedNodeList[ nodeIndex ];
+		node.m_numCalls++;
+		node.m_totalMs += double( event.m_endTicks - event.m_startTicks ) * m_secondsPerTick * 1000.0;
+
+		OpenScope openScope;
+		openScope.m_nodeIndex	= nodeIndex;
+		openScope.m_endTicks	= event.m_endTicks;
+		openScopeList.push_back( openScope );
+	}
+
+	// Self time, then reorder depth first so printing is a straight walk
+	std::vector<std::vector<int>> childListList( unorderedNodeList.size() );
+	for ( int i = 0; i < unorderedNodeList.size(); i++ )
+	{
+		unorderedNodeList[i].m_selfMs += unorderedNodeList[i].m_totalMs;
+		int parentIndex = unorderedNodeList[i].m_parentIndex;
+		if ( parentIndex >= 0 )
+		{
+			unorderedNodeList[ parentIndex ].m_selfMs -= unorderedNodeList[i].m_totalMs;
+			childListList[ parentIndex ].push_back( i );
+		}
+	}
+	for ( int i = 0; i < unorderedNodeList.size(); i++ )
+	{
+		if ( unorderedNodeList[i].m_parentIndex < 0 )
+		{
+			AppendSubtree( unorderedNodeList, childListList, i, -1, 0 );
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSystem::AppendSubtree( std::vector<ProfilerNode> const& unorderedNodeList, std::vector<std::vector<int>> const& childListList, int nodeIndex, int parentIndex, int depth )
+{
+	ProfilerNode node	= unorderedNodeList[ nodeIndex ];
+	node.m_parentIndex	= parentIndex;
+	node.m_depth		= depth;
+	int newNodeIndex	= int( m_lastFrame.m_nodeList.size() );
+	m_lastFrame.m_nodeList.push_back( node );
+	for ( int i = 0; i < childListList[ nodeIndex ].size(); i++ )
+	{
+		AppendSubtree( unorderedNodeList, childListList, childListList[ nodeIndex ][i], newNodeIndex, depth + 1 );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSystem::WriteCapture()
+{
+	// Chrome trace format, load in chrome://tracing or ui.perfetto.dev. Times are in microseconds
+	uint64_t	captureStartTicks	= m_captureFrameStartTicksList.front();
+	uint64_t	captureEndTicks		= m_captureFrameStartTicksList.back();
+	double		usPerTick			= m_secondsPerTick * 1000000.0;
+	int			numEventsWritten	= 0;
+
+	std::string json = "{\"traceEvents\":[\n";
+	m_threadBufferListMutex.lock();
+	for ( int i = 0; i < m_threadBufferList.size(); i++ )
+	{
+		ProfilerThreadBuffer const& buffer = *m_threadBufferList[i];
+		json += Stringf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n", buffer.m_threadIndex, buffer.m_threadName.c_str() );
+
+		int64_t lastEventIndex	= buffer.m_numEvents.load( std::memory_order_acquire );
+		int64_t firstEventIndex	= buffer.m_captureFirstEventIndex;
+		if ( lastEventIndex - firstEventIndex > m_config.m_numEventsPerThread )
+		{
+			// The ring wrapped, only the newest events survived
+			firstEventIndex = lastEventIndex - m_config.m_numEventsPerThread;
+		}
+		for ( int64_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; eventIndex++ )
+		{
+			ProfilerEvent const& event = buffer.m_eventList[ eventIndex & m_eventIndexMask ];
+			if ( event.m_startTicks < captureStartTicks || event.m_endTicks > captureEndTicks )
+			{
+				continue;
+			}
+			double startUs	= double( event.m_startTicks - captureStartTicks ) * usPerTick;
+			double durUs	= double( event.m_endTicks	 - event.m_startTicks )  * usPerTick;
+			json += Stringf( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f},\n", event.m_name, buffer.m_threadIndex, startUs, durUs );
+			numEventsWritten++;
+		}
+	}
+	m_threadBufferListMutex.unlock();
+
+	for ( int i = 0; i + 1 < m_captureFrameStartTicksList.size(); i++ )
+	{
+		double frameStartUs = double( m_captureFrameStartTicksList[i]	  - captureStartTicks ) * usPerTick;
+		double frameEndUs	= double( m_captureFrameStartTicksList[i + 1] - captureStartTicks ) * usPerTick;
+		json += Stringf( "{\"name\":\"Frame %d\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f},\n", i, frameStartUs, frameEndUs - frameStartUs );
+	}
+	json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Frames\"}}\n]}\n";
+
+	std::vector<char> buffer( json.begin(), json.end() );
+	WriteBinaryBufferToFile( buffer, m_captureFilePath );
+	if ( g_theDevConsole != nullptr )
+	{
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Profile of %d frames (%d scopes) written to %s", int( m_captureFrameStartTicksList.size() ) - 1, numEventsWritten, m_captureFilePath.c_str() ) );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Standalone functions
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerStartup( ProfilerConfig const& config )
+{
+	s_theProfiler.store( new ProfilerSystem( config ), std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerShutdown()
+{
+	// Threads still recording would write into freed rings, so this goes after the JobSystem shuts down
+	ProfilerSystem* profiler = s_theProfiler.exchange( nullptr );
+	delete profiler;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerBeginFrame()
+{
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	if ( profiler != nullptr )
+	{
+		profiler->BeginFrame();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerSetCurrentThreadName( std::string const& threadName )
+{
+	t_profilerThreadName = threadName;
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	if ( profiler != nullptr && t_profilerGeneration == profiler->m_generation )
+	{
+		profiler->m_threadBufferListMutex.lock();
+		t_profilerThreadBuffer->m_threadName = threadName;
+		profiler->m_threadBufferListMutex.unlock();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ProfilerFrame const& ProfilerGetLastFrame()
+{
+	static ProfilerFrame s_emptyFrame;
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	return ( profiler != nullptr ) ? profiler->m_lastFrame : s_emptyFrame;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerStartCapture( int numFrames, std::string const& filePath )
+{
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	if ( profiler == nullptr || numFrames <= 0 )
+	{
+		return;
+	}
+	profiler->m_isCaptureRequested	= true;
+	profiler->m_numCaptureFrames	= numFrames;
+	profiler->m_captureFilePath		= filePath;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ProfilerIsCapturing()
+{
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	return ( profiler != nullptr ) && ( profiler->m_isCaptureRequested || !profiler->m_captureFrameStartTicksList.empty() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double ProfilerGetSecondsPerTick()
+{
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	return ( profiler != nullptr ) ? profiler->m_secondsPerTick : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProfilerRecordScope( char const* scopeName, uint64_t startTicks, uint64_t endTicks )
+{
+	ProfilerThreadBuffer* buffer = t_profilerThreadBuffer;
+	ProfilerSystem* profiler = s_theProfiler.load( std::memory_order_acquire );
+	if ( profiler == nullptr )
+	{
+		return;
+	}
+	if ( t_profilerGeneration != profiler->m_generation )
+	{
+		buffer = profiler->RegisterCurrentThread();
+	}
+
+	int64_t eventIndex		= buffer->m_numEvents.load( std::memory_order_relaxed );
+	ProfilerEvent& event	= buffer->m_eventList[ eventIndex & profiler->m_eventIndexMask ];
+	event.m_name			= scopeName;
+	event.m_startTicks		= startTicks;
+	event.m_endTicks		= endTicks;
+	buffer->m_numEvents.store( eventIndex + 1, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_ProfileTree( NamedStrings& args )
+{
+	UNUSED( args );
+	ProfilerFrame const& frame = ProfilerGetLastFrame();
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Frame %d: %.3f ms", frame.m_frameIndex, frame.m_frameMs ) );
+	for ( int i = 0; i < frame.m_nodeList.size(); i++ )
+	{
+		ProfilerNode const& node = frame.m_nodeList[i];
+		std::string indentedName = std::string( node.m_depth * 2, ' ' ) + node.m_name;
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %-48s %8.3f ms  self %8.3f ms  x%d", indentedName.c_str(), node.m_totalMs, node.m_selfMs, node.m_numCalls ) );
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_ProfileCapture( NamedStrings& args )
+{
+	int			numFrames	= args.GetValue( "frames", 120 );
+	std::string filePath	= args.GetValue( "file", "Profile.json" );
+	ProfilerStartCapture( numFrames, filePath );
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Capturing %d frames of profile scopes to %s", numFrames, filePath.c_str() ) );
+	return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// PROFILE_SCOPE( "GameMode3D::UpdateCreature" ) times the rest of the enclosing block. The name must be a string
+// literal (or otherwise outlive the profiler), only the pointer is kept.
+// Each thread appends finished scopes to its own ring without locks; the main thread turns the last frame of its ring
+// into a call tree in ProfilerBeginFrame, and a capture writes every thread's rings out as Chrome trace JSON.
+// #define ENGINE_DISABLE_PROFILER in Game/EngineBuildPreferences.hpp to compile all of it out of the scopes.
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( ENGINE_DISABLE_PROFILER )
+#define PROFILE_SCOPE( scopeName )
+#else
+#define PROFILE_SCOPE_JOIN_INNER( a, b )	a##b
+#define PROFILE_SCOPE_JOIN( a, b )			PROFILE_SCOPE_JOIN_INNER( a, b )
+#define PROFILE_SCOPE( scopeName )			ProfileScope PROFILE_SCOPE_JOIN( profileScope_, __LINE__ )( scopeName )
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+struct ProfilerConfig
+{
+	int		m_numEventsPerThread	= 65536;		// Ring size per thread, rounded up to a power of two
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// One row of a frame's call tree. Calls to the same scope under the same parent are merged into one node
+struct ProfilerNode
+{
+	char const*		m_name			= nullptr;
+	int				m_depth			= 0;
+	int				m_parentIndex	= -1;
+	int				m_numCalls		= 0;
+	double			m_totalMs		= 0.0;
+	double			m_selfMs		= 0.0;			// Total minus children
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct ProfilerFrame
+{
+	int							m_frameIndex	= -1;
+	double						m_frameMs		= 0.0;
+	std::vector<ProfilerNode>	m_nodeList;				// Depth first, each node's children right after it
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Setup, call from the main thread
+void ProfilerStartup( ProfilerConfig const& config );
+void ProfilerShutdown();
+void ProfilerBeginFrame();													// Closes the previous frame and builds its tree
+void ProfilerSetCurrentThreadName( std::string const& threadName );		// Label for this thread in captures
+
+//----------------------------------------------------------------------------------------------------------------------
+// Output
+ProfilerFrame const&	ProfilerGetLastFrame();
+void					ProfilerStartCapture( int numFrames, std::string const& filePath );	// Chrome trace JSON, also loads in ui.perfetto.dev
+bool					ProfilerIsCapturing();
+double					ProfilerGetSecondsPerTick();
+
+//----------------------------------------------------------------------------------------------------------------------
+// Recording, used by PROFILE_SCOPE
+void ProfilerRecordScope( char const* scopeName, uint64_t startTicks, uint64_t endTicks );
+
+//----------------------------------------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+	explicit ProfileScope( char const* scopeName )
+		: m_scopeName( scopeName )
+		, m_startTicks( __rdtsc() )
+	{
+	}
+
+	~ProfileScope()
+	{
+		ProfilerRecordScope( m_scopeName, m_startTicks, __rdtsc() );
+	}
+
+	ProfileScope( ProfileScope const& copy ) = delete;
+	ProfileScope& operator=( ProfileScope const& copy ) = delete;
+
+private:
+	char const*		m_scopeName		= nullptr;
+	uint64_t		m_startTicks	= 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// "profiletree" prints the last frame's tree to the DevConsole; "profilecapture frames=120 file=Profile.json" captures
+bool Command_ProfileTree( NamedStrings& args );
+bool Command_ProfileCapture( NamedStrings& args );
@@ -0,0 +1,225 @@
+#include "Engine/Core/SampleCounters.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Running totals for one thread. Only the owning thread writes, so adding is a plain load and store; EndFrame reads
+// them from the main thread. Blocks are never freed, a thread's totals still count after it exits
+struct alignas( 64 ) SampleCounterThreadBlock
+{
+	std::atomic<int64_t>	m_totalList[ MAX_SAMPLE_COUNTERS ];
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<char const*>					s_counterNameList[ MAX_SAMPLE_COUNTERS ];
+static std::atomic<int>							s_numCounters;
+static std::mutex								s_threadBlockListMutex;
+static std::vector<SampleCounterThreadBlock*>	s_threadBlockList;
+static thread_local SampleCounterThreadBlock*	t_threadBlock				= nullptr;
+
+// Main thread only
+static int64_t									s_previousTotalList[ MAX_SAMPLE_COUNTERS ];
+static int64_t									s_lastFrameValueList[ MAX_SAMPLE_COUNTERS ];
+static int										s_numCaptureFrames			= 0;
+static std::string								s_captureFilePath;
+static std::vector<int64_t>						s_captureValueList;			// MAX_SAMPLE_COUNTERS per captured frame
+
+//----------------------------------------------------------------------------------------------------------------------
+static SampleCounterThreadBlock* RegisterCurrentThread()
+{
+	SampleCounterThreadBlock* block = new SampleCounterThreadBlock();
+	for ( int i = 0; i < MAX_SAMPLE_COUNTERS; i++ )
+	{
+		block->m_totalList[i].store( 0, std::memory_order_relaxed );
+	}
+	s_threadBlockListMutex.lock();
+	s_threadBlockList.push_back( block );
+	s_threadBlockListMutex.unlock();
+	t_threadBlock = block;
+	return block;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void WriteCapture()
+{
+	int numCounters		= s_numCounters.load( std::memory_order_acquire );
+	int numFrames		= int( s_captureValueList.size() ) / MAX_SAMPLE_COUNTERS;
+
+	std::string text = "frame";
+	for ( int i = 0; i < numCounters; i++ )
+	{
+		text += Stringf( ",%s", s_counterNameList[i].load( std::memory_order_acquire ) );
+	}
+	text += "\n";
+	for ( int frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+	{
+		int64_t const* frameValueList = &s_captureValueList[ frameIndex * MAX_SAMPLE_COUNTERS ];
+		text += Stringf( "%d", frameIndex );
+		for ( int i = 0; i < numCounters; i++ )
+		{
+			text += Stringf( ",%lld", frameValueList[i] );
+		}
+		text += "\n";
+	}
+	std::vector<char> buffer( text.begin(), text.end() );
+	WriteBinaryBufferToFile( buffer, s_captureFilePath );
+	DebuggerPrintf( "SampleCounters: wrote %d frames of %d counters to %s\n", numFrames, numCounters, s_captureFilePath.c_str() );
+
+	s_numCaptureFrames = 0;
+	s_captureValueList.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int SampleCountersGetIndex( char const* counterName )
+{
+	// Same as the allocation tags: match by pointer, then by text so the same literal from two translation units
+	// shares a slot
+	for ( int i = 0; i < MAX_SAMPLE_COUNTERS; i++ )
+	{
+		char const* slotName = s_counterNameList[i].load( std::memory_order_acquire );
+		if ( slotName == nullptr )
+		{
+			char const* expectedName = nullptr;
+			if ( s_counterNameList[i].compare_exchange_strong( expectedName, counterName, std::memory_order_acq_rel ) )
+			{
+				s_numCounters.fetch_add( 1, std::memory_order_release );
+				return i;
+			}
+			slotName = expectedName;		// Another thread claimed it first, it may be the same counter
+		}
+		if ( slotName == counterName || strcmp( slotName, counterName ) == 0 )
+		{
+			return i;
+		}
+	}
+	DebuggerPrintf( "SampleCounters: no free slot for \"%s\", raise MAX_SAMPLE_COUNTERS\n", counterName );
+	return -1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SampleCountersAdd( int counterIndex, int64_t amount )
+{
+	if ( counterIndex < 0 )
+	{
+		return;
+	}
+	SampleCounterThreadBlock* block = t_threadBlock;
+	if ( block == nullptr )
+	{
+		block = RegisterCurrentThread();
+	}
+	std::atomic<int64_t>& total = block->m_totalList[ counterIndex ];
+	total.store( total.load( std::memory_order_relaxed ) + amount, std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SampleCountersEndFrame()
+{
+	int64_t totalList[ MAX_SAMPLE_COUNTERS ] = {};
+	s_threadBlockListMutex.lock();
+	for ( int blockIndex = 0; blockIndex < s_threadBlockList.size(); blockIndex++ )
+	{
+		SampleCounterThreadBlock const& block = *s_threadBlockList[ blockIndex ];
+		for ( int i = 0; i < MAX_SAMPLE_COUNTERS; i++ )
+		{
+			totalList[i] += block.m_totalList[i].load( std::memory_order_relaxed );
+		}
+	}
+	s_threadBlockListMutex.unlock();
+
+	for ( int i = 0; i < MAX_SAMPLE_COUNTERS; i++ )
+	{
+		s_lastFrameValueList[i]	= totalList[i] - s_previousTotalList[i];
+		s_previousTotalList[i]	= totalList[i];
+	}
+
+	if ( s_numCaptureFrames > 0 )
+	{
+		s_captureValueList.insert( s_captureValueList.end(), s_lastFrameValueList, s_lastFrameValueList + MAX_SAMPLE_COUNTERS );
+		if ( int( s_captureValueList.size() ) >= s_numCaptureFrames * MAX_SAMPLE_COUNTERS )
+		{
+			WriteCapture();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int SampleCountersGetNumCounters()
+{
+	return s_numCounters.load( std::memory_order_acquire );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+char const* SampleCountersGetName( int counterIndex )
+{
+	char const* counterName = s_counterNameList[ counterIndex ].load( std::memory_order_acquire );
+	return ( counterName != nullptr ) ? counterName : "";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int64_t SampleCountersGetLastFrameValue( int counterIndex )
+{
+	return s_lastFrameValueList[ counterIndex ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SampleCountersStartCapture( int numFrames, std::string const& filePath )
+{
+	if ( numFrames <= 0 )
+	{
+		return;
+	}
+	s_numCaptureFrames	= numFrames;
+	s_captureFilePath	= filePath;
+	s_captureValueList.clear();
+	s_captureValueList.reserve( size_t( numFrames ) * MAX_SAMPLE_COUNTERS );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SampleCountersStopCapture()
+{
+	if ( s_numCaptureFrames > 0 )
+	{
+		WriteCapture();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SampleCountersIsCapturing()
+{
+	return s_numCaptureFrames > 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_Counters( NamedStrings& args )
+{
+	int numFrames = args.GetValue( "frames", 0 );
+	if ( numFrames > 0 )
+	{
+		std::string filePath = args.GetValue( "file", "Counters.csv" );
+		SampleCountersStartCapture( numFrames, filePath );
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Capturing %d frames of counters to %s", numFrames, filePath.c_str() ) );
+		return true;
+	}
+
+	int numCounters = SampleCountersGetNumCounters();
+	if ( numCounters == 0 )
+	{
+		g_theDevConsole->AddLine( Rgba8::GREEN, "No counters have been added to yet" );
+		return true;
+	}
+	for ( int i = 0; i < numCounters; i++ )
+	{
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %-24s %10lld", SampleCountersGetName(i), SampleCountersGetLastFrameValue(i) ) );
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <stdint.h>
+#include <string>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// COUNTER_ADD( "Raycasts", 1 ) adds to a named per-frame count, for the work a frame does rather than how long it
+// took: a query that suddenly tests every block shows up here even when the frame is still fast enough.
+// Each thread adds to its own block of totals without locks; SampleCountersEndFrame (main thread) sums the blocks and
+// keeps the difference from the previous frame, so work from jobs still running at EndFrame lands in the next frame.
+// Inside hot loops, count into a local and add once. Counter names must be string literals (only the pointer is kept)
+// and there are at most MAX_SAMPLE_COUNTERS of them.
+// #define ENGINE_DISABLE_COUNTERS in Game/EngineBuildPreferences.hpp to compile COUNTER_ADD out.
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( ENGINE_DISABLE_COUNTERS )
+#define COUNTER_ADD( counterName, amount )
+#else
+#define COUNTER_ADD( counterName, amount )															\
+	do																								\
+	{																								\
+		static int const counterIndex_ = SampleCountersGetIndex( counterName );						\
+		SampleCountersAdd( counterIndex_, int64_t( amount ) );										\
+	} while ( 0 )
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr int MAX_SAMPLE_COUNTERS = 64;
+
+//----------------------------------------------------------------------------------------------------------------------
+void			SampleCountersEndFrame();										// Main thread, closes the frame
+int				SampleCountersGetNumCounters();									// Registered so far, in registration order
+char const*		SampleCountersGetName( int counterIndex );
+int64_t			SampleCountersGetLastFrameValue( int counterIndex );
+
+//----------------------------------------------------------------------------------------------------------------------
+// Writes one CSV row per frame for the next numFrames EndFrames, a column per counter. StopCapture writes out a
+// capture that hasn't finished yet
+void			SampleCountersStartCapture( int numFrames, std::string const& filePath );
+void			SampleCountersStopCapture();
+bool			SampleCountersIsCapturing();
+
+//----------------------------------------------------------------------------------------------------------------------
+// Used by COUNTER_ADD
+int				SampleCountersGetIndex( char const* counterName );				// -1 once every slot is taken
+void			SampleCountersAdd( int counterIndex, int64_t amount );
+
+//----------------------------------------------------------------------------------------------------------------------
+// "counters" prints the last frame; "counters frames=300 file=Counters.csv" captures the next 300 frames
+bool Command_Counters( NamedStrings& args );
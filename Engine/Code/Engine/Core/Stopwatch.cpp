@@ -6,7 +6,7 @@
 Stopwatch::Stopwatch( float duration )
 {
 	// #CheckIfCorrect
-	m_duration	= duration;
+	SetDuration( duration );
 	m_clock		= &m_clock->GetSystemClock();
 }
 
@@ -15,7 +15,7 @@ Stopwatch::Stopwatch( Clock const* clock, float duration )
 {
 	// #CheckIfCorrect
 	m_clock		= clock;
-	m_duration	= duration;
+	SetDuration( duration );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -26,7 +26,7 @@ Stopwatch::Stopwatch()
 //----------------------------------------------------------------------------------------------------------------------
 void Stopwatch::Start()
 {
-	m_startTime = m_clock->GetTotalSeconds();
+	m_startTimeNanoseconds = m_clock->GetTotalNanoseconds();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -41,7 +41,7 @@ void Stopwatch::Restart()
 //----------------------------------------------------------------------------------------------------------------------
 void Stopwatch::Stop()
 {
-	m_startTime = 0.0f;
+	m_startTimeNanoseconds = 0;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -52,32 +52,45 @@ float Stopwatch::GetElapsedTime() const
 		return 0.0f;
 	}
 
-	float  currentTimeInSeconds  = static_cast<float>( m_clock->GetTotalSeconds() );
-	float  elapsedTime			 = currentTimeInSeconds - m_startTime;
-	return elapsedTime;
+	// Subtract in nanoseconds, only the (small) difference is converted to float
+	int64_t	elapsedNanoseconds	= m_clock->GetTotalNanoseconds() - m_startTimeNanoseconds;
+	float	elapsedTime			= static_cast<float>( NanosecondsToSeconds( elapsedNanoseconds ) );
+	return	elapsedTime;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 float Stopwatch::GetElapsedFraction() const
 {
-	if ( m_duration == 0.0f )
+	if ( m_durationNanoseconds == 0 || IsStopped() )
 	{
 		return 0.0f;
 	}
 
-	float	elapsedTime		= GetElapsedTime();
-	float	elapsedFraction	= elapsedTime / m_duration;			// calculates how many durations have passed
+	int64_t	elapsedNanoseconds	= m_clock->GetTotalNanoseconds() - m_startTimeNanoseconds;
+	float	elapsedFraction		= static_cast<float>( double( elapsedNanoseconds ) / double( m_durationNanoseconds ) );		// calculates how many durations have passed
 	return	elapsedFraction;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+float Stopwatch::GetDuration() const
+{
+	return static_cast<float>( NanosecondsToSeconds( m_durationNanoseconds ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Stopwatch::SetDuration( float duration )
+{
+	m_durationNanoseconds = SecondsToNanoseconds( duration );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool Stopwatch::IsStopped() const
 {
-	return m_startTime == 0.0f;
+	return m_startTimeNanoseconds == 0;
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Code above is the same as below;
-//	if ( m_startTime == 0.0f )
+//	if ( m_startTimeNanoseconds == 0 )
 //	{
 //		return true;
 //	}
@@ -88,18 +101,12 @@ bool Stopwatch::IsStopped() const
 //----------------------------------------------------------------------------------------------------------------------
 bool Stopwatch::HasDurationElapsed() const
 {
-	float elapsedTime = GetElapsedTime();
-	return ( elapsedTime > m_duration ) && ( !IsStopped() );
-
-	//----------------------------------------------------------------------------------------------------------------------
-	// Code above is the same as below;
-//	float elapsedTime = GetElapsedTime();
-//	if ( elapsedTime > m_duration && !IsStopped() )
-//	{
-//		return true;
-//	}
-//
-//	return false;
+	if ( IsStopped() )
+	{
+		return false;
+	}
+	int64_t elapsedNanoseconds = m_clock->GetTotalNanoseconds() - m_startTimeNanoseconds;
+	return elapsedNanoseconds > m_durationNanoseconds;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -109,7 +116,7 @@ bool Stopwatch::DecrementDurationIfElapsed()
 	bool durationHasElapsed = HasDurationElapsed();
 	if ( durationHasElapsed && !IsStopped() )
 	{
-		m_startTime += m_duration;
+		m_startTimeNanoseconds += m_durationNanoseconds;
 		return true;
 	}
 	return false;
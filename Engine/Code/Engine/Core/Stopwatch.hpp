@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 //----------------------------------------------------------------------------------------------------------------------
 class Clock;
 
@@ -17,12 +19,14 @@ public:
 	
 	float	GetElapsedTime()				const;
 	float	GetElapsedFraction()			const;
+	float	GetDuration()					const;
+	void	SetDuration( float duration );
 	bool	IsStopped()						const;
 	bool	HasDurationElapsed()			const;
 	bool	DecrementDurationIfElapsed();
 
 public:
-	Clock const* 	m_clock			= nullptr;
-	float			m_startTime		= 0.0f;
-	float			m_duration		= 0.0f;
+	Clock const* 	m_clock						= nullptr;
+	int64_t			m_startTimeNanoseconds		= 0;		// On m_clock; 0 means stopped
+	int64_t			m_durationNanoseconds		= 0;
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "Engine/Core/Task.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sentinel values for TaskPromiseBase::m_state, never valid coroutine addresses
+//----------------------------------------------------------------------------------------------------------------------
+static char s_taskStateDone;
+static char s_taskStateDetached;
+static void* const TASK_STATE_DONE		= &s_taskStateDone;
+static void* const TASK_STATE_DETACHED	= &s_taskStateDetached;
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void TaskPromiseBase::unhandled_exception()
+{
+	ERROR_AND_DIE( "Unhandled exception inside a Task" );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend( std::coroutine_handle<> finishedTask ) noexcept
+{
+	void* prevState = m_promise->m_state.exchange( TASK_STATE_DONE );
+	if ( prevState == TASK_STATE_DETACHED )
+	{
+		// Nobody will ever read the result
+		finishedTask.destroy();
+		return std::noop_coroutine();
+	}
+	if ( prevState != nullptr )
+	{
+		// Resume the awaiting coroutine right here, without a trip through the job system
+		return std::coroutine_handle<>::from_address( prevState );
+	}
+	return std::noop_coroutine();
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TaskPromiseBase::IsDone() const
+{
+	return ( m_state.load() == TASK_STATE_DONE );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TaskPromiseBase::TrySetContinuation( std::coroutine_handle<> continuation )
+{
+	void* expectedState = nullptr;
+	return m_state.compare_exchange_strong( expectedState, continuation.address() );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void TaskPromiseBase::Detach( std::coroutine_handle<> task )
+{
+	void* expectedState = nullptr;
+	if ( !m_state.compare_exchange_strong( expectedState, TASK_STATE_DETACHED ) )
+	{
+		// Already finished and parked at its final suspend, free it now
+		if ( expectedState == TASK_STATE_DONE )
+		{
+			task.destroy();
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Task<void>& Task<void>::operator=( Task&& other ) noexcept
+{
+	if ( this != &other )
+	{
+		if ( m_handle )
+		{
+			m_handle.promise().Detach( m_handle );
+		}
+		m_handle		= other.m_handle;
+		other.m_handle	= nullptr;
+	}
+	return *this;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+Task<void>::~Task()
+{
+	if ( m_handle )
+	{
+		m_handle.promise().Detach( m_handle );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void SwitchToJobSystem::await_suspend( std::coroutine_handle<> task ) const
+{
+	g_theJobSystem->ResumeTaskOnWorker( task );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void NextFrame::await_suspend( std::coroutine_handle<> task ) const
+{
+	g_theJobSystem->ResumeTaskOnMainThread( task );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WaitForSeconds::await_suspend( std::coroutine_handle<> task ) const
+{
+	g_theJobSystem->ResumeTaskOnMainThread( task, g_theJobSystem->GetTaskClockSeconds() + m_seconds );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+void WaitForJobs::await_suspend( std::coroutine_handle<> task ) const
+{
+	g_theJobSystem->ResumeTaskOnMainThread( task, 0.0, m_counter );
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Coroutine tasks scheduled by g_theJobSystem, for multi-frame work that would otherwise be a state machine of flags.
+//
+//	Task<float> GameMode3D::ProbeGroundAsync( Vec3 footPos )
+//	{
+//		co_await SwitchToJobSystem();				// Rest runs on a worker
+//		float height = RaycastDown( footPos );
+//		co_await NextFrame();						// Back on the main thread at the start of next frame
+//		co_await WaitForSeconds( 0.25 );
+//		co_return height;
+//	}
+//
+// A Task starts running as soon as it is called and runs on the calling thread up to its first suspension.
+// co_await another Task to suspend until it finishes; the awaiter resumes on whichever thread finished it. Dropping a Task detaches it: it keeps running and cleans itself
+// up when it finishes. Resumes that go through the job system follow the frame job rules (see PostFrameJob).
+//----------------------------------------------------------------------------------------------------------------------
+class TaskPromiseBase
+{
+public:
+	std::suspend_never	initial_suspend() noexcept { return {}; }
+	void				unhandled_exception();
+
+	// Final suspend hands control to whoever is co_awaiting this task, or frees the frame if nobody owns it
+	struct FinalAwaiter
+	{
+		bool					await_ready() noexcept { return false; }
+		std::coroutine_handle<>	await_suspend( std::coroutine_handle<> finishedTask ) noexcept;
+		void					await_resume() noexcept {}
+
+		TaskPromiseBase*		m_promise = nullptr;
+	};
+	FinalAwaiter final_suspend() noexcept { return FinalAwaiter{ this }; }
+
+	bool IsDone() const;
+	bool TrySetContinuation( std::coroutine_handle<> continuation );		// false if the task already finished
+	void Detach( std::coroutine_handle<> task );
+
+public:
+	// nullptr while running, then the awaiting coroutine's address, TASK_STATE_DONE or TASK_STATE_DETACHED
+	std::atomic<void*>	m_state = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+class Task
+{
+public:
+	struct promise_type : public TaskPromiseBase
+	{
+		Task	get_return_object()				{ return Task( std::coroutine_handle<promise_type>::from_promise( *this ) ); }
+		void	return_value( T const& value )	{ m_result = value; }
+
+		std::optional<T> m_result;
+	};
+
+	Task() {}
+	explicit Task( std::coroutine_handle<promise_type> handle ) : m_handle( handle ) {}
+	Task( Task&& other ) noexcept : m_handle( other.m_handle ) { other.m_handle = nullptr; }
+	Task& operator=( Task&& other ) noexcept;
+	Task( Task const& copy ) = delete;
+	~Task();
+
+	bool	 IsDone() const		{ return m_handle && m_handle.promise().IsDone(); }
+	T const& GetResult() const	{ return *m_handle.promise().m_result; }		// Only once IsDone()
+
+	// co_await support
+	bool	 await_ready() const											{ return IsDone(); }
+	bool	 await_suspend( std::coroutine_handle<> awaitingCoroutine )	{ return m_handle.promise().TrySetContinuation( awaitingCoroutine ); }
+	T		 await_resume() const										{ return GetResult(); }
+
+private:
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+class Task<void>
+{
+public:
+	struct promise_type : public TaskPromiseBase
+	{
+		Task	get_return_object()	{ return Task( std::coroutine_handle<promise_type>::from_promise( *this ) ); }
+		void	return_void()		{}
+	};
+
+	Task() {}
+	explicit Task( std::coroutine_handle<promise_type> handle ) : m_handle( handle ) {}
+	Task( Task&& other ) noexcept : m_handle( other.m_handle ) { other.m_handle = nullptr; }
+	Task& operator=( Task&& other ) noexcept;
+	Task( Task const& copy ) = delete;
+	~Task();
+
+	bool IsDone() const	{ return m_handle && m_handle.promise().IsDone(); }
+
+	// co_await support
+	bool await_ready() const											{ return IsDone(); }
+	bool await_suspend( std::coroutine_handle<> awaitingCoroutine )	{ return m_handle.promise().TrySetContinuation( awaitingCoroutine ); }
+	void await_resume() const											{}
+
+private:
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+Task<T>& Task<T>::operator=( Task&& other ) noexcept
+{
+	if ( this != &other )
+	{
+		if ( m_handle )
+		{
+			m_handle.promise().Detach( m_handle );
+		}
+		m_handle		= other.m_handle;
+		other.m_handle	= nullptr;
+	}
+	return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template< typename T >
+Task<T>::~Task()
+{
+	if ( m_handle )
+	{
+		m_handle.promise().Detach( m_handle );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Awaitables
+//----------------------------------------------------------------------------------------------------------------------
+struct SwitchToJobSystem
+{
+	bool await_ready() const { return false; }
+	void await_suspend( std::coroutine_handle<> task ) const;
+	void await_resume() const {}
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct NextFrame
+{
+	bool await_ready() const { return false; }
+	void await_suspend( std::coroutine_handle<> task ) const;
+	void await_resume() const {}
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Resumes on the main thread at the first BeginFrame after the delay, measured on the job system's task clock
+//----------------------------------------------------------------------------------------------------------------------
+struct WaitForSeconds
+{
+	explicit WaitForSeconds( double seconds ) : m_seconds( seconds ) {}
+	bool await_ready() const { return m_seconds <= 0.0; }
+	void await_suspend( std::coroutine_handle<> task ) const;
+	void await_resume() const {}
+
+	double m_seconds = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Resumes on the main thread at the first BeginFrame after every job on the counter has finished
+//----------------------------------------------------------------------------------------------------------------------
+struct WaitForJobs
+{
+	explicit WaitForJobs( JobCounter const& counter ) : m_counter( &counter ) {}
+	bool await_ready() const { return m_counter->IsDone(); }
+	void await_suspend( std::coroutine_handle<> task ) const;
+	void await_resume() const {}
+
+	JobCounter const* m_counter = nullptr;
+};
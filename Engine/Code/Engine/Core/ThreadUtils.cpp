@@ -0,0 +1,202 @@
+#include "Engine/Core/ThreadUtils.hpp"
+
+#include <algorithm>
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#endif
+
+#if defined( _WIN32 )
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<CpuCore> GetAllowedCpuCores()
+{
+	std::vector<CpuCore> coreList;
+	DWORD_PTR processMask	= 0;
+	DWORD_PTR systemMask	= 0;
+	if ( !GetProcessAffinityMask( GetCurrentProcess(), &processMask, &systemMask ) )
+	{
+		return coreList;
+	}
+
+	DWORD bufferSize = 0;
+	GetLogicalProcessorInformationEx( RelationProcessorCore, nullptr, &bufferSize );
+	if ( bufferSize == 0 )
+	{
+		return coreList;
+	}
+	std::vector<char> buffer( bufferSize );
+	if ( !GetLogicalProcessorInformationEx( RelationProcessorCore, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>( buffer.data() ), &bufferSize ) )
+	{
+		return coreList;
+	}
+
+	int coreIndex = 0;
+	for ( DWORD offset = 0; offset < bufferSize; )
+	{
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>( buffer.data() + offset );
+		offset += info->Size;
+
+		// SetThreadAffinityMask can only address the calling thread's group, which is group 0 for us
+		GROUP_AFFINITY const& groupAffinity = info->Processor.GroupMask[0];
+		CpuCore core;
+		core.m_coreIndex = coreIndex++;
+		if ( groupAffinity.Group != 0 )
+		{
+			continue;
+		}
+		for ( int cpu = 0; cpu < 64; cpu++ )
+		{
+			KAFFINITY cpuBit = KAFFINITY( 1 ) << cpu;
+			if ( ( groupAffinity.Mask & processMask & cpuBit ) != 0 )
+			{
+				core.m_logicalCpuList.push_back( cpu );
+			}
+		}
+		if ( !core.m_logicalCpuList.empty() )
+		{
+			coreList.push_back( core );
+		}
+	}
+
+	std::sort( coreList.begin(), coreList.end(), []( CpuCore const& a, CpuCore const& b ) { return a.m_logicalCpuList[0] < b.m_logicalCpuList[0]; } );
+	return coreList;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SetCurrentThreadAffinity( std::vector<int> const& logicalCpuList )
+{
+	DWORD_PTR threadMask = 0;
+	for ( int i = 0; i < logicalCpuList.size(); i++ )
+	{
+		if ( logicalCpuList[i] >= 0 && logicalCpuList[i] < 64 )
+		{
+			threadMask |= DWORD_PTR( 1 ) << logicalCpuList[i];
+		}
+	}
+	if ( threadMask == 0 )
+	{
+		return false;
+	}
+	return SetThreadAffinityMask( GetCurrentThread(), threadMask ) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SetCurrentThreadName( std::string const& threadName )
+{
+	// SetThreadDescription is Windows 10 1607+, look it up so older systems still run (unnamed)
+	typedef HRESULT ( WINAPI *SetThreadDescriptionFuncPtr )( HANDLE thread, PCWSTR description );
+	static SetThreadDescriptionFuncPtr setThreadDescription = reinterpret_cast<SetThreadDescriptionFuncPtr>( GetProcAddress( GetModuleHandleW( L"kernel32.dll" ), "SetThreadDescription" ) );
+	if ( setThreadDescription == nullptr )
+	{
+		return;
+	}
+	std::wstring wideName( threadName.begin(), threadName.end() );
+	setThreadDescription( GetCurrentThread(), wideName.c_str() );
+}
+
+#else
+//----------------------------------------------------------------------------------------------------------------------
+// -1 if the file is missing (some containers hide the topology)
+int ReadCpuTopologyValue( int cpu, char const* valueName )
+{
+	char filePath[ 128 ];
+	snprintf( filePath, sizeof( filePath ), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, valueName );
+	FILE* file = fopen( filePath, "r" );
+	if ( file == nullptr )
+	{
+		return -1;
+	}
+	int value = -1;
+	if ( fscanf( file, "%d", &value ) != 1 )
+	{
+		value = -1;
+	}
+	fclose( file );
+	return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<CpuCore> GetAllowedCpuCores()
+{
+	std::vector<CpuCore> coreList;
+	cpu_set_t allowedCpuSet;
+	CPU_ZERO( &allowedCpuSet );
+	if ( sched_getaffinity( 0, sizeof( allowedCpuSet ), &allowedCpuSet ) != 0 )
+	{
+		return coreList;
+	}
+
+	for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ )
+	{
+		if ( !CPU_ISSET( cpu, &allowedCpuSet ) )
+		{
+			continue;
+		}
+		int packageIndex	= ReadCpuTopologyValue( cpu, "physical_package_id" );
+		int coreIndex		= ReadCpuTopologyValue( cpu, "core_id" );
+		if ( coreIndex < 0 )
+		{
+			// No topology, every logical CPU has to count as its own core
+			packageIndex	= 0;
+			coreIndex		= cpu;
+		}
+		packageIndex = std::max( packageIndex, 0 );
+
+		CpuCore* core = nullptr;
+		for ( int i = 0; i < coreList.size(); i++ )
+		{
+			if ( coreList[i].m_packageIndex == packageIndex && coreList[i].m_coreIndex == coreIndex )
+			{
+				core = &coreList[i];
+				break;
+			}
+		}
+		if ( core == nullptr )
+		{
+			coreList.emplace_back();
+			core					= &coreList.back();
+			core->m_packageIndex	= packageIndex;
+			core->m_coreIndex		= coreIndex;
+		}
+		core->m_logicalCpuList.push_back( cpu );
+	}
+
+	// CPUs were visited in order, so each core's first CPU is already its lowest
+	std::sort( coreList.begin(), coreList.end(), []( CpuCore const& a, CpuCore const& b ) { return a.m_logicalCpuList[0] < b.m_logicalCpuList[0]; } );
+	return coreList;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SetCurrentThreadAffinity( std::vector<int> const& logicalCpuList )
+{
+	cpu_set_t cpuSet;
+	CPU_ZERO( &cpuSet );
+	int numCpusSet = 0;
+	for ( int i = 0; i < logicalCpuList.size(); i++ )
+	{
+		if ( logicalCpuList[i] >= 0 && logicalCpuList[i] < CPU_SETSIZE )
+		{
+			CPU_SET( logicalCpuList[i], &cpuSet );
+			numCpusSet++;
+		}
+	}
+	if ( numCpusSet == 0 )
+	{
+		return false;
+	}
+	return pthread_setaffinity_np( pthread_self(), sizeof( cpuSet ), &cpuSet ) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SetCurrentThreadName( std::string const& threadName )
+{
+	// The kernel keeps 15 characters plus the terminator and rejects anything longer outright
+	std::string truncatedName = threadName.substr( 0, 15 );
+	pthread_setname_np( pthread_self(), truncatedName.c_str() );
+}
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// One physical core and the logical CPUs (SMT siblings) that share it
+struct CpuCore
+{
+	int					m_packageIndex	= 0;
+	int					m_coreIndex		= 0;		// Unique within its package only
+	std::vector<int>	m_logicalCpuList;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Physical cores this process is allowed to run on (affinity/cpuset already applied), sorted by their first logical CPU.
+// Windows reads GetLogicalProcessorInformationEx and only sees the first processor group (64 logical CPUs);
+// Linux reads /sys/devices/system/cpu/cpuN/topology. Empty if the topology couldn't be read.
+std::vector<CpuCore> GetAllowedCpuCores();
+
+// Both only affect the calling thread. Affinity returns false if the OS refused it (e.g. CPUs outside the cpuset).
+// Linux truncates names past 15 characters.
+bool SetCurrentThreadAffinity( std::vector<int> const& logicalCpuList );
+void SetCurrentThreadName( std::string const& threadName );
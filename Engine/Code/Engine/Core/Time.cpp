@@ -4,27 +4,150 @@
 
 //-----------------------------------------------------------------------------------------------
 #include "Engine/Core/Time.hpp"
+
+#if defined( _WIN32 )
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <time.h>
+#include <x86intrin.h>
+#endif
+
 
+#if defined( _WIN32 )
 //-----------------------------------------------------------------------------------------------
-double InitializeTime( LARGE_INTEGER& out_initialTime )
+int64_t InitializeTime( LARGE_INTEGER& out_initialTime )
 {
 	LARGE_INTEGER countsPerSecond;
 	QueryPerformanceFrequency( &countsPerSecond );
 	QueryPerformanceCounter( &out_initialTime );
-	return( 1.0 / static_cast< double >( countsPerSecond.QuadPart ) );
+	return countsPerSecond.QuadPart;
 }
 
 //-----------------------------------------------------------------------------------------------
-double GetCurrentTimeSeconds()
+int64_t GetCurrentTimeNanoseconds()
 {
 	static LARGE_INTEGER initialTime;
-	static double secondsPerCount = InitializeTime( initialTime );
+	static int64_t countsPerSecond = InitializeTime( initialTime );
 	LARGE_INTEGER currentCount;
 	QueryPerformanceCounter( &currentCount );
-	LONGLONG elapsedCountsSinceInitialTime = currentCount.QuadPart - initialTime.QuadPart;
+	int64_t elapsedCountsSinceInitialTime = currentCount.QuadPart - initialTime.QuadPart;
+
+	// Whole seconds and the remainder separately, counts * 1e9 would overflow after ~15 minutes at 10 MHz
+	int64_t wholeSeconds	= elapsedCountsSinceInitialTime / countsPerSecond;
+	int64_t remainderCounts	= elapsedCountsSinceInitialTime % countsPerSecond;
+	return ( wholeSeconds * NANOSECONDS_PER_SECOND ) + ( ( remainderCounts * NANOSECONDS_PER_SECOND ) / countsPerSecond );
+}
+
+//-----------------------------------------------------------------------------------------------
+bool HasInvariantTsc()
+{
+	int cpuInfo[4] = {};
+	__cpuid( cpuInfo, 0x80000000 );
+	if ( unsigned( cpuInfo[0] ) < 0x80000007 )
+	{
+		return false;
+	}
+	__cpuid( cpuInfo, 0x80000007 );
+	return ( cpuInfo[3] & ( 1 << 8 ) ) != 0;
+}
 
-	double currentSeconds = static_cast< double >( elapsedCountsSinceInitialTime ) * secondsPerCount;
-	return currentSeconds;
+#else
+//-----------------------------------------------------------------------------------------------
+int64_t ReadMonotonicNanoseconds()
+{
+	timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return ( int64_t( now.tv_sec ) * NANOSECONDS_PER_SECOND ) + int64_t( now.tv_nsec );
+}
+
+//-----------------------------------------------------------------------------------------------
+int64_t GetCurrentTimeNanoseconds()
+{
+	static int64_t initialTime = ReadMonotonicNanoseconds();
+	return ReadMonotonicNanoseconds() - initialTime;
+}
+
+//-----------------------------------------------------------------------------------------------
+bool HasInvariantTsc()
+{
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+	if ( !__get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) )
+	{
+		return false;
+	}
+	return ( edx & ( 1u << 8 ) ) != 0;
+}
+#endif
+
+//-----------------------------------------------------------------------------------------------
+double GetCurrentTimeSeconds()
+{
+	return NanosecondsToSeconds( GetCurrentTimeNanoseconds() );
+}
+
+//-----------------------------------------------------------------------------------------------
+struct TscCalibration
+{
+	uint64_t	m_startTicks			= 0;
+	double		m_secondsPerTick		= 0.0;		// 0 means no invariant TSC
+	double		m_nanosecondsPerTick	= 0.0;
+};
+
+//-----------------------------------------------------------------------------------------------
+TscCalibration CalibrateTsc()
+{
+	TscCalibration calibration;
+	if ( !HasInvariantTsc() )
+	{
+		return calibration;
+	}
+
+	// 10 ms against the OS clock puts the rate within a few ppm, it only runs once
+	uint64_t	startTicks			= __rdtsc();
+	int64_t		startNanoseconds	= GetCurrentTimeNanoseconds();
+	int64_t		elapsedNanoseconds	= 0;
+	while ( elapsedNanoseconds < 10'000'000 )
+	{
+		elapsedNanoseconds = GetCurrentTimeNanoseconds() - startNanoseconds;
+	}
+	uint64_t	elapsedTicks	= __rdtsc() - startTicks;
+	if ( elapsedTicks == 0 )
+	{
+		return calibration;
+	}
+
+	calibration.m_startTicks			= startTicks;
+	calibration.m_nanosecondsPerTick	= double( elapsedNanoseconds ) / double( elapsedTicks );
+	calibration.m_secondsPerTick		= calibration.m_nanosecondsPerTick * 1.0e-9;
+	return calibration;
+}
+
+//-----------------------------------------------------------------------------------------------
+TscCalibration const& GetTscCalibration()
+{
+	static TscCalibration calibration = CalibrateTsc();
+	return calibration;
+}
+
+//-----------------------------------------------------------------------------------------------
+int64_t GetCurrentTimeNanosecondsFast()
+{
+	TscCalibration const& calibration = GetTscCalibration();
+	if ( calibration.m_secondsPerTick == 0.0 )
+	{
+		return GetCurrentTimeNanoseconds();
+	}
+	return int64_t( double( __rdtsc() - calibration.m_startTicks ) * calibration.m_nanosecondsPerTick );
+}
+
+//-----------------------------------------------------------------------------------------------
+double GetSecondsPerTscTick()
+{
+	return GetTscCalibration().m_secondsPerTick;
 }
@@ -3,8 +3,25 @@
 //
 #pragma once
 
+#include <stdint.h>
+
+
+//-----------------------------------------------------------------------------------------------
+// Monotonic time since the first call. Nanoseconds are the exact form, an int64 lasts ~292 years;
+// seconds are a convenience that loses precision as uptime grows, so keep long-lived timestamps in ns
+int64_t GetCurrentTimeNanoseconds();
+double	GetCurrentTimeSeconds();
+
+//-----------------------------------------------------------------------------------------------
+// Reads the CPU's time stamp counter and scales it, much cheaper than the OS call. The rate is
+// calibrated once against GetCurrentTimeNanoseconds, so it drifts slowly from it: use it for short
+// intervals, never mix it with the timestamps above. Falls back to the OS clock when the CPU
+// doesn't have an invariant TSC
+int64_t GetCurrentTimeNanosecondsFast();
+double	GetSecondsPerTscTick();			// 0 if there is no invariant TSC
 
 //-----------------------------------------------------------------------------------------------
-double GetCurrentTimeSeconds();
+constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
 
-	
\ No newline at end of file
+inline double	NanosecondsToSeconds( int64_t nanoseconds )	{ return double( nanoseconds ) * 1.0e-9; }
+inline int64_t	SecondsToNanoseconds( double seconds )		{ return int64_t( seconds * 1.0e9 ); }
@@ -0,0 +1,243 @@
+#include "Engine/Input/InputRecording.hpp"
+#include "Engine/Core/FileUtils.hpp"
+
+#include <string.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+static char const		INPUT_RECORDING_MAGIC[4]		= { 'I', 'N', 'R', 'C' };
+static uint32_t const	INPUT_RECORDING_VERSION			= 1;
+static int const		INPUT_RECORDING_HEADER_SIZE		= 16;		// Magic, version, seed, numFrames
+
+//----------------------------------------------------------------------------------------------------------------------
+// Per-frame flags
+static uint8_t const	FRAME_FLAG_CURSOR_CHANGED		= 1 << 0;
+static uint8_t const	FRAME_FLAG_FIRST_CONTROLLER		= 1 << 1;		// Then one bit per controller index
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static void AppendValue( std::vector<char>& out_bytes, T const& value )
+{
+	size_t offset = out_bytes.size();
+	out_bytes.resize( offset + sizeof( T ) );
+	memcpy( &out_bytes[ offset ], &value, sizeof( T ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static bool ReadValue( std::vector<uint8_t> const& bytes, size_t& inout_offset, T& out_value )
+{
+	if ( inout_offset + sizeof( T ) > bytes.size() )
+	{
+		return false;
+	}
+	memcpy( &out_value, &bytes[ inout_offset ], sizeof( T ) );
+	inout_offset += sizeof( T );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool InputControllerFrame::operator==( InputControllerFrame const& compare ) const
+{
+	return m_isConnected == compare.m_isConnected && m_buttonFlags == compare.m_buttonFlags &&
+		   m_leftStickX  == compare.m_leftStickX  && m_leftStickY  == compare.m_leftStickY  &&
+		   m_rightStickX == compare.m_rightStickX && m_rightStickY == compare.m_rightStickY &&
+		   m_leftTrigger == compare.m_leftTrigger && m_rightTrigger == compare.m_rightTrigger;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputFrame::SetKeyDown( unsigned char keyCode, bool isDown )
+{
+	uint8_t bit = uint8_t( 1 << ( keyCode & 7 ) );
+	if ( isDown )
+	{
+		m_keyDownBits[ keyCode >> 3 ] |= bit;
+	}
+	else
+	{
+		m_keyDownBits[ keyCode >> 3 ] &= ~bit;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// InputRecorder
+//----------------------------------------------------------------------------------------------------------------------
+InputRecorder::InputRecorder( std::string const& filePath, uint32_t seed )
+	: m_filePath( filePath )
+	, m_seed( seed )
+{
+	m_frameBytes.reserve( 64 * 1024 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+InputRecorder::~InputRecorder()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputRecorder::AddFrame( InputFrame const& frame )
+{
+	// Frame 0 is encoded against an all-released, disconnected, zero-cursor frame
+	uint8_t flags = 0;
+	if ( frame.m_cursorClientPosition != m_previousFrame.m_cursorClientPosition || frame.m_cursorClientDelta != m_previousFrame.m_cursorClientDelta )
+	{
+		flags |= FRAME_FLAG_CURSOR_CHANGED;
+	}
+	for ( int i = 0; i < NUM_XBOX_CONTROLLER; i++ )
+	{
+		if ( !( frame.m_controllerList[i] == m_previousFrame.m_controllerList[i] ) )
+		{
+			flags |= uint8_t( FRAME_FLAG_FIRST_CONTROLLER << i );
+		}
+	}
+
+	std::vector<uint8_t> toggledKeyList;
+	for ( int keyCode = 0; keyCode < NUM_KEYCODES; keyCode++ )
+	{
+		if ( frame.IsKeyDown( uint8_t( keyCode ) ) != m_previousFrame.IsKeyDown( uint8_t( keyCode ) ) )
+		{
+			toggledKeyList.push_back( uint8_t( keyCode ) );
+		}
+	}
+
+	AppendValue( m_frameBytes, frame.m_deltaNanoseconds );
+	AppendValue( m_frameBytes, flags );
+	AppendValue( m_frameBytes, uint16_t( toggledKeyList.size() ) );
+	for ( int i = 0; i < toggledKeyList.size(); i++ )
+	{
+		AppendValue( m_frameBytes, toggledKeyList[i] );
+	}
+	if ( flags & FRAME_FLAG_CURSOR_CHANGED )
+	{
+		AppendValue( m_frameBytes, int32_t( frame.m_cursorClientPosition.x ) );
+		AppendValue( m_frameBytes, int32_t( frame.m_cursorClientPosition.y ) );
+		AppendValue( m_frameBytes, int32_t( frame.m_cursorClientDelta.x ) );
+		AppendValue( m_frameBytes, int32_t( frame.m_cursorClientDelta.y ) );
+	}
+	for ( int i = 0; i < NUM_XBOX_CONTROLLER; i++ )
+	{
+		if ( ( flags & ( FRAME_FLAG_FIRST_CONTROLLER << i ) ) == 0 )
+		{
+			continue;
+		}
+		InputControllerFrame const& controller = frame.m_controllerList[i];
+		AppendValue( m_frameBytes, uint8_t( controller.m_isConnected ? 1 : 0 ) );
+		AppendValue( m_frameBytes, controller.m_buttonFlags );
+		AppendValue( m_frameBytes, controller.m_leftStickX );
+		AppendValue( m_frameBytes, controller.m_leftStickY );
+		AppendValue( m_frameBytes, controller.m_rightStickX );
+		AppendValue( m_frameBytes, controller.m_rightStickY );
+		AppendValue( m_frameBytes, controller.m_leftTrigger );
+		AppendValue( m_frameBytes, controller.m_rightTrigger );
+	}
+
+	m_previousFrame = frame;
+	m_numFrames++;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputRecorder::SaveToFile()
+{
+	std::vector<char> fileBytes;
+	fileBytes.reserve( INPUT_RECORDING_HEADER_SIZE + m_frameBytes.size() );
+	fileBytes.insert( fileBytes.end(), INPUT_RECORDING_MAGIC, INPUT_RECORDING_MAGIC + 4 );
+	AppendValue( fileBytes, INPUT_RECORDING_VERSION );
+	AppendValue( fileBytes, m_seed );
+	AppendValue( fileBytes, uint32_t( m_numFrames ) );
+	fileBytes.insert( fileBytes.end(), m_frameBytes.begin(), m_frameBytes.end() );
+	WriteBinaryBufferToFile( fileBytes, m_filePath );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// InputReplayer
+//----------------------------------------------------------------------------------------------------------------------
+InputReplayer::InputReplayer()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+InputReplayer::~InputReplayer()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool InputReplayer::LoadFromFile( std::string const& filePath )
+{
+	m_frameList.clear();
+	m_nextFrameIndex = 0;
+
+	std::vector<uint8_t> bytes;
+	if ( FileReadToBuffer( bytes, filePath ) < INPUT_RECORDING_HEADER_SIZE || memcmp( bytes.data(), INPUT_RECORDING_MAGIC, 4 ) != 0 )
+	{
+		return false;
+	}
+
+	size_t offset		= 4;
+	uint32_t version	= 0;
+	uint32_t numFrames	= 0;
+	ReadValue( bytes, offset, version );
+	ReadValue( bytes, offset, m_seed );
+	ReadValue( bytes, offset, numFrames );
+	if ( version != INPUT_RECORDING_VERSION )
+	{
+		return false;
+	}
+
+	// Each frame starts as a copy of the one before and applies the changes
+	InputFrame frame;
+	m_frameList.reserve( numFrames );
+	for ( uint32_t frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+	{
+		uint8_t flags			= 0;
+		uint16_t numToggledKeys	= 0;
+		if ( !ReadValue( bytes, offset, frame.m_deltaNanoseconds ) || !ReadValue( bytes, offset, flags ) || !ReadValue( bytes, offset, numToggledKeys ) )
+		{
+			m_frameList.clear();
+			return false;
+		}
+		for ( int i = 0; i < numToggledKeys; i++ )
+		{
+			uint8_t keyCode = 0;
+			if ( !ReadValue( bytes, offset, keyCode ) )
+			{
+				m_frameList.clear();
+				return false;
+			}
+			frame.SetKeyDown( keyCode, !frame.IsKeyDown( keyCode ) );
+		}
+		if ( flags & FRAME_FLAG_CURSOR_CHANGED )
+		{
+			int32_t cursorValues[4] = {};
+			for ( int i = 0; i < 4; i++ )
+			{
+				if ( !ReadValue( bytes, offset, cursorValues[i] ) )
+				{
+					m_frameList.clear();
+					return false;
+				}
+			}
+			frame.m_cursorClientPosition	= IntVec2( cursorValues[0], cursorValues[1] );
+			frame.m_cursorClientDelta		= IntVec2( cursorValues[2], cursorValues[3] );
+		}
+		for ( int i = 0; i < NUM_XBOX_CONTROLLER; i++ )
+		{
+			if ( ( flags & ( FRAME_FLAG_FIRST_CONTROLLER << i ) ) == 0 )
+			{
+				continue;
+			}
+			InputControllerFrame& controller	= frame.m_controllerList[i];
+			uint8_t isConnected					= 0;
+			bool didRead = ReadValue( bytes, offset, isConnected )				&& ReadValue( bytes, offset, controller.m_buttonFlags ) &&
+						   ReadValue( bytes, offset, controller.m_leftStickX )	&& ReadValue( bytes, offset, controller.m_leftStickY )  &&
+						   ReadValue( bytes, offset, controller.m_rightStickX ) && ReadValue( bytes, offset, controller.m_rightStickY ) &&
+						   ReadValue( bytes, offset, controller.m_leftTrigger ) && ReadValue( bytes, offset, controller.m_rightTrigger );
+			if ( !didRead )
+			{
+				m_frameList.clear();
+				return false;
+			}
+			controller.m_isConnected = isConnected != 0;
+		}
+		m_frameList.push_back( frame );
+	}
+	return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Raw XInput values, so a replayed controller goes through the same dead zone math as a live one
+struct InputControllerFrame
+{
+	bool		m_isConnected		= false;
+	uint16_t	m_buttonFlags		= 0;		// Bit per XboxButtonID
+	int16_t		m_leftStickX		= 0;
+	int16_t		m_leftStickY		= 0;
+	int16_t		m_rightStickX		= 0;
+	int16_t		m_rightStickY		= 0;
+	uint8_t		m_leftTrigger		= 0;
+	uint8_t		m_rightTrigger		= 0;
+
+	bool operator==( InputControllerFrame const& compare ) const;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Everything the game could read from the InputSystem during one frame, plus how far the system clock advanced
+struct InputFrame
+{
+	uint32_t				m_deltaNanoseconds		= 0;
+	uint8_t					m_keyDownBits[ NUM_KEYCODES / 8 ] = {};
+	IntVec2					m_cursorClientPosition;
+	IntVec2					m_cursorClientDelta;
+	InputControllerFrame	m_controllerList[ NUM_XBOX_CONTROLLER ];
+
+	bool IsKeyDown( unsigned char keyCode ) const		{ return ( m_keyDownBits[ keyCode >> 3 ] & ( 1 << ( keyCode & 7 ) ) ) != 0; }
+	void SetKeyDown( unsigned char keyCode, bool isDown );
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Frames are delta encoded against the previous one as they are added: the clock delta, then only the keys that
+// toggled, the cursor if it moved and the controllers that changed. A minute of typical play is a few tens of KB.
+//----------------------------------------------------------------------------------------------------------------------
+class InputRecorder
+{
+public:
+	InputRecorder( std::string const& filePath, uint32_t seed );
+	~InputRecorder();
+
+	void				AddFrame( InputFrame const& frame );
+	void				SaveToFile();
+	int					GetNumFrames() const		{ return m_numFrames; }
+	std::string const&	GetFilePath() const			{ return m_filePath; }
+
+private:
+	std::string			m_filePath;
+	uint32_t			m_seed			= 0;
+	int					m_numFrames		= 0;
+	InputFrame			m_previousFrame;
+	std::vector<char>	m_frameBytes;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+class InputReplayer
+{
+public:
+	InputReplayer();
+	~InputReplayer();
+
+	bool				LoadFromFile( std::string const& filePath );		// False if missing or malformed
+	bool				IsFinished() const			{ return m_nextFrameIndex >= int( m_frameList.size() ); }
+	InputFrame const&	GetNextFrame()				{ return m_frameList[ m_nextFrameIndex++ ]; }
+	InputFrame const*	PeekNextFrame() const		{ return IsFinished() ? nullptr : &m_frameList[ m_nextFrameIndex ]; }
+	int					GetNumFrames() const		{ return int( m_frameList.size() ); }
+	int					GetNextFrameIndex() const	{ return m_nextFrameIndex; }
+	uint32_t			GetSeed() const				{ return m_seed; }
+
+private:
+	std::vector<InputFrame>	m_frameList;
+	int						m_nextFrameIndex	= 0;
+	uint32_t				m_seed				= 0;
+};
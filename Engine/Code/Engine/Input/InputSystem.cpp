@@ -1,6 +1,8 @@
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Input/XboxController.hpp"
+#include "Engine/Input/InputRecording.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Clock.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
@@ -75,6 +77,20 @@ void InputSystem::StartUp()
 
 //----------------------------------------------------------------------------------------------------------------------
 void InputSystem::BeginFrame()
+{
+	if ( m_replayer )
+	{
+		ApplyNextReplayFrame();
+		return;
+	}
+	if ( m_config.m_pollDevices )
+	{
+		PollDevices();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::PollDevices()
 {
 	// call XboxController::Update();
 	for (int i = 0; i < NUM_XBOX_CONTROLLER; i++)
@@ -163,6 +179,12 @@ void InputSystem::BeginFrame()
 //----------------------------------------------------------------------------------------------------------------------
 void InputSystem::EndFrame()
 {
+	// Before wasPressedLastFrame moves on, so the recording holds exactly what this frame's Update saw
+	if ( m_recorder )
+	{
+		RecordFrame();
+	}
+
 	for (int i = 0; i < NUM_KEYCODES ; i++)
 	{
 		m_keyStates[i].m_wasPressedLastFrame = m_keyStates[i].m_isPressed;
@@ -172,6 +194,8 @@ void InputSystem::EndFrame()
 //----------------------------------------------------------------------------------------------------------------------
 void InputSystem::ShutDown()
 {
+	StopRecording();
+	StopReplay();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -195,12 +219,22 @@ bool InputSystem::IsKeyDown(unsigned char keyCode)
 //----------------------------------------------------------------------------------------------------------------------
 void InputSystem::HandleKeyPressed(unsigned char keyCode)
 {
+	if ( m_replayer )
+	{
+		// The recording owns the keyboard, window keys would make the run diverge
+		return;
+	}
 	m_keyStates[keyCode].m_isPressed = true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void InputSystem::HandleKeyReleased(unsigned char keyCode)
 {
+	if ( m_replayer )
+	{
+		// The recording owns the keyboard, window keys would make the run diverge
+		return;
+	}
 	m_keyStates[keyCode].m_isPressed = false;
 }
 
@@ -260,3 +294,173 @@ Vec2 InputSystem::GetCursorNormalizedPosition() const
 	Vec2 normalizedCursorClientPosition = GetCursorClientPosition();
 	return normalizedCursorClientPosition;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::StartRecording( std::string const& filePath, uint32_t seed )
+{
+	StopRecording();
+	m_recorder = new InputRecorder( filePath, seed );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::StopRecording()
+{
+	if ( m_recorder == nullptr )
+	{
+		return;
+	}
+	m_recorder->SaveToFile();
+	delete m_recorder;
+	m_recorder = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// A fixed step of 0 means real time, so a recorded zero delta still steps by 1ns
+static int64_t GetReplayStepNanoseconds( InputFrame const& frame )
+{
+	return frame.m_deltaNanoseconds > 0 ? int64_t( frame.m_deltaNanoseconds ) : 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool InputSystem::StartReplay( std::string const& filePath )
+{
+	StopReplay();
+	InputReplayer* replayer = new InputReplayer();
+	if ( !replayer->LoadFromFile( filePath ) || replayer->IsFinished() )
+	{
+		delete replayer;
+		return false;
+	}
+	m_replayer = replayer;
+
+	// The system clock ticks before BeginFrame, so the step for each frame is set one frame ahead
+	m_fixedStepBeforeReplay = Clock::GetSystemClockFixedStep();
+	Clock::SetSystemClockFixedStep( GetReplayStepNanoseconds( *m_replayer->PeekNextFrame() ) );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::StopReplay()
+{
+	if ( m_replayer == nullptr )
+	{
+		return;
+	}
+	delete m_replayer;
+	m_replayer = nullptr;
+	Clock::SetSystemClockFixedStep( m_fixedStepBeforeReplay );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int InputSystem::GetNumReplayFrames() const
+{
+	return m_replayer ? m_replayer->GetNumFrames() : 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t InputSystem::GetReplaySeed() const
+{
+	return m_replayer ? m_replayer->GetSeed() : 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static int16_t QuantizeStickAxis( float rawNormalized )
+{
+	float clamped = GetClamped( rawNormalized, -1.0f, 1.0f );
+	return int16_t( RoundDownToInt( clamped * 32767.0f + 0.5f ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static uint8_t QuantizeTrigger( float triggerValue )
+{
+	float clamped = GetClamped( triggerValue, 0.0f, 1.0f );
+	return uint8_t( RoundDownToInt( clamped * 255.0f + 0.5f ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::RecordFrame()
+{
+	InputFrame frame;
+	int64_t deltaNanoseconds	= Clock::GetSystemClock().GetDeltaNanoseconds();
+	frame.m_deltaNanoseconds	= deltaNanoseconds > int64_t( UINT32_MAX ) ? UINT32_MAX : uint32_t( deltaNanoseconds );
+	for ( int keyCode = 0; keyCode < NUM_KEYCODES; keyCode++ )
+	{
+		frame.SetKeyDown( uint8_t( keyCode ), m_keyStates[keyCode].m_isPressed );
+	}
+	frame.m_cursorClientPosition	= m_mouseState.m_cursorClientPosition;
+	frame.m_cursorClientDelta		= m_mouseState.m_cursorClientDelta;
+
+	for ( int i = 0; i < NUM_XBOX_CONTROLLER; i++ )
+	{
+		XboxController const& controller		= m_controllers[i];
+		InputControllerFrame& controllerFrame	= frame.m_controllerList[i];
+		controllerFrame.m_isConnected			= controller.isConnected();
+		if ( !controllerFrame.m_isConnected )
+		{
+			continue;
+		}
+		for ( int buttonID = 0; buttonID < XboxButtonID::NUM; buttonID++ )
+		{
+			if ( controller.IsButtonDown( XboxButtonID( buttonID ) ) )
+			{
+				controllerFrame.m_buttonFlags |= uint16_t( 1 << buttonID );
+			}
+		}
+		Vec2 leftStick					= controller.GetLeftJoyStick().GetRawUncorrectedPosition();
+		Vec2 rightStick					= controller.GetRightJoyStick().GetRawUncorrectedPosition();
+		controllerFrame.m_leftStickX	= QuantizeStickAxis( leftStick.x );
+		controllerFrame.m_leftStickY	= QuantizeStickAxis( leftStick.y );
+		controllerFrame.m_rightStickX	= QuantizeStickAxis( rightStick.x );
+		controllerFrame.m_rightStickY	= QuantizeStickAxis( rightStick.y );
+		controllerFrame.m_leftTrigger	= QuantizeTrigger( controller.GetLeftTrigger() );
+		controllerFrame.m_rightTrigger	= QuantizeTrigger( controller.GetRightTrigger() );
+	}
+
+	m_recorder->AddFrame( frame );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::ApplyNextReplayFrame()
+{
+	InputFrame const& frame = m_replayer->GetNextFrame();
+	for ( int keyCode = 0; keyCode < NUM_KEYCODES; keyCode++ )
+	{
+		m_keyStates[keyCode].m_isPressed = frame.IsKeyDown( uint8_t( keyCode ) );
+	}
+	m_mouseState.m_cursorClientPosition	= frame.m_cursorClientPosition;
+	m_mouseState.m_cursorClientDelta	= frame.m_cursorClientDelta;
+	for ( int i = 0; i < NUM_XBOX_CONTROLLER; i++ )
+	{
+		ApplyControllerFrame( m_controllers[i], frame.m_controllerList[i] );
+	}
+
+	InputFrame const* nextFrame = m_replayer->PeekNextFrame();
+	if ( nextFrame == nullptr )
+	{
+		// Last frame applied, live input and real time take over from the next frame
+		StopReplay();
+		return;
+	}
+	Clock::SetSystemClockFixedStep( GetReplayStepNanoseconds( *nextFrame ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InputSystem::ApplyControllerFrame( XboxController& controller, InputControllerFrame const& controllerFrame )
+{
+	// Mirrors XboxController::Update, with the recorded raw values in place of XInputGetState
+	if ( !controllerFrame.m_isConnected )
+	{
+		controller.m_isConnected = false;
+		controller.Reset();
+		return;
+	}
+	controller.m_isConnected = true;
+	for ( int buttonID = 0; buttonID < XboxButtonID::NUM; buttonID++ )
+	{
+		controller.UpdateButton( XboxButtonID( buttonID ), controllerFrame.m_buttonFlags, uint16_t( 1 << buttonID ) );
+	}
+	controller.UpdateJoystick( controller.m_leftJoyStick,  controllerFrame.m_leftStickX,  controllerFrame.m_leftStickY );
+	controller.UpdateJoystick( controller.m_rightJoyStick, controllerFrame.m_rightStickX, controllerFrame.m_rightStickY );
+	controller.UpdateTrigger( controller.m_leftTrigger,  controllerFrame.m_leftTrigger );
+	controller.UpdateTrigger( controller.m_rightTrigger, controllerFrame.m_rightTrigger );
+}
@@ -4,6 +4,9 @@
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Math/IntVec2.hpp"
 
+#include <stdint.h>
+#include <string>
+
 //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 extern unsigned char const KEYCODE_F1;
 extern unsigned char const KEYCODE_F2;
@@ -46,6 +49,12 @@ constexpr int NUM_KEYCODES			= 256;
 constexpr int NUM_XBOX_CONTROLLER	= 4;
 
 
+//----------------------------------------------------------------------------------------------------------------------
+class	InputRecorder;
+class	InputReplayer;
+struct	InputFrame;
+struct	InputControllerFrame;
+
 //----------------------------------------------------------------------------------------------------------------------
 struct MouseState 
 {
@@ -62,6 +71,7 @@ struct MouseState
 //----------------------------------------------------------------------------------------------------------------------
 struct InputSystemConfig
 {
+	bool	m_pollDevices	= true;		// When false only HandleKeyPressed/Released change state, no controllers or cursor (headless runs)
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -103,6 +113,28 @@ public:
 
 	void GetCurrentLocalPos();
 
+	//----------------------------------------------------------------------------------------------------------------------
+	// Recording and replay
+	//----------------------------------------------------------------------------------------------------------------------
+	// Records everything the game reads each frame, plus the system clock delta. Saved on StopRecording or ShutDown
+	void		StartRecording( std::string const& filePath, uint32_t seed = 0 );
+	void		StopRecording();
+	bool		IsRecording() const					{ return m_recorder != nullptr; }
+
+	// Feeds a recording back in place of the devices and window keys, and steps the system clock by the recorded
+	// deltas. Started before the first frame with the recording's seed, the game follows the recorded path exactly
+	bool		StartReplay( std::string const& filePath );
+	void		StopReplay();
+	bool		IsReplaying() const					{ return m_replayer != nullptr; }
+	int			GetNumReplayFrames() const;
+	uint32_t	GetReplaySeed() const;
+
+protected:
+	void PollDevices();
+	void RecordFrame();
+	void ApplyNextReplayFrame();
+	void ApplyControllerFrame( XboxController& controller, InputControllerFrame const& controllerFrame );
+
 protected:
 	KeyButtonState m_keyStates	 [ 256 ];
 	XboxController m_controllers [ NUM_XBOX_CONTROLLER ];
@@ -110,6 +142,10 @@ protected:
 	InputSystemConfig		m_config;
 	static InputSystem*		s_theInputSystem;
 
+	InputRecorder*			m_recorder					= nullptr;
+	InputReplayer*			m_replayer					= nullptr;
+	int64_t					m_fixedStepBeforeReplay		= 0;		// System clock fixed step to restore when the replay ends
+
 public:
 	MouseState	m_mouseState;
 };
\ No newline at end of file
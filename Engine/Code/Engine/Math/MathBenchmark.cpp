@@ -0,0 +1,544 @@
+#include "Engine/Math/MathBenchmark.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB3D.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+// Results are summed in here so the optimizer can't drop the work
+static volatile float s_mathBenchmarkSink = 0.0f;
+
+//----------------------------------------------------------------------------------------------------------------------
+static int const NUM_BENCHMARK_INPUTS		= 1024;		// Power of two, ops index with & ( NUM_BENCHMARK_INPUTS - 1 )
+static int const BENCHMARK_INPUT_INDEX_MASK	= NUM_BENCHMARK_INPUTS - 1;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct MathBenchmarkInputs
+{
+	std::vector<Mat44>			m_transformList;		// Rotation and translation, what the skeletons carry
+	std::vector<EulerAngles>	m_eulerList;
+	std::vector<Vec3>			m_positionList;
+	std::vector<Vec3>			m_directionList;		// Unit length
+	std::vector<float>			m_degreesList;
+	std::vector<Vec3>			m_rayStartList;
+	std::vector<Vec3>			m_rayFwdList;			// Aimed within a few units of the matching target
+	std::vector<AABB3>			m_aabbList;
+	std::vector<OBB3D>			m_obbList;
+	std::vector<Vec3>			m_sphereCenterList;
+	std::vector<Vec3>			m_boneStartList;
+	std::vector<Vec3>			m_boneEndList;
+	std::vector<Vec3>			m_triangleVertList;		// Three per triangle
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static Vec3 RollRandomPosition( RandomNumberGenerator& rng, float halfExtent )
+{
+	return Vec3( rng.RollRandomFloatInRange( -halfExtent, halfExtent ), rng.RollRandomFloatInRange( -halfExtent, halfExtent ), rng.RollRandomFloatInRange( -halfExtent, halfExtent ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static Vec3 RollRandomDirection( RandomNumberGenerator& rng )
+{
+	Vec3 direction = RollRandomPosition( rng, 1.0f );
+	while ( direction.GetLengthSquared() < 0.01f )
+	{
+		direction = RollRandomPosition( rng, 1.0f );
+	}
+	return direction.GetNormalized();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static EulerAngles RollRandomEuler( RandomNumberGenerator& rng )
+{
+	return EulerAngles( rng.RollRandomFloatInRange( -180.0f, 180.0f ), rng.RollRandomFloatInRange( -89.0f, 89.0f ), rng.RollRandomFloatInRange( -180.0f, 180.0f ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static MathBenchmarkInputs const& GetMathBenchmarkInputs()
+{
+	static MathBenchmarkInputs s_inputs;
+	if ( !s_inputs.m_transformList.empty() )
+	{
+		return s_inputs;
+	}
+
+	RandomNumberGenerator rng( 12345 );
+	for ( int i = 0; i < NUM_BENCHMARK_INPUTS; i++ )
+	{
+		EulerAngles euler	= RollRandomEuler( rng );
+		Mat44 transform		= euler.GetAsMatrix_XFwd_YLeft_ZUp();
+		transform.SetTranslation3D( RollRandomPosition( rng, 50.0f ) );
+		s_inputs.m_transformList.push_back( transform );
+		s_inputs.m_eulerList.push_back( RollRandomEuler( rng ) );
+		s_inputs.m_positionList.push_back( RollRandomPosition( rng, 50.0f ) );
+		s_inputs.m_directionList.push_back( RollRandomDirection( rng ) );
+		s_inputs.m_degreesList.push_back( rng.RollRandomFloatInRange( -90.0f, 90.0f ) );
+
+		// Target around a point, ray aimed at that point plus some miss, so hits and misses are both common
+		Vec3 targetCenter	= RollRandomPosition( rng, 20.0f );
+		Vec3 rayStart		= targetCenter + ( RollRandomDirection( rng ) * 15.0f );
+		Vec3 aimPos			= targetCenter + RollRandomPosition( rng, 3.0f );
+		s_inputs.m_rayStartList.push_back( rayStart );
+		s_inputs.m_rayFwdList.push_back( ( aimPos - rayStart ).GetNormalized() );
+
+		Vec3 halfDimensions = Vec3( rng.RollRandomFloatInRange( 0.5f, 2.0f ), rng.RollRandomFloatInRange( 0.5f, 2.0f ), rng.RollRandomFloatInRange( 0.5f, 2.0f ) );
+		s_inputs.m_aabbList.push_back( AABB3( targetCenter - halfDimensions, targetCenter + halfDimensions ) );
+		s_inputs.m_obbList.push_back( OBB3D( targetCenter, transform.GetIBasis3D(), transform.GetJBasis3D(), transform.GetKBasis3D(), halfDimensions ) );
+		s_inputs.m_sphereCenterList.push_back( targetCenter );
+
+		Vec3 boneDir = RollRandomDirection( rng );
+		s_inputs.m_boneStartList.push_back( targetCenter - ( boneDir * 2.0f ) );
+		s_inputs.m_boneEndList.push_back(   targetCenter + ( boneDir * 2.0f ) );
+
+		s_inputs.m_triangleVertList.push_back( targetCenter + RollRandomPosition( rng, 3.0f ) );
+		s_inputs.m_triangleVertList.push_back( targetCenter + RollRandomPosition( rng, 3.0f ) );
+		s_inputs.m_triangleVertList.push_back( targetCenter + RollRandomPosition( rng, 3.0f ) );
+	}
+	return s_inputs;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Every output of an op goes into the returned sum. Keeping only one entry would let an optimizer that inlines across
+// files (LTCG in Release) drop the work behind the others and report a cheaper op than the game pays for
+//----------------------------------------------------------------------------------------------------------------------
+static float SumOfComponents( Vec3 const& vector )
+{
+	return vector.x + vector.y + vector.z;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float SumOfValues( Mat44 const& matrix )
+{
+	float sum = 0.0f;
+	for ( int i = 0; i < 16; i++ )
+	{
+		sum += matrix.m_values[i];
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float SumOfResult( RaycastResult3D const& result )
+{
+	if ( !result.m_didImpact )
+	{
+		return 0.0f;
+	}
+	return result.m_impactDist + SumOfComponents( result.m_impactPos ) + SumOfComponents( result.m_impactNormal );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Benchmarks, each runs numOps ops and returns a value depending on all of them
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_Mat44Append( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		Mat44 matrix = inputs.m_transformList[ i & BENCHMARK_INPUT_INDEX_MASK ];
+		matrix.Append( inputs.m_transformList[ ( i + 1 ) & BENCHMARK_INPUT_INDEX_MASK ] );
+		sum += SumOfValues( matrix );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_Mat44TransformPosition3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		Vec3 position = inputs.m_transformList[ i & BENCHMARK_INPUT_INDEX_MASK ].TransformPosition3D( inputs.m_positionList[ ( i + 7 ) & BENCHMARK_INPUT_INDEX_MASK ] );
+		sum += SumOfComponents( position );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_Mat44GetOrthoNormalInverse( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		Mat44 inverse = inputs.m_transformList[ i & BENCHMARK_INPUT_INDEX_MASK ].GetOrthoNormalInverse();
+		sum += SumOfValues( inverse );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_EulerGetAsMatrix( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		Mat44 matrix = inputs.m_eulerList[ i & BENCHMARK_INPUT_INDEX_MASK ].GetAsMatrix_XFwd_YLeft_ZUp();
+		sum += SumOfValues( matrix );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RotateVectorAboutArbitraryAxis( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index		= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		Vec3 rotated	= RotateVectorAboutArbitraryAxis( inputs.m_positionList[ index ], inputs.m_directionList[ index ], inputs.m_degreesList[ index ] );
+		sum += SumOfComponents( rotated );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_GetAngleDegreesBetweenVectors3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		sum += GetAngleDegreesBetweenVectors3D( inputs.m_positionList[ i & BENCHMARK_INPUT_INDEX_MASK ], inputs.m_directionList[ ( i + 3 ) & BENCHMARK_INPUT_INDEX_MASK ] );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsAABB3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		RaycastResult3D result	= RaycastVsAABB3D( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, inputs.m_aabbList[ index ] );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsOBB3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		RaycastResult3D result	= RaycastVsOBB3D( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, inputs.m_obbList[ index ] );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsSphere3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		RaycastResult3D result	= RaycastVsSphere3D( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, inputs.m_sphereCenterList[ index ], 2.0f );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsCapsule3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		RaycastResult3D result	= RaycastVsCapsule3D( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, inputs.m_boneStartList[ index ], inputs.m_boneEndList[ index ], 1.0f );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsCylinder3D( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		Vec3 const& center		= inputs.m_sphereCenterList[ index ];
+		RaycastResult3D result	= RaycastVsCylinder3D( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, Vec2( center.x, center.y ), center.z - 2.0f, center.z + 2.0f, 1.5f );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static float Benchmark_RaycastVsTriangle( MathBenchmarkInputs const& inputs, int64_t numOps )
+{
+	float sum = 0.0f;
+	for ( int64_t i = 0; i < numOps; i++ )
+	{
+		int index				= int( i & BENCHMARK_INPUT_INDEX_MASK );
+		float t					= 0.0f;
+		float u					= 0.0f;
+		float v					= 0.0f;
+		Vec3 const* triangle	= &inputs.m_triangleVertList[ index * 3 ];
+		RaycastResult3D result	= RaycastVsTriangle( inputs.m_rayStartList[ index ], inputs.m_rayFwdList[ index ], 30.0f, triangle[0], triangle[1], triangle[2], t, u, v );
+		sum += SumOfResult( result );
+	}
+	return sum;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+typedef float ( *MathBenchmarkFunction )( MathBenchmarkInputs const& inputs, int64_t numOps );
+
+//----------------------------------------------------------------------------------------------------------------------
+struct MathBenchmark
+{
+	char const*				m_name;
+	MathBenchmarkFunction	m_function;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static MathBenchmark const s_mathBenchmarkList[] =
+{
+	{ "Mat44::Append",						Benchmark_Mat44Append						},
+	{ "Mat44::TransformPosition3D",			Benchmark_Mat44TransformPosition3D			},
+	{ "Mat44::GetOrthoNormalInverse",		Benchmark_Mat44GetOrthoNormalInverse		},
+	{ "EulerAngles::GetAsMatrix",			Benchmark_EulerGetAsMatrix					},
+	{ "RotateVectorAboutArbitraryAxis",		Benchmark_RotateVectorAboutArbitraryAxis	},
+	{ "GetAngleDegreesBetweenVectors3D",	Benchmark_GetAngleDegreesBetweenVectors3D	},
+	{ "RaycastVsAABB3D",					Benchmark_RaycastVsAABB3D					},
+	{ "RaycastVsOBB3D",						Benchmark_RaycastVsOBB3D					},
+	{ "RaycastVsSphere3D",					Benchmark_RaycastVsSphere3D					},
+	{ "RaycastVsCapsule3D",					Benchmark_RaycastVsCapsule3D				},
+	{ "RaycastVsCylinder3D",				Benchmark_RaycastVsCylinder3D				},
+	{ "RaycastVsTriangle",					Benchmark_RaycastVsTriangle					},
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Per-thread hardware counters. Windows exposes thread cycles but not instruction counts to user mode; Linux gets
+// both from perf_event_open when the kernel allows it (perf_event_paranoid), otherwise neither
+//----------------------------------------------------------------------------------------------------------------------
+class ThreadPerfCounters
+{
+public:
+	ThreadPerfCounters();
+	~ThreadPerfCounters();
+
+	bool		HasCycles()			const { return m_hasCycles; }
+	bool		HasInstructions()	const { return m_hasInstructions; }
+	void		Read( uint64_t& out_cycles, uint64_t& out_instructions ) const;
+
+private:
+	bool		m_hasCycles			= false;
+	bool		m_hasInstructions	= false;
+#if !defined( _WIN32 )
+	int			m_cyclesFD			= -1;
+	int			m_instructionsFD	= -1;
+#endif
+};
+
+#if defined( _WIN32 )
+//----------------------------------------------------------------------------------------------------------------------
+ThreadPerfCounters::ThreadPerfCounters()
+{
+	m_hasCycles = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ThreadPerfCounters::~ThreadPerfCounters()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ThreadPerfCounters::Read( uint64_t& out_cycles, uint64_t& out_instructions ) const
+{
+	ULONG64 cycles = 0;
+	QueryThreadCycleTime( GetCurrentThread(), &cycles );
+	out_cycles			= cycles;
+	out_instructions	= 0;
+}
+
+#else
+//----------------------------------------------------------------------------------------------------------------------
+static int OpenThreadPerfCounter( uint64_t config )
+{
+	perf_event_attr attributes	= {};
+	attributes.type				= PERF_TYPE_HARDWARE;
+	attributes.size				= sizeof( attributes );
+	attributes.config			= config;
+	attributes.exclude_kernel	= 1;
+	attributes.exclude_hv		= 1;
+	return int( syscall( SYS_perf_event_open, &attributes, 0, -1, -1, 0 ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ThreadPerfCounters::ThreadPerfCounters()
+{
+	m_cyclesFD			= OpenThreadPerfCounter( PERF_COUNT_HW_CPU_CYCLES );
+	m_instructionsFD	= OpenThreadPerfCounter( PERF_COUNT_HW_INSTRUCTIONS );
+	m_hasCycles			= m_cyclesFD >= 0;
+	m_hasInstructions	= m_instructionsFD >= 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ThreadPerfCounters::~ThreadPerfCounters()
+{
+	if ( m_cyclesFD >= 0 )
+	{
+		close( m_cyclesFD );
+	}
+	if ( m_instructionsFD >= 0 )
+	{
+		close( m_instructionsFD );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ThreadPerfCounters::Read( uint64_t& out_cycles, uint64_t& out_instructions ) const
+{
+	out_cycles			= 0;
+	out_instructions	= 0;
+	if ( m_hasCycles && read( m_cyclesFD, &out_cycles, sizeof( out_cycles ) ) != sizeof( out_cycles ) )
+	{
+		out_cycles = 0;
+	}
+	if ( m_hasInstructions && read( m_instructionsFD, &out_instructions, sizeof( out_instructions ) ) != sizeof( out_instructions ) )
+	{
+		out_instructions = 0;
+	}
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+static double GetMedian( std::vector<double>& valueList )
+{
+	std::sort( valueList.begin(), valueList.end() );
+	return valueList[ valueList.size() / 2 ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static MathBenchmarkResult RunMathBenchmark( MathBenchmark const& benchmark, MathBenchmarkConfig const& config, ThreadPerfCounters const& perfCounters )
+{
+	MathBenchmarkInputs const& inputs = GetMathBenchmarkInputs();
+
+	// Calibrate, this also warms the caches and branch predictors
+	int64_t numOps				= 64;
+	int64_t minRepetitionNs		= int64_t( config.m_minRepetitionMs * 1'000'000.0 );
+	for ( ;; )
+	{
+		int64_t startTime	= GetCurrentTimeNanoseconds();
+		s_mathBenchmarkSink	= s_mathBenchmarkSink + benchmark.m_function( inputs, numOps );
+		int64_t elapsedNs	= GetCurrentTimeNanoseconds() - startTime;
+		if ( elapsedNs >= minRepetitionNs || numOps >= ( int64_t( 1 ) << 34 ) )
+		{
+			break;
+		}
+		numOps *= 2;
+	}
+
+	std::vector<double> nsPerOpList;
+	std::vector<double> cyclesPerOpList;
+	std::vector<double> instructionsPerOpList;
+	int numRepetitions = std::max( 1, config.m_numRepetitions );
+	for ( int i = 0; i < numRepetitions; i++ )
+	{
+		uint64_t startCycles		= 0;
+		uint64_t startInstructions	= 0;
+		perfCounters.Read( startCycles, startInstructions );
+		int64_t startTime			= GetCurrentTimeNanoseconds();
+
+		s_mathBenchmarkSink			= s_mathBenchmarkSink + benchmark.m_function( inputs, numOps );
+
+		int64_t elapsedNs			= GetCurrentTimeNanoseconds() - startTime;
+		uint64_t endCycles			= 0;
+		uint64_t endInstructions	= 0;
+		perfCounters.Read( endCycles, endInstructions );
+
+		nsPerOpList.push_back(			 double( elapsedNs )						 / double( numOps ) );
+		cyclesPerOpList.push_back(		 double( endCycles - startCycles )			 / double( numOps ) );
+		instructionsPerOpList.push_back( double( endInstructions - startInstructions ) / double( numOps ) );
+	}
+
+	MathBenchmarkResult result;
+	result.m_name					= benchmark.m_name;
+	result.m_numOpsPerRepetition	= numOps;
+	result.m_nsPerOp				= GetMedian( nsPerOpList );
+	result.m_cyclesPerOp			= perfCounters.HasCycles()		 ? GetMedian( cyclesPerOpList )		  : -1.0;
+	result.m_instructionsPerOp		= perfCounters.HasInstructions() ? GetMedian( instructionsPerOpList ) : -1.0;
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RunMathBenchmarks( MathBenchmarkConfig const& config, std::vector<MathBenchmarkResult>& out_resultList )
+{
+	ThreadPerfCounters perfCounters;
+	for ( int i = 0; i < int( sizeof( s_mathBenchmarkList ) / sizeof( s_mathBenchmarkList[0] ) ); i++ )
+	{
+		MathBenchmark const& benchmark = s_mathBenchmarkList[i];
+		if ( !config.m_filter.empty() && std::string( benchmark.m_name ).find( config.m_filter ) == std::string::npos )
+		{
+			continue;
+		}
+		out_resultList.push_back( RunMathBenchmark( benchmark, config, perfCounters ) );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string GetMathBenchmarkResultsAsCSV( std::vector<MathBenchmarkResult> const& resultList )
+{
+	std::string text = "name,opsPerRepetition,nsPerOp,cyclesPerOp,instructionsPerOp\n";
+	for ( int i = 0; i < resultList.size(); i++ )
+	{
+		MathBenchmarkResult const& result = resultList[i];
+		text += Stringf( "%s,%lld,%.3f,%.2f,%.2f\n", result.m_name.c_str(), (long long)result.m_numOpsPerRepetition, result.m_nsPerOp, result.m_cyclesPerOp, result.m_instructionsPerOp );
+	}
+	return text;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_MathBenchmark( NamedStrings& args )
+{
+	MathBenchmarkConfig config;
+	config.m_filter				= args.GetValue( "filter", config.m_filter );
+	config.m_minRepetitionMs	= double( args.GetValue( "ms", float( config.m_minRepetitionMs ) ) );
+	config.m_numRepetitions		= args.GetValue( "reps", config.m_numRepetitions );
+	std::string filePath		= args.GetValue( "file", "" );
+
+	std::vector<MathBenchmarkResult> resultList;
+	RunMathBenchmarks( config, resultList );
+
+	g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Math benchmark: median of %d reps, %.0f ms each", config.m_numRepetitions, config.m_minRepetitionMs ) );
+	for ( int i = 0; i < resultList.size(); i++ )
+	{
+		MathBenchmarkResult const& result	= resultList[i];
+		std::string cyclesText				= result.m_cyclesPerOp		 < 0.0 ? "-" : Stringf( "%.1f", result.m_cyclesPerOp );
+		std::string instructionsText		= result.m_instructionsPerOp < 0.0 ? "-" : Stringf( "%.1f", result.m_instructionsPerOp );
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "  %-32s %8.2f ns/op  %7s cycles/op  %7s instr/op", result.m_name.c_str(), result.m_nsPerOp, cyclesText.c_str(), instructionsText.c_str() ) );
+	}
+
+	if ( !filePath.empty() )
+	{
+		std::string text = GetMathBenchmarkResultsAsCSV( resultList );
+		std::vector<char> buffer( text.begin(), text.end() );
+		WriteBinaryBufferToFile( buffer, filePath );
+		g_theDevConsole->AddLine( Rgba8::GREEN, Stringf( "Math benchmark results written to %s", filePath.c_str() ) );
+	}
+	return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct MathBenchmarkConfig
+{
+	std::string		m_filter;							// Only benchmarks whose name contains this, empty runs all of them
+	double			m_minRepetitionMs		= 20.0;		// The op count is doubled until one repetition takes this long
+	int				m_numRepetitions		= 5;		// Results are the median over these
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct MathBenchmarkResult
+{
+	std::string		m_name;
+	int64_t			m_numOpsPerRepetition	= 0;
+	double			m_nsPerOp				= 0.0;
+	double			m_cyclesPerOp			= -1.0;		// Thread cycles, -1 when the OS doesn't expose them
+	double			m_instructionsPerOp		= -1.0;		// Retired user-mode instructions, -1 without perf counters
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Microbenchmarks for the Mat44, EulerAngles and MathUtils calls that dominate the IK and scene query profiles.
+// Every op reads its inputs from a fixed-seed table of 1024 realistic cases (orthonormal transforms, unit rays aimed
+// near their targets so about half of them hit), so results are comparable between builds.
+//----------------------------------------------------------------------------------------------------------------------
+void		RunMathBenchmarks( MathBenchmarkConfig const& config, std::vector<MathBenchmarkResult>& out_resultList );
+std::string	GetMathBenchmarkResultsAsCSV( std::vector<MathBenchmarkResult> const& resultList );
+
+//----------------------------------------------------------------------------------------------------------------------
+// "mathbenchmark" runs them all and prints ns/op; "filter=Raycast" runs a subset, "file=MathBenchmark.csv" also
+// writes the results, "ms=" and "reps=" change the repetition length and count
+bool Command_MathBenchmark( NamedStrings& args );
@@ -495,6 +495,108 @@ Vec2 const GetNearestPointOnOBB2D( Vec2 const& refPoint, OBB2D const& orientedBo
 	return clampedNearestPoint;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+Vec2 const GetNearestPointOnTriangle2D( Vec2 const& refPoint, Vec2 const& vert0, Vec2 const& vert1, Vec2 const& vert2 )
+{
+	// If refPoint is on the same side of all three edges, it is inside (works for either winding)
+	float cross01 = CrossProduct2D( vert1 - vert0, refPoint - vert0 );
+	float cross12 = CrossProduct2D( vert2 - vert1, refPoint - vert1 );
+	float cross20 = CrossProduct2D( vert0 - vert2, refPoint - vert2 );
+	bool isInsideCCW = ( cross01 >= 0.0f ) && ( cross12 >= 0.0f ) && ( cross20 >= 0.0f );
+	bool isInsideCW	 = ( cross01 <= 0.0f ) && ( cross12 <= 0.0f ) && ( cross20 <= 0.0f );
+	if ( isInsideCCW || isInsideCW )
+	{
+		return refPoint;
+	}
+
+	// Otherwise the nearest point lies on the closest edge
+	Vec2 nearestPoint01	= GetNearestPointOnLineSegment2D( refPoint, vert0, vert1 );
+	Vec2 nearestPoint12	= GetNearestPointOnLineSegment2D( refPoint, vert1, vert2 );
+	Vec2 nearestPoint20	= GetNearestPointOnLineSegment2D( refPoint, vert2, vert0 );
+	float distSq01		= GetDistanceSquared2D( refPoint, nearestPoint01 );
+	float distSq12		= GetDistanceSquared2D( refPoint, nearestPoint12 );
+	float distSq20		= GetDistanceSquared2D( refPoint, nearestPoint20 );
+	if ( distSq01 <= distSq12 && distSq01 <= distSq20 )
+	{
+		return nearestPoint01;
+	}
+	if ( distSq12 <= distSq20 )
+	{
+		return nearestPoint12;
+	}
+	return nearestPoint20;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Vec3 const GetNearestPointOnLineSegment3D( Vec3 const& refPoint, Vec3 const& startPos, Vec3 const& endPos )
+{
+	Vec3  dispStartToEnd	= endPos - startPos;
+	float lengthSquared		= dispStartToEnd.GetLengthSquared();
+	if ( lengthSquared == 0.0f )
+	{
+		return startPos;
+	}
+	// Fraction along the segment, clamped to its Voronoi regions
+	float fraction = DotProduct3D( refPoint - startPos, dispStartToEnd ) / lengthSquared;
+	fraction	   = GetClamped( fraction, 0.0f, 1.0f );
+	return startPos + ( dispStartToEnd * fraction );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Vec3 const GetNearestPointOnTriangle3D( Vec3 const& refPoint, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 )
+{
+	// Walk the Voronoi regions of the triangle (verts, then edges, then face)
+	Vec3  v0v1		= vert1 - vert0;
+	Vec3  v0v2		= vert2 - vert0;
+	Vec3  v0ToRef	= refPoint - vert0;
+	float d1		= DotProduct3D( v0v1, v0ToRef );
+	float d2		= DotProduct3D( v0v2, v0ToRef );
+	if ( d1 <= 0.0f && d2 <= 0.0f )
+	{
+		return vert0;
+	}
+
+	Vec3  v1ToRef	= refPoint - vert1;
+	float d3		= DotProduct3D( v0v1, v1ToRef );
+	float d4		= DotProduct3D( v0v2, v1ToRef );
+	if ( d3 >= 0.0f && d4 <= d3 )
+	{
+		return vert1;
+	}
+
+	float vc = ( d1 * d4 ) - ( d3 * d2 );
+	if ( vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f )
+	{
+		return vert0 + ( v0v1 * ( d1 / ( d1 - d3 ) ) );
+	}
+
+	Vec3  v2ToRef	= refPoint - vert2;
+	float d5		= DotProduct3D( v0v1, v2ToRef );
+	float d6		= DotProduct3D( v0v2, v2ToRef );
+	if ( d6 >= 0.0f && d5 <= d6 )
+	{
+		return vert2;
+	}
+
+	float vb = ( d5 * d2 ) - ( d1 * d6 );
+	if ( vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f )
+	{
+		return vert0 + ( v0v2 * ( d2 / ( d2 - d6 ) ) );
+	}
+
+	float va = ( d3 * d6 ) - ( d5 * d4 );
+	if ( va <= 0.0f && ( d4 - d3 ) >= 0.0f && ( d5 - d6 ) >= 0.0f )
+	{
+		return vert1 + ( ( vert2 - vert1 ) * ( ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ) ) );
+	}
+
+	// Inside the face
+	float denominator	= 1.0f / ( va + vb + vc );
+	float weightV1		= vb * denominator;
+	float weightV2		= vc * denominator;
+	return vert0 + ( v0v1 * weightV1 ) + ( v0v2 * weightV2 );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool PushDiscOutOfFixedDisc2D(Vec2& mobileDiscCenter, float mobileDiscRadius, Vec2 const& fixedDiscCenter, float fixedDiscRadius)
 {
@@ -1545,6 +1647,113 @@ RaycastResult3D RaycastVsOBB3D( Vec3 rayStartPos, Vec3 rayFwdNormal, float rayMa
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsSphere3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxLength, Vec3 const& sphereCenter, float sphereRadius )
+{
+	RaycastResult3D rayResult;
+	rayResult.m_rayStartPosition	= rayStartPos;
+	rayResult.m_rayFwdNormal		= rayFwdNormal;
+	rayResult.m_rayMaxLength		= rayMaxLength;
+
+	// Check if rayStart is already inside the sphere
+	Vec3  dispStartToCenter		= sphereCenter - rayStartPos;
+	float radiusSquared			= sphereRadius * sphereRadius;
+	if ( dispStartToCenter.GetLengthSquared() < radiusSquared )
+	{
+		rayResult.m_didImpact		= true;
+		rayResult.m_impactDist		= 0.0f;
+		rayResult.m_impactPos		= rayStartPos;
+		rayResult.m_impactNormal	= -1.0f * rayFwdNormal;
+		return rayResult;
+	}
+
+	// Closest approach of the ray to the sphere center
+	float projectedDist			= DotProduct3D( dispStartToCenter, rayFwdNormal );
+	float distSquaredToRay		= dispStartToCenter.GetLengthSquared() - ( projectedDist * projectedDist );
+	if ( projectedDist < 0.0f || distSquaredToRay > radiusSquared )
+	{
+		return rayResult;
+	}
+
+	// Step back from the closest approach by half the chord length
+	float halfChordLength		= sqrtf( radiusSquared - distSquaredToRay );
+	float impactDist			= projectedDist - halfChordLength;
+	if ( impactDist > rayMaxLength )
+	{
+		return rayResult;
+	}
+	rayResult.m_didImpact		= true;
+	rayResult.m_impactDist		= impactDist;
+	rayResult.m_impactPos		= rayStartPos + ( rayFwdNormal * impactDist );
+	rayResult.m_impactNormal	= ( rayResult.m_impactPos - sphereCenter ).GetNormalized();
+	return rayResult;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsCapsule3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxLength, Vec3 const& boneStart, Vec3 const& boneEnd, float radius )
+{
+	RaycastResult3D rayResult;
+	rayResult.m_rayStartPosition	= rayStartPos;
+	rayResult.m_rayFwdNormal		= rayFwdNormal;
+	rayResult.m_rayMaxLength		= rayMaxLength;
+
+	// Check if rayStart is already inside the capsule
+	if ( IsPointInsideCapsule3D( rayStartPos, boneStart, boneEnd, radius ) )
+	{
+		rayResult.m_didImpact		= true;
+		rayResult.m_impactDist		= 0.0f;
+		rayResult.m_impactPos		= rayStartPos;
+		rayResult.m_impactNormal	= -1.0f * rayFwdNormal;
+		return rayResult;
+	}
+
+	Vec3  boneDisp		= boneEnd - boneStart;
+	float boneLength	= boneDisp.GetLength();
+	if ( boneLength > 0.0f )
+	{
+		// Cylinder body; drop the bone-axis component of the ray and solve against a circle
+		Vec3  boneDir		= boneDisp / boneLength;
+		Vec3  dispBoneToRay	= rayStartPos - boneStart;
+		Vec3  fwdPerp		= rayFwdNormal  - ( boneDir * DotProduct3D( rayFwdNormal,  boneDir ) );
+		Vec3  startPerp		= dispBoneToRay - ( boneDir * DotProduct3D( dispBoneToRay, boneDir ) );
+		float a				= DotProduct3D( fwdPerp, fwdPerp );
+		float b				= 2.0f * DotProduct3D( startPerp, fwdPerp );
+		float c				= DotProduct3D( startPerp, startPerp ) - ( radius * radius );
+		float discriminant	= ( b * b ) - ( 4.0f * a * c );
+		if ( a > 0.0f && discriminant >= 0.0f )
+		{
+			float impactDist = ( -b - sqrtf( discriminant ) ) / ( 2.0f * a );
+			if ( impactDist >= 0.0f && impactDist <= rayMaxLength )
+			{
+				Vec3  impactPos		= rayStartPos + ( rayFwdNormal * impactDist );
+				float distAlongBone	= DotProduct3D( impactPos - boneStart, boneDir );
+				if ( distAlongBone >= 0.0f && distAlongBone <= boneLength )
+				{
+					rayResult.m_didImpact		= true;
+					rayResult.m_impactDist		= impactDist;
+					rayResult.m_impactPos		= impactPos;
+					rayResult.m_impactNormal	= ( impactPos - ( boneStart + ( boneDir * distAlongBone ) ) ).GetNormalized();
+				}
+			}
+		}
+	}
+
+	// Hemisphere caps
+	RaycastResult3D startCapResult = RaycastVsSphere3D( rayStartPos, rayFwdNormal, rayMaxLength, boneStart, radius );
+	if ( startCapResult.m_didImpact && startCapResult.m_impactDist < rayResult.m_impactDist )
+	{
+		rayResult = startCapResult;
+	}
+	RaycastResult3D endCapResult = RaycastVsSphere3D( rayStartPos, rayFwdNormal, rayMaxLength, boneEnd, radius );
+	if ( endCapResult.m_didImpact && endCapResult.m_impactDist < rayResult.m_impactDist )
+	{
+		rayResult = endCapResult;
+	}
+	return rayResult;
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------
 RaycastResult3D RaycastVsTriangle( Vec3 const& rayStart, Vec3 const& rayFwdDir, float rayLength, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2, float& t, float& u, float& v )
 {
@@ -1625,6 +1834,295 @@ bool DoesRaycastHitTriangle( Vec3 const& rayStart, Vec3 const& rayFwdDir, Vec3 c
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------
+// Sweeps move a shape from its start along sweepFwdNormal by up to sweepMaxDist; m_impactPos is the sphere center
+// (or bone start) at first contact and m_impactNormal points from the obstacle toward the shape.
+// Shapes that start overlapping report an impact at distance 0 with the normal pushing them out.
+//----------------------------------------------------------------------------------------------------------------------
+// For a point inside the box: out through the nearest face
+static Vec3 GetPushOutNormalFromInsideAABB3D( Vec3 const& point, AABB3 const& aabb3 )
+{
+	float pointList[3]	= { point.x, point.y, point.z };
+	float minsList[3]	= { aabb3.m_mins.x, aabb3.m_mins.y, aabb3.m_mins.z };
+	float maxsList[3]	= { aabb3.m_maxs.x, aabb3.m_maxs.y, aabb3.m_maxs.z };
+	float normalList[3]	= { 0.0f, 0.0f, 0.0f };
+	float bestDepth		= pointList[0] - minsList[0];
+	int	  bestAxis		= 0;
+	float bestSign		= -1.0f;
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		float depthToMin = pointList[ axis ] - minsList[ axis ];
+		float depthToMax = maxsList[ axis ] - pointList[ axis ];
+		if ( depthToMin < bestDepth )
+		{
+			bestDepth	= depthToMin;
+			bestAxis	= axis;
+			bestSign	= -1.0f;
+		}
+		if ( depthToMax < bestDepth )
+		{
+			bestDepth	= depthToMax;
+			bestAxis	= axis;
+			bestSign	= 1.0f;
+		}
+	}
+	normalList[ bestAxis ] = bestSign;
+	return Vec3( normalList[0], normalList[1], normalList[2] );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsAABB3D( Vec3 const& sphereStart, float sphereRadius, Vec3 const& sweepFwdNormal, float sweepMaxDist, AABB3 const& aabb3 )
+{
+	RaycastResult3D sweepResult;
+	sweepResult.m_rayStartPosition	= sphereStart;
+	sweepResult.m_rayFwdNormal		= sweepFwdNormal;
+	sweepResult.m_rayMaxLength		= sweepMaxDist;
+
+	// Check if the sphere already overlaps the box
+	Vec3 nearestPoint	= aabb3.GetNearestPoint( sphereStart );
+	Vec3 dispToSphere	= sphereStart - nearestPoint;
+	if ( dispToSphere.GetLengthSquared() < ( sphereRadius * sphereRadius ) )
+	{
+		sweepResult.m_didImpact		= true;
+		sweepResult.m_impactDist	= 0.0f;
+		sweepResult.m_impactPos		= sphereStart;
+		sweepResult.m_impactNormal	= ( dispToSphere.GetLengthSquared() > 0.0f ) ? dispToSphere.GetNormalized() : GetPushOutNormalFromInsideAABB3D( sphereStart, aabb3 );
+		return sweepResult;
+	}
+
+	// Slab test against the box grown by the radius
+	float startList[3]	= { sphereStart.x,		sphereStart.y,		sphereStart.z		};
+	float fwdList[3]	= { sweepFwdNormal.x,	sweepFwdNormal.y,	sweepFwdNormal.z	};
+	float minsList[3]	= { aabb3.m_mins.x,		aabb3.m_mins.y,		aabb3.m_mins.z		};
+	float maxsList[3]	= { aabb3.m_maxs.x,		aabb3.m_maxs.y,		aabb3.m_maxs.z		};
+	float tEnter		= 0.0f;
+	float tExit			= sweepMaxDist;
+	int	  enterAxis		= -1;
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		float slabMin = minsList[ axis ] - sphereRadius;
+		float slabMax = maxsList[ axis ] + sphereRadius;
+		if ( fwdList[ axis ] == 0.0f )
+		{
+			if ( ( startList[ axis ] < slabMin ) || ( startList[ axis ] > slabMax ) )
+			{
+				return sweepResult;
+			}
+			continue;
+		}
+		float t0 = ( slabMin - startList[ axis ] ) / fwdList[ axis ];
+		float t1 = ( slabMax - startList[ axis ] ) / fwdList[ axis ];
+		if ( t0 > t1 )
+		{
+			float temp = t0;
+			t0 = t1;
+			t1 = temp;
+		}
+		if ( t0 > tEnter )
+		{
+			tEnter		= t0;
+			enterAxis	= axis;
+		}
+		if ( t1 < tExit )
+		{
+			tExit		= t1;
+		}
+		if ( tEnter > tExit )
+		{
+			return sweepResult;
+		}
+	}
+
+	// Entered through a face if the entry point is within the original box on the other two axes
+	Vec3  entryPos			= sphereStart + ( sweepFwdNormal * tEnter );
+	float entryList[3]		= { entryPos.x, entryPos.y, entryPos.z };
+	int	  numOutsideAxes	= 0;
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		if ( ( axis != enterAxis ) && ( ( entryList[ axis ] < minsList[ axis ] ) || ( entryList[ axis ] > maxsList[ axis ] ) ) )
+		{
+			numOutsideAxes++;
+		}
+	}
+	if ( ( enterAxis >= 0 ) && ( numOutsideAxes == 0 ) )
+	{
+		float normalList[3]			= { 0.0f, 0.0f, 0.0f };
+		normalList[ enterAxis ]		= ( fwdList[ enterAxis ] > 0.0f ) ? -1.0f : 1.0f;
+		sweepResult.m_didImpact		= true;
+		sweepResult.m_impactDist	= tEnter;
+		sweepResult.m_impactPos		= entryPos;
+		sweepResult.m_impactNormal	= Vec3( normalList[0], normalList[1], normalList[2] );
+		return sweepResult;
+	}
+
+	// Otherwise the rounded edges (and their corner caps) decide
+	Vec3 const& mins = aabb3.m_mins;
+	Vec3 const& maxs = aabb3.m_maxs;
+	Vec3 cornerList[8] =
+	{
+		Vec3( mins.x, mins.y, mins.z ), Vec3( maxs.x, mins.y, mins.z ), Vec3( maxs.x, maxs.y, mins.z ), Vec3( mins.x, maxs.y, mins.z ),
+		Vec3( mins.x, mins.y, maxs.z ), Vec3( maxs.x, mins.y, maxs.z ), Vec3( maxs.x, maxs.y, maxs.z ), Vec3( mins.x, maxs.y, maxs.z ),
+	};
+	int edgeList[12][2] =
+	{
+		{ 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+		{ 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+		{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+	};
+	for ( int i = 0; i < 12; i++ )
+	{
+		RaycastResult3D edgeResult = RaycastVsCapsule3D( sphereStart, sweepFwdNormal, sweepMaxDist, cornerList[ edgeList[i][0] ], cornerList[ edgeList[i][1] ], sphereRadius );
+		if ( edgeResult.m_didImpact && ( edgeResult.m_impactDist < sweepResult.m_impactDist ) )
+		{
+			sweepResult = edgeResult;
+		}
+	}
+	return sweepResult;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsTriangle3D( Vec3 const& sphereStart, float sphereRadius, Vec3 const& sweepFwdNormal, float sweepMaxDist, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 )
+{
+	RaycastResult3D sweepResult;
+	sweepResult.m_rayStartPosition	= sphereStart;
+	sweepResult.m_rayFwdNormal		= sweepFwdNormal;
+	sweepResult.m_rayMaxLength		= sweepMaxDist;
+
+	// Check if the sphere already overlaps the triangle
+	Vec3 nearestPoint	= GetNearestPointOnTriangle3D( sphereStart, vert0, vert1, vert2 );
+	Vec3 dispToSphere	= sphereStart - nearestPoint;
+	if ( dispToSphere.GetLengthSquared() < ( sphereRadius * sphereRadius ) )
+	{
+		sweepResult.m_didImpact		= true;
+		sweepResult.m_impactDist	= 0.0f;
+		sweepResult.m_impactPos		= sphereStart;
+		sweepResult.m_impactNormal	= ( dispToSphere.GetLengthSquared() > 0.0f ) ? dispToSphere.GetNormalized() : ( -1.0f * sweepFwdNormal );
+		return sweepResult;
+	}
+
+	// Face: the plane pushed out by the radius on the sphere's side, hit inside the triangle
+	Vec3 faceNormal = CrossProduct3D( vert1 - vert0, vert2 - vert0 );
+	if ( faceNormal.GetLengthSquared() > 0.0f )
+	{
+		faceNormal			= faceNormal.GetNormalized();
+		float startHeight	= DotProduct3D( sphereStart - vert0, faceNormal );
+		if ( startHeight < 0.0f )
+		{
+			faceNormal		= -1.0f * faceNormal;
+			startHeight		= -startHeight;
+		}
+		float approachSpeed	= -DotProduct3D( sweepFwdNormal, faceNormal );
+		if ( approachSpeed > 0.0f )
+		{
+			float impactDist	= ( startHeight - sphereRadius ) / approachSpeed;
+			Vec3  impactPos		= sphereStart + ( sweepFwdNormal * impactDist );
+			Vec3  contactPos	= impactPos - ( faceNormal * sphereRadius );
+			// Starting inside the pushed-out plane (off to the side of the face), an edge is reached first
+			if ( ( impactDist >= 0.0f ) && ( impactDist <= sweepMaxDist ) && ( GetDistanceSquared3D( GetNearestPointOnTriangle3D( contactPos, vert0, vert1, vert2 ), contactPos ) < 0.0001f ) )
+			{
+				sweepResult.m_didImpact		= true;
+				sweepResult.m_impactDist	= impactDist;
+				sweepResult.m_impactPos		= impactPos;
+				sweepResult.m_impactNormal	= faceNormal;
+				return sweepResult;
+			}
+		}
+	}
+
+	// Edges (and their vertex caps)
+	Vec3 const* vertList[3] = { &vert0, &vert1, &vert2 };
+	for ( int i = 0; i < 3; i++ )
+	{
+		RaycastResult3D edgeResult = RaycastVsCapsule3D( sphereStart, sweepFwdNormal, sweepMaxDist, *vertList[i], *vertList[ ( i + 1 ) % 3 ], sphereRadius );
+		if ( edgeResult.m_didImpact && ( edgeResult.m_impactDist < sweepResult.m_impactDist ) )
+		{
+			sweepResult = edgeResult;
+		}
+	}
+	return sweepResult;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sweeps the sphere at boneStart against the box grown by the bone, which is exact for axis-aligned bones and slightly
+// conservative otherwise
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepCapsuleVsAABB3D( Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist, AABB3 const& aabb3 )
+{
+	Vec3  boneDisp		= boneEnd - boneStart;
+	AABB3 grownBox		= aabb3;
+	grownBox.m_mins.x	= ( boneDisp.x > 0.0f ) ? ( aabb3.m_mins.x - boneDisp.x ) : aabb3.m_mins.x;
+	grownBox.m_mins.y	= ( boneDisp.y > 0.0f ) ? ( aabb3.m_mins.y - boneDisp.y ) : aabb3.m_mins.y;
+	grownBox.m_mins.z	= ( boneDisp.z > 0.0f ) ? ( aabb3.m_mins.z - boneDisp.z ) : aabb3.m_mins.z;
+	grownBox.m_maxs.x	= ( boneDisp.x < 0.0f ) ? ( aabb3.m_maxs.x - boneDisp.x ) : aabb3.m_maxs.x;
+	grownBox.m_maxs.y	= ( boneDisp.y < 0.0f ) ? ( aabb3.m_maxs.y - boneDisp.y ) : aabb3.m_maxs.y;
+	grownBox.m_maxs.z	= ( boneDisp.z < 0.0f ) ? ( aabb3.m_maxs.z - boneDisp.z ) : aabb3.m_maxs.z;
+	return SweepSphereVsAABB3D( boneStart, radius, sweepFwdNormal, sweepMaxDist, grownBox );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// The triangle swept back along the bone is a prism; sweeping the sphere at boneStart against the prism's two caps and
+// three sides is exact
+//----------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepCapsuleVsTriangle3D( Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 )
+{
+	Vec3 boneDisp = boneEnd - boneStart;
+	if ( boneDisp.GetLengthSquared() == 0.0f )
+	{
+		return SweepSphereVsTriangle3D( boneStart, radius, sweepFwdNormal, sweepMaxDist, vert0, vert1, vert2 );
+	}
+
+	// A bone passing straight through the triangle is deep inside the prism, away from all its faces
+	RaycastResult3D sweepResult;
+	sweepResult.m_rayStartPosition	= boneStart;
+	sweepResult.m_rayFwdNormal		= sweepFwdNormal;
+	sweepResult.m_rayMaxLength		= sweepMaxDist;
+	Vec3  faceNormal		= CrossProduct3D( vert1 - vert0, vert2 - vert0 );
+	float startHeight		= DotProduct3D( boneStart - vert0, faceNormal );
+	float endHeight			= DotProduct3D( boneEnd   - vert0, faceNormal );
+	if ( ( ( startHeight < 0.0f ) != ( endHeight < 0.0f ) ) && ( faceNormal.GetLengthSquared() > 0.0f ) )
+	{
+		Vec3 crossingPos = boneStart + ( boneDisp * ( startHeight / ( startHeight - endHeight ) ) );
+		if ( GetDistanceSquared3D( GetNearestPointOnTriangle3D( crossingPos, vert0, vert1, vert2 ), crossingPos ) < 0.0001f )
+		{
+			// Out toward the side holding more of the bone
+			float sideHeight			= ( fabsf( startHeight ) > fabsf( endHeight ) ) ? startHeight : endHeight;
+			sweepResult.m_didImpact		= true;
+			sweepResult.m_impactDist	= 0.0f;
+			sweepResult.m_impactPos		= boneStart;
+			sweepResult.m_impactNormal	= faceNormal.GetNormalized() * ( ( sideHeight >= 0.0f ) ? 1.0f : -1.0f );
+			return sweepResult;
+		}
+	}
+
+	Vec3 shiftedVert0 = vert0 - boneDisp;
+	Vec3 shiftedVert1 = vert1 - boneDisp;
+	Vec3 shiftedVert2 = vert2 - boneDisp;
+	Vec3 prismTriList[8][3] =
+	{
+		{ vert0,		vert1,			vert2		  },
+		{ shiftedVert0, shiftedVert1,	shiftedVert2  },
+		{ vert0,		vert1,			shiftedVert1  },
+		{ vert0,		shiftedVert1,	shiftedVert0  },
+		{ vert1,		vert2,			shiftedVert2  },
+		{ vert1,		shiftedVert2,	shiftedVert1  },
+		{ vert2,		vert0,			shiftedVert0  },
+		{ vert2,		shiftedVert0,	shiftedVert2  },
+	};
+	for ( int i = 0; i < 8; i++ )
+	{
+		RaycastResult3D faceResult = SweepSphereVsTriangle3D( boneStart, radius, sweepFwdNormal, sweepMaxDist, prismTriList[i][0], prismTriList[i][1], prismTriList[i][2] );
+		if ( faceResult.m_didImpact && ( faceResult.m_impactDist < sweepResult.m_impactDist ) )
+		{
+			sweepResult = faceResult;
+		}
+	}
+	return sweepResult;
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------
 float GetClamped(float value, float minValue, float maxValue)
 {
@@ -61,9 +61,18 @@ RaycastResult2D RaycastVsOBB2D( Vec2 rayStartPos, Vec2 rayFwdNormal, float rayMa
 RaycastResult3D RaycastVsCylinder3D( Vec3 const& rayStartPos, Vec3 const& fwdNormal, float rayLength, Vec2 const& discCenter, float discMinZ, float discMaxZ, float discRadius );
 RaycastResult3D RaycastVsAABB3D( Vec3 rayStartPos, Vec3 rayFwdNormal, float rayMaxLength, AABB3 aabb3 );
 RaycastResult3D RaycastVsOBB3D( Vec3 rayStartPos, Vec3 rayFwdNormal, float rayMaxLength, OBB3D aabb3 );
+RaycastResult3D RaycastVsSphere3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxLength, Vec3 const& sphereCenter, float sphereRadius );
+RaycastResult3D RaycastVsCapsule3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxLength, Vec3 const& boneStart, Vec3 const& boneEnd, float radius );
 RaycastResult3D RaycastVsTriangle( Vec3 const& rayStart, Vec3 const& rayFwdDir, float rayLength, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2, float& t, float& u, float& v );
 bool			DoesRaycastHitTriangle( Vec3 const& rayStart, Vec3 const& rayFwdDir, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2, float& t, float& u, float& v );
 
+//----------------------------------------------------------------------------------------------------------------------
+// Sweep3D
+RaycastResult3D SweepSphereVsAABB3D(	  Vec3 const& sphereStart, float sphereRadius, Vec3 const& sweepFwdNormal, float sweepMaxDist, AABB3 const& aabb3 );
+RaycastResult3D SweepSphereVsTriangle3D(  Vec3 const& sphereStart, float sphereRadius, Vec3 const& sweepFwdNormal, float sweepMaxDist, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 );
+RaycastResult3D SweepCapsuleVsAABB3D(	  Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist, AABB3 const& aabb3 );
+RaycastResult3D SweepCapsuleVsTriangle3D( Vec3 const& boneStart, Vec3 const& boneEnd, float radius, Vec3 const& sweepFwdNormal, float sweepMaxDist, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 );
+
 
 //-----------------------------------------------------------------------------------------------------------------------
 // Clamp and lerp
@@ -150,6 +159,9 @@ Vec2 const		GetNearestPointOnInfiniteLine2D( Vec2 const& referencePos, Vec2 cons
 Vec2 const		GetNearestPointOnLineSegment2D( Vec2 const& referencePoint, Vec2 const& startPos, Vec2 const& endPos );
 Vec2 const		GetNearestPointOnCapsule2D( Vec2 const& refPoint, Vec2 const& BoneStart, Vec2 const& BoneEnd, float radius );	
 Vec2 const		GetNearestPointOnOBB2D( Vec2 const& refPoint, OBB2D const& orientedBox );
+Vec2 const		GetNearestPointOnTriangle2D( Vec2 const& refPoint, Vec2 const& vert0, Vec2 const& vert1, Vec2 const& vert2 );
+Vec3 const		GetNearestPointOnLineSegment3D( Vec3 const& refPoint, Vec3 const& startPos, Vec3 const& endPos );
+Vec3 const		GetNearestPointOnTriangle3D( Vec3 const& refPoint, Vec3 const& vert0, Vec3 const& vert1, Vec3 const& vert2 );
 bool			PushDiscOutOfFixedDisc2D( Vec2& mobileDiscCenter, float mobileDiscRadius, Vec2 const& fixedDiscCenter, float fixedDiscRadius);
 bool			PushDiscsOutOfEachOther2D( Vec2& aCenter, float aRadius, Vec2& bCenter, float bRadius );
 bool			PushDiscOutOfFixedPoint2D( Vec2& mobileDiscCenter, float discRadius, Vec2 const& fixedPoint );
@@ -0,0 +1,200 @@
+#include "Engine/Math/UniformGrid2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+UniformGrid2D::UniformGrid2D()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+UniformGrid2D::~UniformGrid2D()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void UniformGrid2D::Build( std::vector<AABB2> const& itemBoundsList, float cellSize )
+{
+	Clear();
+	if ( itemBoundsList.empty() || cellSize <= 0.0f )
+	{
+		return;
+	}
+
+	// Grid bounds are the union of all item bounds
+	m_cellSize		= cellSize;
+	m_gridBounds	= itemBoundsList[0];
+	for ( int i = 1; i < itemBoundsList.size(); i++ )
+	{
+		m_gridBounds.StretchToIncludePoint( itemBoundsList[i].m_mins );
+		m_gridBounds.StretchToIncludePoint( itemBoundsList[i].m_maxs );
+	}
+	Vec2 gridDimensions		= m_gridBounds.GetDimensions();
+	m_gridDimensions.x		= int( floorf( gridDimensions.x / m_cellSize ) ) + 1;
+	m_gridDimensions.y		= int( floorf( gridDimensions.y / m_cellSize ) ) + 1;
+	int numCells			= m_gridDimensions.x * m_gridDimensions.y;
+
+	// Pass 1: count items per cell
+	m_cellStartList.resize( numCells + 1, 0 );
+	for ( int itemIndex = 0; itemIndex < itemBoundsList.size(); itemIndex++ )
+	{
+		IntVec2 minCell = GetCellCoordsForPoint( itemBoundsList[itemIndex].m_mins );
+		IntVec2 maxCell = GetCellCoordsForPoint( itemBoundsList[itemIndex].m_maxs );
+		for ( int y = minCell.y; y <= maxCell.y; y++ )
+		{
+			for ( int x = minCell.x; x <= maxCell.x; x++ )
+			{
+				m_cellStartList[ GetCellIndex( IntVec2( x, y ) ) + 1 ]++;
+			}
+		}
+	}
+
+	// Prefix sum turns the counts into start offsets
+	for ( int cellIndex = 0; cellIndex < numCells; cellIndex++ )
+	{
+		m_cellStartList[ cellIndex + 1 ] += m_cellStartList[ cellIndex ];
+	}
+
+	// Pass 2: fill items, using a copy of the start offsets as write cursors
+	m_cellItemList.resize( m_cellStartList[ numCells ] );
+	std::vector<int> writeCursorList( m_cellStartList.begin(), m_cellStartList.end() - 1 );
+	for ( int itemIndex = 0; itemIndex < itemBoundsList.size(); itemIndex++ )
+	{
+		IntVec2 minCell = GetCellCoordsForPoint( itemBoundsList[itemIndex].m_mins );
+		IntVec2 maxCell = GetCellCoordsForPoint( itemBoundsList[itemIndex].m_maxs );
+		for ( int y = minCell.y; y <= maxCell.y; y++ )
+		{
+			for ( int x = minCell.x; x <= maxCell.x; x++ )
+			{
+				int cellIndex = GetCellIndex( IntVec2( x, y ) );
+				m_cellItemList[ writeCursorList[cellIndex] ] = itemIndex;
+				writeCursorList[cellIndex]++;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void UniformGrid2D::Clear()
+{
+	m_gridBounds		= AABB2( 0.0f, 0.0f, 0.0f, 0.0f );
+	m_gridDimensions	= IntVec2( 0, 0 );
+	m_cellStartList.clear();
+	m_cellItemList.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool UniformGrid2D::IsEmpty() const
+{
+	return m_cellItemList.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+float UniformGrid2D::GetCellSize() const
+{
+	return m_cellSize;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IntVec2 UniformGrid2D::GetGridDimensions() const
+{
+	return m_gridDimensions;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+AABB2 UniformGrid2D::GetGridBounds() const
+{
+	return m_gridBounds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IntVec2 UniformGrid2D::GetCellCoordsForPoint( Vec2 const& point ) const
+{
+	int cellX = int( floorf( ( point.x - m_gridBounds.m_mins.x ) / m_cellSize ) );
+	int cellY = int( floorf( ( point.y - m_gridBounds.m_mins.y ) / m_cellSize ) );
+	return IntVec2( cellX, cellY );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool UniformGrid2D::IsCellInBounds( IntVec2 const& cellCoords ) const
+{
+	if ( cellCoords.x < 0 || cellCoords.x >= m_gridDimensions.x )
+	{
+		return false;
+	}
+	if ( cellCoords.y < 0 || cellCoords.y >= m_gridDimensions.y )
+	{
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+AABB2 UniformGrid2D::GetCellBounds( IntVec2 const& cellCoords ) const
+{
+	Vec2 cellMins = m_gridBounds.m_mins + Vec2( float( cellCoords.x ) * m_cellSize, float( cellCoords.y ) * m_cellSize );
+	Vec2 cellMaxs = cellMins + Vec2( m_cellSize, m_cellSize );
+	return AABB2( cellMins, cellMaxs );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int UniformGrid2D::GetNumItemsInCell( IntVec2 const& cellCoords ) const
+{
+	if ( !IsCellInBounds( cellCoords ) )
+	{
+		return 0;
+	}
+	int cellIndex = GetCellIndex( cellCoords );
+	return m_cellStartList[ cellIndex + 1 ] - m_cellStartList[ cellIndex ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int const* UniformGrid2D::GetItemsInCell( IntVec2 const& cellCoords ) const
+{
+	if ( !IsCellInBounds( cellCoords ) || m_cellItemList.empty() )
+	{
+		return nullptr;
+	}
+	int cellIndex = GetCellIndex( cellCoords );
+	return m_cellItemList.data() + m_cellStartList[ cellIndex ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void UniformGrid2D::GetItemsOverlappingBounds( AABB2 const& queryBounds, std::vector<int>& out_itemIndexList ) const
+{
+	out_itemIndexList.clear();
+	if ( IsEmpty() )
+	{
+		return;
+	}
+
+	IntVec2 minCell = GetCellCoordsForPoint( queryBounds.m_mins );
+	IntVec2 maxCell = GetCellCoordsForPoint( queryBounds.m_maxs );
+	minCell.x		= int( GetClamped( float( minCell.x ), 0.0f, float( m_gridDimensions.x - 1 ) ) );
+	minCell.y		= int( GetClamped( float( minCell.y ), 0.0f, float( m_gridDimensions.y - 1 ) ) );
+	maxCell.x		= int( GetClamped( float( maxCell.x ), 0.0f, float( m_gridDimensions.x - 1 ) ) );
+	maxCell.y		= int( GetClamped( float( maxCell.y ), 0.0f, float( m_gridDimensions.y - 1 ) ) );
+	for ( int y = minCell.y; y <= maxCell.y; y++ )
+	{
+		for ( int x = minCell.x; x <= maxCell.x; x++ )
+		{
+			int cellIndex = GetCellIndex( IntVec2( x, y ) );
+			for ( int i = m_cellStartList[ cellIndex ]; i < m_cellStartList[ cellIndex + 1 ]; i++ )
+			{
+				out_itemIndexList.push_back( m_cellItemList[i] );
+			}
+		}
+	}
+
+	// Items spanning several cells were gathered more than once
+	std::sort( out_itemIndexList.begin(), out_itemIndexList.end() );
+	out_itemIndexList.erase( std::unique( out_itemIndexList.begin(), out_itemIndexList.end() ), out_itemIndexList.end() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int UniformGrid2D::GetCellIndex( IntVec2 const& cellCoords ) const
+{
+	return ( cellCoords.y * m_gridDimensions.x ) + cellCoords.x;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Static XY bucket grid; items are referenced by their index in the bounds list passed to Build().
+// Cell contents are stored flat (one offsets array + one item array) so queries never allocate.
+//----------------------------------------------------------------------------------------------------------------------
+class UniformGrid2D
+{
+public:
+	UniformGrid2D();
+	~UniformGrid2D();
+
+	void	Build( std::vector<AABB2> const& itemBoundsList, float cellSize );
+	void	Clear();
+
+	bool	IsEmpty()													const;
+	float	GetCellSize()												const;
+	IntVec2	GetGridDimensions()											const;
+	AABB2	GetGridBounds()												const;
+	IntVec2 GetCellCoordsForPoint( Vec2 const& point )					const;		// Unclamped, may be outside the grid
+	bool	IsCellInBounds( IntVec2 const& cellCoords )					const;
+	AABB2	GetCellBounds( IntVec2 const& cellCoords )					const;
+	int		GetNumItemsInCell( IntVec2 const& cellCoords )				const;
+	int		const* GetItemsInCell( IntVec2 const& cellCoords )			const;
+	void	GetItemsOverlappingBounds( AABB2 const& queryBounds, std::vector<int>& out_itemIndexList ) const;
+
+private:
+	int		GetCellIndex( IntVec2 const& cellCoords )					const;
+
+private:
+	float				m_cellSize			= 1.0f;
+	AABB2				m_gridBounds		= AABB2( 0.0f, 0.0f, 0.0f, 0.0f );
+	IntVec2				m_gridDimensions	= IntVec2( 0, 0 );
+	std::vector<int>	m_cellStartList;					// numCells + 1 offsets into m_cellItemList
+	std::vector<int>	m_cellItemList;
+};
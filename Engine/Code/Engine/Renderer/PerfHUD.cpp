@@ -0,0 +1,336 @@
+#include "Engine/Renderer/PerfHUD.hpp"
+#include "Engine/Core/AllocTracker.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FrameStats.hpp"
+#include "Engine/Core/SampleCounters.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+struct PerfHUDScopeTotal
+{
+	char const*		m_name		= nullptr;
+	int				m_numCalls	= 0;
+	double			m_selfMs	= 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+class PerfHUD
+{
+public:
+	PerfHUD( PerfHUDConfig const& config );
+	~PerfHUD();
+
+	void SetVisible( bool isVisible );
+	void Render();
+	void RebuildPanelVerts( AABB2 const& panelBounds, AABB2 const& graphBounds );
+	void RebuildTextVerts( AABB2 const& textBounds );
+	void AddTextLine( AABB2& lineBounds, std::string const& text, Rgba8 const& color );
+
+public:
+	PerfHUDConfig					m_config;
+	bool							m_isVisible					= false;
+	BitmapFont*						m_font						= nullptr;
+
+	// Reused every frame, so after the first few the HUD itself doesn't touch the heap except to refresh the text
+	std::vector<Vertex_PCU>			m_panelVerts;
+	std::vector<Vertex_PCU>			m_textVerts;
+	std::vector<PerfHUDScopeTotal>	m_scopeTotalList;
+	double							m_lastTextRefreshSeconds	= -1.0;
+	float							m_textHeight				= 0.0f;		// Panel height the text needed last refresh
+	RendererFrameStats				m_ownDrawStats;							// Drawn by the HUD last frame, left out of the totals
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static PerfHUD* s_thePerfHUD = nullptr;
+
+//----------------------------------------------------------------------------------------------------------------------
+// PerfHUD class methods
+//----------------------------------------------------------------------------------------------------------------------
+PerfHUD::PerfHUD( PerfHUDConfig const& config )
+	: m_config( config )
+{
+	m_font = m_config.m_renderer->CreateOrGetBitmapFontFromFile( std::string( "Data/Fonts/" + m_config.m_fontName ).c_str() );
+	m_panelVerts.reserve( size_t( m_config.m_numGraphFrames + 4 ) * 6 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+PerfHUD::~PerfHUD()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUD::SetVisible( bool isVisible )
+{
+	m_isVisible					= isVisible;
+	m_lastTextRefreshSeconds	= -1.0;
+	m_ownDrawStats				= RendererFrameStats();
+	if ( g_theJobSystem != nullptr )
+	{
+		g_theJobSystem->SetTelemetryRequested( isVisible );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUD::Render()
+{
+	if ( !m_isVisible )
+	{
+		return;
+	}
+	PROFILE_SCOPE( "PerfHUD::Render" );
+	ALLOC_TAG( "PerfHUD" );
+
+	Vec2  screenMins	= m_config.m_camera->GetOrthoBottomLeft();
+	Vec2  screenMaxs	= m_config.m_camera->GetOrthoTopRight();
+	float panelWidth	= ( screenMaxs.x - screenMins.x ) * m_config.m_widthFraction;
+	float margin		= m_config.m_cellHeight * 0.5f;
+	AABB2 graphBounds	= AABB2( screenMaxs.x - panelWidth + margin, screenMaxs.y - margin - m_config.m_graphHeight, screenMaxs.x - margin, screenMaxs.y - margin );
+	AABB2 textBounds	= AABB2( graphBounds.m_mins.x, screenMins.y, graphBounds.m_maxs.x, graphBounds.m_mins.y - margin );
+
+	double currentSeconds = GetCurrentTimeSeconds();
+	if ( m_lastTextRefreshSeconds < 0.0 || ( currentSeconds - m_lastTextRefreshSeconds ) >= double( m_config.m_textRefreshSeconds ) )
+	{
+		m_lastTextRefreshSeconds = currentSeconds;
+		RebuildTextVerts( textBounds );
+	}
+	AABB2 panelBounds = AABB2( screenMaxs.x - panelWidth, textBounds.m_maxs.y - m_textHeight - margin, screenMaxs.x, screenMaxs.y );
+	RebuildPanelVerts( panelBounds, graphBounds );
+
+	Renderer* renderer = m_config.m_renderer;
+	renderer->BeginCamera( *m_config.m_camera );
+	renderer->SetBlendMode( BlendMode::ALPHA );
+	renderer->SetModelConstants();
+	renderer->BindShader( nullptr );
+	renderer->BindTexture( nullptr );
+	renderer->DrawVertexArray( static_cast<int>( m_panelVerts.size() ), m_panelVerts.data() );
+	renderer->BindTexture( &m_font->GetTexture() );
+	renderer->DrawVertexArray( static_cast<int>( m_textVerts.size() ), m_textVerts.data() );
+	renderer->BindTexture( nullptr );
+	renderer->EndCamera( *m_config.m_camera );
+
+	m_ownDrawStats.m_numDrawCalls	= 2;
+	m_ownDrawStats.m_numVertexes	= int( m_panelVerts.size() + m_textVerts.size() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUD::RebuildPanelVerts( AABB2 const& panelBounds, AABB2 const& graphBounds )
+{
+	m_panelVerts.clear();
+	AddVertsForAABB2D( m_panelVerts, panelBounds, Rgba8::TRANSLUCENT_BLACK );
+
+	// Newest frame on the right, one bar per frame
+	FrameStats const& frameStats	= Clock::GetSystemFrameStats();
+	float graphWidth				= graphBounds.m_maxs.x - graphBounds.m_mins.x;
+	float graphHeight				= graphBounds.m_maxs.y - graphBounds.m_mins.y;
+	float barWidth					= graphWidth / float( m_config.m_numGraphFrames );
+	int	  numBars					= std::min( m_config.m_numGraphFrames, frameStats.GetNumFrames() );
+	for ( int i = 0; i < numBars; i++ )
+	{
+		float frameMs		= float( frameStats.GetFrameMs( i ) );
+		float barHeight		= graphHeight * std::min( frameMs / m_config.m_graphMaxMs, 1.0f );
+		float barMaxX		= graphBounds.m_maxs.x - ( barWidth * float( i ) );
+		Rgba8 barColor		= Rgba8::GREEN;
+		if ( frameMs > float( frameStats.m_hitchThresholdMs ) )
+		{
+			barColor = Rgba8::RED;
+		}
+		else if ( frameMs > m_config.m_targetFrameMs )
+		{
+			barColor = Rgba8::YELLOW;
+		}
+		AddVertsForAABB2D( m_panelVerts, AABB2( barMaxX - barWidth, graphBounds.m_mins.y, barMaxX, graphBounds.m_mins.y + barHeight ), barColor );
+	}
+
+	float targetY = graphBounds.m_mins.y + graphHeight * std::min( m_config.m_targetFrameMs / m_config.m_graphMaxMs, 1.0f );
+	AddVertsForLineSegment2D( m_panelVerts, Vec2( graphBounds.m_mins.x, targetY ), Vec2( graphBounds.m_maxs.x, targetY ), 0.1f, Rgba8::WHITE );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUD::AddTextLine( AABB2& lineBounds, std::string const& text, Rgba8 const& color )
+{
+	m_font->AddVertsForTextInBox2D( m_textVerts, lineBounds, m_config.m_cellHeight, text, color, m_config.m_fontAspect, Vec2( 0.0f, 0.0f ) );
+	lineBounds.m_mins.y -= m_config.m_cellHeight;
+	lineBounds.m_maxs.y -= m_config.m_cellHeight;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUD::RebuildTextVerts( AABB2 const& textBounds )
+{
+	m_textVerts.clear();
+	AABB2 lineBounds = AABB2( textBounds.m_mins.x, textBounds.m_maxs.y - m_config.m_cellHeight, textBounds.m_maxs.x, textBounds.m_maxs.y );
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Frame times
+	FrameStatsSummary summary	= Clock::GetSystemFrameStats().GetSummary();
+	Rgba8 frameColor			= ( summary.m_p95Ms > m_config.m_targetFrameMs ) ? Rgba8::YELLOW : Rgba8::GREEN;
+	AddTextLine( lineBounds, Stringf( "Frame avg %.2f ms  p95 %.2f  p99 %.2f  max %.2f", summary.m_avgMs, summary.m_p95Ms, summary.m_p99Ms, summary.m_maxMs ), frameColor );
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Renderer, minus what the HUD drew itself
+	RendererFrameStats const& drawStats = m_config.m_renderer->GetLastFrameStats();
+	AddTextLine( lineBounds, Stringf( "Draws %d  verts %d", drawStats.m_numDrawCalls - m_ownDrawStats.m_numDrawCalls, drawStats.m_numVertexes - m_ownDrawStats.m_numVertexes ), Rgba8::WHITE );
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Workers
+	if ( g_theJobSystem != nullptr )
+	{
+		JobSystemFrameStats const& jobStats = g_theJobSystem->GetLastFrameStats();
+		float totalUtilization	= 0.0f;
+		float maxUtilization	= 0.0f;
+		int	  numWorkers		= 0;
+		for ( int i = 0; i < jobStats.m_threadStatsList.size(); i++ )
+		{
+			// Main thread is last, it's in the frame time already
+			if ( i == int( jobStats.m_threadStatsList.size() ) - 1 )
+			{
+				break;
+			}
+			totalUtilization	+= jobStats.m_threadStatsList[i].m_utilization;
+			maxUtilization		 = std::max( maxUtilization, jobStats.m_threadStatsList[i].m_utilization );
+			numWorkers++;
+		}
+		float avgUtilization = ( numWorkers > 0 ) ? ( totalUtilization / float( numWorkers ) ) : 0.0f;
+		AddTextLine( lineBounds, Stringf( "Jobs %d  workers %d busy avg %d%% max %d%%", jobStats.m_numJobsRun, numWorkers, int( avgUtilization * 100.0f ), int( maxUtilization * 100.0f ) ), Rgba8::WHITE );
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Allocations, when the tracker is compiled in
+	if ( AllocTrackerIsEnabled() )
+	{
+		AllocFrameStats allocStats = AllocTrackerGetLastFrame();
+		Rgba8 allocColor = ( allocStats.m_isSteadyState && allocStats.m_numAllocs > 0 ) ? Rgba8::YELLOW : Rgba8::WHITE;
+		AddTextLine( lineBounds, Stringf( "Allocs %d  %.1f KB  live %.1f MB", int( allocStats.m_numAllocs ), float( allocStats.m_numBytes ) / 1024.0f, float( allocStats.m_liveBytes ) / ( 1024.0f * 1024.0f ) ), allocColor );
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Watched scopes
+	ProfilerFrame const& profilerFrame = ProfilerGetLastFrame();
+	for ( int watchIndex = 0; watchIndex < m_config.m_watchList.size(); watchIndex++ )
+	{
+		PerfHUDWatch const& watch = m_config.m_watchList[ watchIndex ];
+		int		numCalls	= 0;
+		double	totalMs		= 0.0;
+		int		matchDepth	= -1;		// Depth of the match we're inside, its children are already counted
+		for ( int i = 0; i < profilerFrame.m_nodeList.size(); i++ )
+		{
+			ProfilerNode const& node = profilerFrame.m_nodeList[i];
+			if ( matchDepth >= 0 && node.m_depth > matchDepth )
+			{
+				continue;
+			}
+			matchDepth = -1;
+			if ( strncmp( node.m_name, watch.m_scopeNamePrefix.c_str(), watch.m_scopeNamePrefix.size() ) == 0 )
+			{
+				numCalls	+= node.m_numCalls;
+				totalMs		+= node.m_totalMs;
+				matchDepth	 = node.m_depth;
+			}
+		}
+		AddTextLine( lineBounds, Stringf( "%-14s %5d calls %8.3f ms", watch.m_label.c_str(), numCalls, totalMs ), Rgba8::WHITE );
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Counters, last frame
+	int numCounters = SampleCountersGetNumCounters();
+	if ( numCounters > 0 )
+	{
+		AddTextLine( lineBounds, "Counters (per frame)", Rgba8::YELLOW );
+		for ( int i = 0; i < numCounters; i++ )
+		{
+			AddTextLine( lineBounds, Stringf( "  %-24.24s %10lld", SampleCountersGetName(i), SampleCountersGetLastFrameValue(i) ), Rgba8::WHITE );
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------------------------------
+	// Top scopes by self time, the same scope under different parents summed
+	m_scopeTotalList.clear();
+	for ( int i = 0; i < profilerFrame.m_nodeList.size(); i++ )
+	{
+		ProfilerNode const& node = profilerFrame.m_nodeList[i];
+		PerfHUDScopeTotal* scopeTotal = nullptr;
+		for ( int j = 0; j < m_scopeTotalList.size(); j++ )
+		{
+			if ( m_scopeTotalList[j].m_name == node.m_name || strcmp( m_scopeTotalList[j].m_name, node.m_name ) == 0 )
+			{
+				scopeTotal = &m_scopeTotalList[j];
+				break;
+			}
+		}
+		if ( scopeTotal == nullptr )
+		{
+			m_scopeTotalList.emplace_back();
+			scopeTotal			= &m_scopeTotalList.back();
+			scopeTotal->m_name	= node.m_name;
+		}
+		scopeTotal->m_numCalls	+= node.m_numCalls;
+		scopeTotal->m_selfMs	+= node.m_selfMs;
+	}
+	std::sort( m_scopeTotalList.begin(), m_scopeTotalList.end(), []( PerfHUDScopeTotal const& a, PerfHUDScopeTotal const& b ) { return a.m_selfMs > b.m_selfMs; } );
+	AddTextLine( lineBounds, "Top scopes (self ms)", Rgba8::YELLOW );
+	for ( int i = 0; i < m_scopeTotalList.size() && i < m_config.m_numTopScopes; i++ )
+	{
+		AddTextLine( lineBounds, Stringf( "  %-30.30s %8.3f x%d", m_scopeTotalList[i].m_name, m_scopeTotalList[i].m_selfMs, m_scopeTotalList[i].m_numCalls ), Rgba8::WHITE );
+	}
+
+	m_textHeight = textBounds.m_maxs.y - lineBounds.m_maxs.y;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Standalone functions
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUDStartup( PerfHUDConfig const& config )
+{
+	s_thePerfHUD = new PerfHUD( config );
+	s_thePerfHUD->SetVisible( config.m_startVisible );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUDShutdown()
+{
+	delete s_thePerfHUD;
+	s_thePerfHUD = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUDSetVisible( bool isVisible )
+{
+	if ( s_thePerfHUD != nullptr )
+	{
+		s_thePerfHUD->SetVisible( isVisible );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PerfHUDIsVisible()
+{
+	return ( s_thePerfHUD != nullptr ) && s_thePerfHUD->m_isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerfHUDRender()
+{
+	if ( s_thePerfHUD != nullptr )
+	{
+		s_thePerfHUD->Render();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Command_PerfHUD( NamedStrings& args )
+{
+	UNUSED( args );
+	PerfHUDSetVisible( !PerfHUDIsVisible() );
+	return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+class  Renderer;
+class  Camera;
+class  NamedStrings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// One HUD row with the calls and total ms of every profiler scope whose name starts with the prefix, e.g. all the IK
+// solvers. The profiler tree only holds main-thread scopes. Nested matches only count once, under the outermost one
+struct PerfHUDWatch
+{
+	std::string					m_label;
+	std::string					m_scopeNamePrefix;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct PerfHUDConfig
+{
+	Renderer*					m_renderer				= nullptr;
+	Camera const*				m_camera				= nullptr;		// Ortho screen camera, the HUD sits in its top-right corner
+	std::string					m_fontName				= "SquirrelFixedFont";
+	float						m_cellHeight			= 1.6f;
+	float						m_fontAspect			= 0.7f;
+	float						m_widthFraction			= 0.36f;		// Of the camera's width
+	float						m_graphHeight			= 12.0f;
+	int							m_numGraphFrames		= 240;
+	float						m_graphMaxMs			= 50.0f;		// Bars are clipped above this
+	float						m_targetFrameMs			= 1000.0f / 60.0f;
+	int							m_numTopScopes			= 8;
+	float						m_textRefreshSeconds	= 0.25f;		// Text verts are rebuilt this often, the graph every frame
+	std::vector<PerfHUDWatch>	m_watchList;
+	bool						m_startVisible			= false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Setup
+void PerfHUDStartup( PerfHUDConfig const& config );
+void PerfHUDShutdown();
+
+//----------------------------------------------------------------------------------------------------------------------
+// Control
+void PerfHUDSetVisible( bool isVisible );
+bool PerfHUDIsVisible();
+
+//----------------------------------------------------------------------------------------------------------------------
+// Output, call once per frame after the game has rendered
+void PerfHUDRender();
+
+//----------------------------------------------------------------------------------------------------------------------
+// "perfhud" toggles the HUD
+bool Command_PerfHUD( NamedStrings& args );
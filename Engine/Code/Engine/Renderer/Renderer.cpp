@@ -317,6 +317,8 @@ Renderer::~Renderer()
 void Renderer::BeginFrame()
 {
 	m_deviceContext->OMSetRenderTargets( 1, &m_renderTargetView, m_depthStencilView );
+	m_lastFrameStats	= m_frameStats;
+	m_frameStats		= RendererFrameStats();
 
 }
 
@@ -997,6 +999,8 @@ void Renderer::DrawVertexBuffer( VertexBuffer* vbo, int vertexCount, int vertexO
 	SetStateIfChanged();
 	BindVertexBuffer( vbo, primitiveTopology );
 	m_deviceContext->Draw( vertexCount, vertexOffset );
+	m_frameStats.m_numDrawCalls++;
+	m_frameStats.m_numVertexes += vertexCount;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1007,6 +1011,8 @@ void Renderer::DrawVertexAndIndexBuffer( VertexBuffer* vbo, IndexBuffer* ibo, in
 	BindIndexBuffer( ibo );
 
 	m_deviceContext->DrawIndexed( indexCount, indexOffset, vertexOffset );
+	m_frameStats.m_numDrawCalls++;
+	m_frameStats.m_numVertexes += indexCount;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
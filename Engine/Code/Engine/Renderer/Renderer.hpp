@@ -112,6 +112,13 @@ struct RendererConfig
 	Window*	m_window = nullptr;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct RendererFrameStats
+{
+	int		m_numDrawCalls	= 0;
+	int		m_numVertexes	= 0;		// Indexes for indexed draws
+};
+
 //--------------------------------------------------------------------------------------------------------
 class Renderer
 {
@@ -148,6 +155,7 @@ public:
 
 
 	RendererConfig const& GetConfig() const { return m_config; }
+	RendererFrameStats const& GetLastFrameStats() const { return m_lastFrameStats; }		// Rolled over in BeginFrame
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// BitmapFont
@@ -216,6 +224,8 @@ public:
 protected:
 	//----------------------------------------------------------------------------------------------------------------------
 	RendererConfig				m_config;
+	RendererFrameStats			m_frameStats;
+	RendererFrameStats			m_lastFrameStats;
 
 	std::vector<Shader*>		m_loadedShaders;
 	Shader const*				m_currentShader				= nullptr;
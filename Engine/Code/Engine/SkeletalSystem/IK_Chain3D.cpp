@@ -4,6 +4,9 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/AllocTracker.hpp"
+#include "Engine/Core/SampleCounters.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 
 
@@ -40,6 +43,8 @@ void IK_Chain3D::Shutdown()
 //----------------------------------------------------------------------------------------------------------------------
 void IK_Chain3D::Update()
 {
+	PROFILE_SCOPE( "IK_Chain3D::Update" );
+	ALLOC_TAG( "IK" );
 	if ( m_shouldReachInsteadOfDrag )
 	{
 //		ReachTargetPos_FABRIK( m_currentTargetPos );		// Uncomment this to get creature working again		// Refactor these functions 
@@ -152,6 +157,7 @@ void IK_Chain3D::CreateNewJoint( Vec3 const& position_localSpace, EulerAngles or
 																									  FloatRange pitchConstraints, 
 																									  FloatRange rollConstraints )
 {
+	ALLOC_TAG( "IK" );
 	int	limbIndex  = int( m_jointList.size() );
 
 	IK_Joint3D* newJoint = new IK_Joint3D(  
@@ -198,6 +204,7 @@ void IK_Chain3D::CreateNewLimb( int limbIndex, float length, Vec3 const& fwdDir,
 																														  FloatRange  pitchConstraints, 
 																														  FloatRange  rollConstraints )
 {
+	ALLOC_TAG( "IK" );
 	if ( IK_Chain == nullptr )
 	{
 		IK_Chain = this;
@@ -632,9 +639,12 @@ void IK_Chain3D::DebugTextConstraints_YPR( std::vector<Vertex_PCU>& verts, float
 //----------------------------------------------------------------------------------------------------------------------
 void IK_Chain3D::Solve_CCD( Target target )
 {
+	PROFILE_SCOPE( "IK_Chain3D::Solve_CCD" );
+	COUNTER_ADD( "IK solves", 1 );
 	bool  wereChainsReset		= false;
 	float tolerance				= 0.01f;
 	int	  numIterations			= 5;
+	int	  numIterationsRun		= 0;
 	UpdateDistEeToTarget_ALSO_CHECK_IfDistChangedSinceLastFrame( target );
 	m_bestDistSolvedThisFrame	= m_distEeToTarget;
 	for ( int i = 0; i < numIterations; i++ )
@@ -649,6 +659,7 @@ void IK_Chain3D::Solve_CCD( Target target )
  			// Don't solve AT ALL, if target has not moved
 // 			break;
  		}
+		numIterationsRun++;
 		CCD_Forward( target );
 		bool hasDistChanged = UpdateDistEeToTarget_ALSO_CHECK_IfDistChangedSinceLastFrame( target );
 		if ( !hasDistChanged )
@@ -676,6 +687,7 @@ void IK_Chain3D::Solve_CCD( Target target )
 			}
 		}
 	}
+	COUNTER_ADD( "IK iterations", numIterationsRun );
 
 	//----------------------------------------------------------------------------------------------------------------------
 	// Once CCD solve is done, check if new solution brought us closer to target
@@ -838,14 +850,18 @@ void IK_Chain3D::FABRIK_Forward( Target Target )
 //----------------------------------------------------------------------------------------------------------------------
 void IK_Chain3D::Solve_FABRIK( Target target )
 {
+	PROFILE_SCOPE( "IK_Chain3D::Solve_FABRIK" );
+	COUNTER_ADD( "IK solves", 1 );
 	int   m_numIterations		= 1;
 	float toleranceDist			= 0.0001f;
 	float distToTarget			= 0.0f;
 	m_prevDistEE_EndToTarget	= GetDistance3D( m_finalJoint->m_endPos, target.m_currentPos );
 	m_breakFABRIK				= false;
+	int   numIterationsRun		= 0;
 	for ( int i = 0; i < m_numIterations; i++ )
 	{
 		m_iterCount = i;
+		numIterationsRun++;
 
 		// Forwards pass (child to parent)
 		FABRIK_Forward( target );					// Sets finalLimb's endPos at targetPos then climbs up hierarchy chain (parents, grand-parents, etc) and sets their endPos at currentLimb's startPos accordingly
@@ -870,6 +886,7 @@ void IK_Chain3D::Solve_FABRIK( Target target )
 			break;
 		}
 	}
+	COUNTER_ADD( "IK iterations", numIterationsRun );
 }
 
 
@@ -2076,6 +2093,8 @@ void IK_Chain3D::ConstrainYPR_Backwards( IK_Joint3D* const currentLimb, Target t
 //----------------------------------------------------------------------------------------------------------------------
 void IK_Chain3D::SolveTwoBoneIK_TriangulationMethod( Target target )
 {
+	PROFILE_SCOPE( "IK_Chain3D::SolveTwoBoneIK_TriangulationMethod" );
+	COUNTER_ADD( "IK solves", 1 );
 	//----------------------------------------------------------------------------------------------------------------------
 	// Bend the entire chain more using the "Triangulation Method"
 	//----------------------------------------------------------------------------------------------------------------------